@@ -17,6 +17,8 @@ using Debugger.Common;
 using DebuggerApi;
 using System;
 using System.Collections.Generic;
+using System.Linq;
+using YetiCommon;
 using RemoteBreakpointRpcServiceClient =
     Debugger.RemoteBreakpointRpc.RemoteBreakpointRpcService.RemoteBreakpointRpcServiceClient;
 
@@ -44,22 +46,25 @@ namespace DebuggerGrpcClient
         readonly RemoteBreakpointRpcServiceClient client;
         readonly GrpcSbBreakpoint grpcSbBreakpoint;
         readonly GrpcBreakpointLocationFactory breakpointLocationFactory;
+        readonly GrpcErrorFactory errorFactory;
 
         internal RemoteBreakpointProxy(GrpcConnection connection, GrpcSbBreakpoint grpcSbBreakpoint)
             : this(connection,
                   new RemoteBreakpointRpcServiceClient(connection.CallInvoker),
-                  grpcSbBreakpoint, new GrpcBreakpointLocationFactory())
+                  grpcSbBreakpoint, new GrpcBreakpointLocationFactory(), new GrpcErrorFactory())
         { }
 
         internal RemoteBreakpointProxy(
             GrpcConnection connection, RemoteBreakpointRpcServiceClient client,
             GrpcSbBreakpoint grpcSbBreakpoint,
-            GrpcBreakpointLocationFactory breakpointLocationFactory)
+            GrpcBreakpointLocationFactory breakpointLocationFactory,
+            GrpcErrorFactory errorFactory)
         {
             this.connection = connection;
             this.client = client;
             this.grpcSbBreakpoint = grpcSbBreakpoint;
             this.breakpointLocationFactory = breakpointLocationFactory;
+            this.errorFactory = errorFactory;
         }
 
         public int GetId()
@@ -186,5 +191,77 @@ namespace DebuggerGrpcClient
                 client.SetCommandLineCommands(request);
             });
         }
+
+        public void SetTracepoint(IEnumerable<DebuggerApi.TraceItem> items, uint capacity)
+        {
+            var request = new SetTracepointRequest
+            {
+                Breakpoint = grpcSbBreakpoint,
+                Capacity = capacity
+            };
+            request.Items.Add(items.Select(item => new Debugger.RemoteBreakpointRpc.TraceItem
+            {
+                Kind = item.kind.ConvertTo<Debugger.RemoteBreakpointRpc.TraceItemKind>(),
+                Expression = item.expression ?? "",
+                Size = item.size
+            }));
+            connection.InvokeRpc(() =>
+            {
+                client.SetTracepoint(request);
+            });
+        }
+
+        public void ClearTracepoint()
+        {
+            connection.InvokeRpc(() =>
+            {
+                client.ClearTracepoint(
+                    new ClearTracepointRequest { Breakpoint = grpcSbBreakpoint });
+            });
+        }
+
+        public List<DebuggerApi.TraceRecord> DrainTrace(uint maxRecords, out ulong droppedCount)
+        {
+            droppedCount = 0;
+            DrainTraceResponse response = null;
+            if (!connection.InvokeRpc(() =>
+                {
+                    response = client.DrainTrace(new DrainTraceRequest
+                    {
+                        Breakpoint = grpcSbBreakpoint,
+                        MaxRecords = maxRecords
+                    });
+                }))
+            {
+                return null;
+            }
+            droppedCount = response.DroppedCount;
+            return response.Records
+                .Select(record => new DebuggerApi.TraceRecord(
+                    record.Sequence, record.TimestampNanoseconds, record.ThreadId, record.Pc,
+                    record.LocationId,
+                    record.Values.Select(value => value.Valid ? value.Data.ToByteArray() : null)
+                        .ToList()))
+                .ToList();
+        }
+
+        public SbError ExportTrace(string path)
+        {
+            ExportTraceResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.ExportTrace(
+                        new ExportTraceRequest { Breakpoint = grpcSbBreakpoint, Path = path });
+                }))
+            {
+                return errorFactory.Create(response.Error);
+            }
+            var grpcSbError = new GrpcSbError
+            {
+                Success = false,
+                Error = "Rpc error while calling ExportTrace."
+            };
+            return errorFactory.Create(grpcSbError);
+        }
     }
 }
@@ -45,6 +45,7 @@ namespace DebuggerGrpcClient
         readonly GrpcSbTarget grpcSbTarget;
         readonly RemoteTargetRpcService.RemoteTargetRpcServiceClient client;
         readonly GrpcBreakpointFactory breakpointFactory;
+        readonly GrpcBreakpointLocationFactory breakpointLocationFactory;
         readonly GrpcErrorFactory errorFactory;
         readonly GrpcProcessFactory processFactory;
         readonly GrpcModuleFactory moduleFactory;
@@ -55,7 +56,8 @@ namespace DebuggerGrpcClient
         public RemoteTargetProxy(GrpcConnection connection, GrpcSbTarget grpcSbTarget)
             : this(connection, grpcSbTarget,
                    new RemoteTargetRpcService.RemoteTargetRpcServiceClient(connection.CallInvoker),
-                   new GrpcBreakpointFactory(), new GrpcErrorFactory(), new GrpcProcessFactory(),
+                   new GrpcBreakpointFactory(), new GrpcBreakpointLocationFactory(),
+                   new GrpcErrorFactory(), new GrpcProcessFactory(),
                    new GrpcModuleFactory(), new GrpcWatchpointFactory(), new GrpcAddressFactory(),
                    new GrpcTypeFactory())
         { }
@@ -63,6 +65,7 @@ namespace DebuggerGrpcClient
         public RemoteTargetProxy(GrpcConnection connection, GrpcSbTarget grpcSbTarget,
                                  RemoteTargetRpcService.RemoteTargetRpcServiceClient client,
                                  GrpcBreakpointFactory breakpointFactory,
+                                 GrpcBreakpointLocationFactory breakpointLocationFactory,
                                  GrpcErrorFactory errorFactory, GrpcProcessFactory processFactory,
                                  GrpcModuleFactory moduleFactory,
                                  GrpcWatchpointFactory watchpointFactory,
@@ -72,6 +75,7 @@ namespace DebuggerGrpcClient
             this.grpcSbTarget = grpcSbTarget;
             this.client = client;
             this.breakpointFactory = breakpointFactory;
+            this.breakpointLocationFactory = breakpointLocationFactory;
             this.errorFactory = errorFactory;
             this.processFactory = processFactory;
             this.moduleFactory = moduleFactory;
@@ -132,6 +136,52 @@ namespace DebuggerGrpcClient
             return null;
         }
 
+        public List<DebuggerApi.CreatedBreakpoint> BreakpointCreateByLocations(
+            IList<DebuggerApi.SourceLine> locations)
+        {
+            var request = new BreakpointCreateByLocationsRequest() { Target = grpcSbTarget };
+            foreach (DebuggerApi.SourceLine location in locations)
+            {
+                request.Locations.Add(new Debugger.RemoteTargetRpc.SourceLine()
+                {
+                    File = location.file,
+                    Line = location.line,
+                });
+            }
+            BreakpointCreateByLocationsResponse response = null;
+            var result = new List<DebuggerApi.CreatedBreakpoint>(locations.Count);
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.BreakpointCreateByLocations(request);
+                }))
+            {
+                foreach (Debugger.RemoteTargetRpc.CreatedBreakpoint created in
+                             response.Breakpoints)
+                {
+                    RemoteBreakpoint breakpoint = null;
+                    var breakpointLocations = new List<SbBreakpointLocation>();
+                    if (created.Breakpoint != null && created.Breakpoint.Id != 0)
+                    {
+                        breakpoint = breakpointFactory.Create(connection, created.Breakpoint);
+                        foreach (GrpcSbBreakpointLocation location in created.Locations)
+                        {
+                            breakpointLocations.Add(
+                                breakpointLocationFactory.Create(connection, location));
+                        }
+                    }
+                    result.Add(
+                        new DebuggerApi.CreatedBreakpoint(breakpoint, breakpointLocations));
+                }
+                return result;
+            }
+            foreach (DebuggerApi.SourceLine location in locations)
+            {
+                result.Add(new DebuggerApi.CreatedBreakpoint(
+                    null, new List<SbBreakpointLocation>()));
+            }
+            return result;
+        }
+
         public RemoteBreakpoint BreakpointCreateByName(string symbolName)
         {
             var request = new BreakpointCreateByNameRequest()
@@ -153,6 +203,35 @@ namespace DebuggerGrpcClient
             return null;
         }
 
+        public List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches)
+        {
+            var request = new FindFunctionsMatchingRequest()
+            {
+                Target = grpcSbTarget,
+                Pattern = pattern,
+                MaxMatches = maxMatches,
+            };
+            FindFunctionsMatchingResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.FindFunctionsMatching(request);
+                }))
+            {
+                if (response.InvalidPattern)
+                {
+                    return null;
+                }
+                var matches = new List<FunctionMatch>(response.Matches.Count);
+                foreach (GrpcFunctionMatch match in response.Matches)
+                {
+                    matches.Add(new FunctionMatch(match.Name, match.ModuleName, match.FileAddress,
+                                                  match.LoadAddress));
+                }
+                return matches;
+            }
+            return null;
+        }
+
         public RemoteBreakpoint BreakpointCreateByAddress(ulong address)
         {
             var request = new BreakpointCreateByAddressRequest()
@@ -255,6 +334,34 @@ namespace DebuggerGrpcClient
             return null;
         }
 
+        public List<ModuleSnapshot> GetModuleSnapshot()
+        {
+            var request = new GetModuleSnapshotRequest()
+            {
+                Target = grpcSbTarget,
+            };
+            GetModuleSnapshotResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.GetModuleSnapshot(request);
+                }))
+            {
+                var modules = new List<ModuleSnapshot>(response.Modules.Count);
+                foreach (GrpcModuleSnapshot module in response.Modules)
+                {
+                    SbModule sbModule = module.Module != null && module.Module.Id != 0
+                        ? moduleFactory.Create(connection, module.Module)
+                        : null;
+                    modules.Add(new ModuleSnapshot(sbModule, module.PlatformPath,
+                                                   module.SymbolPath, module.Uuid, module.Triple,
+                                                   module.CodeLoadAddress, module.CodeSize,
+                                                   module.HasSymbols, module.HasCompileUnits));
+                }
+                return modules;
+            }
+            return null;
+        }
+
         public long GetId()
         {
             return grpcSbTarget.Id;
@@ -424,6 +531,30 @@ namespace DebuggerGrpcClient
             return errorFactory.Create(grpcSbError);
         }
 
+        public SbError AddSymbolFile(SbModule module, string symbolFilePath)
+        {
+            AddSymbolFileResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.AddSymbolFile(
+                        new AddSymbolFileRequest
+                        {
+                            Target = grpcSbTarget,
+                            Module = new GrpcSbModule { Id = module.GetId() },
+                            SymbolFilePath = symbolFilePath,
+                        });
+                }))
+            {
+                return errorFactory.Create(response.Error);
+            }
+            var grpcSbError = new GrpcSbError
+            {
+                Success = false,
+                Error = "Rpc error while calling AddSymbolFile."
+            };
+            return errorFactory.Create(grpcSbError);
+        }
+
         public List<InstructionInfo> ReadInstructionInfos(SbAddress address,
             uint count, string flavor)
         {
@@ -456,6 +587,29 @@ namespace DebuggerGrpcClient
             return new List<InstructionInfo>();
         }
 
+        public List<LineEntryInfo> ResolveLineEntries(List<ulong> loadAddresses)
+        {
+            var request = new ResolveLineEntriesRequest
+            {
+                Target = grpcSbTarget,
+            };
+            request.LoadAddresses.AddRange(loadAddresses);
+            ResolveLineEntriesResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.ResolveLineEntries(request);
+                }))
+            {
+                var lineEntries = new List<LineEntryInfo>(response.LineEntries.Count);
+                foreach (ResolvedLineEntry resolved in response.LineEntries)
+                {
+                    lineEntries.Add(FrameInfoUtils.CreateLineEntryInfo(resolved.LineEntry));
+                }
+                return lineEntries;
+            }
+            return null;
+        }
+
         public EventType AddListener(SbListener listener, TargetEventType eventMask)
         {
             var request = new AddListenerRequest
@@ -233,6 +233,19 @@ namespace DebuggerGrpcClient
             // Set the correct path to llvm-objdump on the target.
             "settings set plugin.process.wine-dyld.remote-objdump-path \"" +
                 YetiCommon.YetiConstants.RemoteLlvmObjDumpPath + "\"",
+            // Cache symbol tables and manual DWARF indexes on disk, so
+            // the next session maps them instead of re-indexing the debug
+            // info. The patched LLDB also caches the class template sets
+            // of the index. Entries are keyed by module UUID and
+            // modification time. Forward slashes keep the path free of
+            // escapes.
+            "settings set symbols.enable-lldb-index-cache true",
+            "settings set symbols.lldb-index-cache-path \"" +
+                YetiCommon.SDKUtil.GetLldbIndexCachePath().Replace('\\', '/') + "\"",
+            // Keep the cache under 4 GiB and drop entries that weren't
+            // used for two weeks.
+            "settings set symbols.lldb-index-cache-max-byte-size 4294967296",
+            "settings set symbols.lldb-index-cache-expiration-days 14",
         };
 
         public static string GetLLDBInitPath()
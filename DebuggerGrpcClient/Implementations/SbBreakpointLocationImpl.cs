@@ -165,5 +165,21 @@ namespace DebuggerGrpcClient
             }
             return 0;
         }
+
+        public BreakpointConditionStats GetConditionStats()
+        {
+            GetConditionStatsResponse response = null;
+            if (connection.InvokeRpc(() =>
+            {
+                response = client.GetConditionStats(
+                    new GetConditionStatsRequest { BreakpointLocation = grpcSbBreakpointLocation });
+            }))
+            {
+                return new BreakpointConditionStats(
+                    response.HitCount, response.TrueCount, response.TotalEvaluationNanoseconds,
+                    response.MaxEvaluationNanoseconds);
+            }
+            return null;
+        }
     }
 }
@@ -17,7 +17,10 @@ using Debugger.SbProcessRpc;
 using DebuggerApi;
 using Google.Protobuf;
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
+using System.Linq;
+using YetiCommon;
 
 namespace DebuggerGrpcClient
 {
@@ -316,17 +319,49 @@ namespace DebuggerGrpcClient
             return 0;
         }
 
-        public void SaveCore(string dumpUrl, out SbError error)
+        public List<SbError> WriteMemory(IList<DebuggerApi.MemoryWrite> writes)
+        {
+            var request = new WriteMemoryBatchRequest { Process = grpcSbProcess };
+            request.Writes.AddRange(writes.Select(w => new Debugger.SbProcessRpc.MemoryWrite
+            {
+                Address = w.address,
+                Buffer = ByteString.CopyFrom(w.buffer)
+            }));
+            WriteMemoryBatchResponse response = null;
+            if (connection.InvokeRpc(() =>
+                {
+                    response = client.WriteMemoryBatch(request);
+                }))
+            {
+                return response.Errors.Select(e => errorFactory.Create(e)).ToList();
+            }
+            var grpcError = new GrpcSbError
+            {
+                Success = false,
+                Error = "Rpc error while calling WriteMemoryBatch."
+            };
+            return writes.Select(w => errorFactory.Create(grpcError)).ToList();
+        }
+
+        public void SaveCore(string dumpUrl, DebuggerApi.SaveCoreStyle style,
+                             IEnumerable<AddressRange> customRanges, out SbError error)
         {
+            var request = new SaveCoreRequest
+            {
+                Process = grpcSbProcess,
+                DumpPath = dumpUrl,
+                Style = style.ConvertTo<Debugger.SbProcessRpc.SaveCoreStyle>()
+            };
+            if (customRanges != null)
+            {
+                request.CustomRanges.AddRange(customRanges.Select(
+                    r => new GrpcAddressRange { AddressMin = r.addressMin,
+                                                AddressMax = r.addressMax }));
+            }
             SaveCoreResponse response = null;
             if (connection.InvokeRpc(() =>
             {
-                response = client.SaveCore(
-                    new SaveCoreRequest
-                    {
-                        Process = grpcSbProcess,
-                        DumpPath = dumpUrl
-                    });
+                response = client.SaveCore(request);
             }))
             {
                 error = errorFactory.Create(response.Error);
@@ -341,6 +376,23 @@ namespace DebuggerGrpcClient
             return;
         }
 
+        public DebuggerApi.PageWatchpointStopResult HandlePageWatchpointStop(
+            out int watchpointId)
+        {
+            HandlePageWatchpointStopResponse response = null;
+            if (connection.InvokeRpc(() =>
+            {
+                response = client.HandlePageWatchpointStop(
+                    new HandlePageWatchpointStopRequest { Process = grpcSbProcess });
+            }))
+            {
+                watchpointId = response.WatchpointId;
+                return response.Result.ConvertTo<DebuggerApi.PageWatchpointStopResult>();
+            }
+            watchpointId = 0;
+            return DebuggerApi.PageWatchpointStopResult.NotHandled;
+        }
+
         #endregion
     }
 }
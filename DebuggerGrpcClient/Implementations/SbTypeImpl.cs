@@ -41,6 +41,10 @@ namespace DebuggerGrpcClient
         readonly GrpcTypeMemberFactory typeMemberFactory;
         readonly GCHandle gcHandle;
 
+        // Layouts don't change, so the first response is reused.
+        TypeLayout layout;
+        bool layoutFetched;
+
         internal SbTypeImpl(GrpcConnection connection, GrpcSbType grpcSbType)
             : this(connection,
                 new SbTypeRpcServiceClient(connection.CallInvoker), grpcSbType,
@@ -164,5 +168,42 @@ namespace DebuggerGrpcClient
             }
             return 0;
         }
+
+        public TypeLayout GetLayout()
+        {
+            if (layoutFetched)
+            {
+                return layout;
+            }
+            GetLayoutResponse response = null;
+            if (!connection.InvokeRpc(() => {
+                    response = client.GetLayout(new GetLayoutRequest { Type = grpcSbType });
+                }))
+            {
+                return null;
+            }
+            layoutFetched = true;
+            if (!response.HasLayout)
+            {
+                return null;
+            }
+            var fields = new List<TypeLayoutField>(response.NameIds.Count);
+            for (int i = 0; i < response.NameIds.Count; i++)
+            {
+                fields.Add(new TypeLayoutField
+                {
+                    nameId = response.NameIds[i],
+                    typeId = response.TypeIds[i],
+                    offset = response.Offsets[i],
+                    size = response.Sizes[i],
+                    bitfieldBitOffset = response.BitfieldBitOffsets[i],
+                    bitfieldBitSize = response.BitfieldBitSizes[i],
+                });
+            }
+            layout = new TypeLayout(response.ByteSize, response.HasVirtualBases,
+                                    new List<string>(response.Names),
+                                    new List<string>(response.TypeNames), fields);
+            return layout;
+        }
     }
 }
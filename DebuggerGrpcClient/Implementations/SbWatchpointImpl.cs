@@ -116,5 +116,21 @@ namespace DebuggerGrpcClient
                     });
             });
         }
+
+        public WatchpointStats GetStats()
+        {
+            GetStatsResponse response = null;
+            if (connection.InvokeRpc(() =>
+            {
+                response = client.GetStats(
+                    new GetStatsRequest { Watchpoint = grpcSbWatchpoint });
+            }))
+            {
+                return new WatchpointStats(response.HitCount, response.FaultCount,
+                                           response.FilteredFaultCount,
+                                           response.TotalHandlingNanoseconds);
+            }
+            return null;
+        }
     }
 }
\ No newline at end of file
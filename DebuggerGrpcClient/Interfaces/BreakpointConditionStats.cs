@@ -0,0 +1,38 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace DebuggerApi
+{
+    /// <summary>
+    /// Counters collected while evaluating the condition of a breakpoint location.
+    /// </summary>
+    public class BreakpointConditionStats
+    {
+        public readonly ulong hitCount;
+        public readonly ulong trueCount;
+        public readonly ulong totalEvaluationNanoseconds;
+        public readonly ulong maxEvaluationNanoseconds;
+
+        public BreakpointConditionStats(ulong hitCount, ulong trueCount,
+                                        ulong totalEvaluationNanoseconds,
+                                        ulong maxEvaluationNanoseconds)
+        {
+            this.hitCount = hitCount;
+            this.trueCount = trueCount;
+            this.totalEvaluationNanoseconds = totalEvaluationNanoseconds;
+            this.maxEvaluationNanoseconds = maxEvaluationNanoseconds;
+        }
+    }
+}
@@ -130,6 +130,31 @@ namespace DebuggerApi
         Other
     }
 
+    // Which parts of the process memory are written by SbProcess.SaveCore.
+    public enum SaveCoreStyle
+    {
+        StackOnly,
+        ModifiedPages, // Writable regions, or their dirty pages if known
+        Full,          // All readable regions
+        Custom,        // Stacks plus the ranges passed to SbProcess.SaveCore
+    }
+
+    // Result of SbProcess.HandlePageWatchpointStop.
+    public enum PageWatchpointStopResult
+    {
+        NotHandled, // The stop is not caused by a page watchpoint
+        Resumed,    // The stop was handled internally and the process resumed
+        Hit,        // A page watchpoint was hit
+    }
+
+    // What a tracepoint collects for a TraceItem.
+    public enum TraceItemKind
+    {
+        Register,   // Value of the register named by the expression
+        Expression, // Value of the expression
+        Memory,     // Size bytes at the address the expression evaluates to
+    }
+
     // LLDB defines and constants
     public static class DebuggerConstants
     {
@@ -0,0 +1,38 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace DebuggerApi
+{
+    /// <summary>
+    /// A function found by RemoteTarget.FindFunctionsMatching.
+    /// </summary>
+    public class FunctionMatch
+    {
+        public readonly string name;
+        // Platform file name of the module that contains the function.
+        public readonly string moduleName;
+        public readonly ulong fileAddress;
+        // ulong.MaxValue if the module isn't loaded.
+        public readonly ulong loadAddress;
+
+        public FunctionMatch(string name, string moduleName, ulong fileAddress, ulong loadAddress)
+        {
+            this.name = name;
+            this.moduleName = moduleName;
+            this.fileAddress = fileAddress;
+            this.loadAddress = loadAddress;
+        }
+    }
+}
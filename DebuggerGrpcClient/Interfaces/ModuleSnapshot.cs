@@ -0,0 +1,49 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace DebuggerApi
+{
+    /// <summary>
+    /// What the Modules window shows about a module, fetched for all modules at once.
+    /// </summary>
+    public class ModuleSnapshot
+    {
+        // Null if the module at this index is invalid.
+        public readonly SbModule module;
+        public readonly string platformPath;
+        // File the symbols were loaded from, empty if none.
+        public readonly string symbolPath;
+        public readonly string uuid;
+        public readonly string triple;
+        public readonly ulong codeLoadAddress;
+        public readonly ulong codeSize;
+        public readonly bool hasSymbols;
+        public readonly bool hasCompileUnits;
+
+        public ModuleSnapshot(SbModule module, string platformPath, string symbolPath,
+                              string uuid, string triple, ulong codeLoadAddress, ulong codeSize,
+                              bool hasSymbols, bool hasCompileUnits)
+        {
+            this.module = module;
+            this.platformPath = platformPath;
+            this.symbolPath = symbolPath;
+            this.uuid = uuid;
+            this.triple = triple;
+            this.codeLoadAddress = codeLoadAddress;
+            this.codeSize = codeSize;
+            this.hasSymbols = hasSymbols;
+            this.hasCompileUnits = hasCompileUnits;
+        }
+    }
+}
@@ -71,5 +71,28 @@ namespace DebuggerApi
         /// Set the commands to be executed when the breakpoint is hit.
         /// </summary>
         void SetCommandLineCommands(IEnumerable<string> commands);
+
+        /// <summary>
+        /// Turn the breakpoint into a tracepoint. Hits don't stop the process, instead |items|
+        /// are collected into a buffer that holds the latest |capacity| hits.
+        /// </summary>
+        void SetTracepoint(IEnumerable<TraceItem> items, uint capacity);
+
+        /// <summary>
+        /// Turn a tracepoint back into a regular breakpoint and drop its buffer.
+        /// </summary>
+        void ClearTracepoint();
+
+        /// <summary>
+        /// Remove and return up to |maxRecords| of the oldest trace records, 0 for all of them.
+        /// |droppedCount| is the number of records overwritten since the previous call.
+        /// Returns null if the RPC fails.
+        /// </summary>
+        List<TraceRecord> DrainTrace(uint maxRecords, out ulong droppedCount);
+
+        /// <summary>
+        /// Drain all trace records and append them to the binary trace file at |path|.
+        /// </summary>
+        SbError ExportTrace(string path);
     }
 }
@@ -55,11 +55,25 @@ namespace DebuggerApi
         /// </summary>
         RemoteBreakpoint BreakpointCreateByLocation(string file, uint line);
 
+        /// <summary>
+        /// Set breakpoints at the specified file and line numbers in a single call. Returns one
+        /// entry per location, in order. The entry's breakpoint is null if no breakpoint could
+        /// be created.
+        /// </summary>
+        List<CreatedBreakpoint> BreakpointCreateByLocations(IList<SourceLine> locations);
+
         /// <summary>
         /// Set breakpoints at all functions that match the specified symbol name.
         /// </summary>
         RemoteBreakpoint BreakpointCreateByName(string symbolName);
 
+        /// <summary>
+        /// Find up to |maxMatches| functions whose names match the regular expression |pattern|,
+        /// in module and symbol order. A pattern without metacharacters matches names that
+        /// contain it. Returns null if |pattern| is invalid or the call fails.
+        /// </summary>
+        List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches);
+
         /// <summary>
         /// Set breakpoint at specified memory address.
         /// </summary>
@@ -92,6 +106,12 @@ namespace DebuggerApi
         /// </summary>
         SbModule GetModuleAtIndex(int index);
 
+        /// <summary>
+        /// Get a snapshot of every module in the module list, in module index order, with one
+        /// call. Returns null if the call fails.
+        /// </summary>
+        List<ModuleSnapshot> GetModuleSnapshot();
+
         /// <summary>
         /// A unique identifier for the listener.  Not part of the LLDB API.
         /// </summary>
@@ -137,11 +157,24 @@ namespace DebuggerApi
         /// </summary>
         SbError SetModuleLoadAddress(SbModule module, long sectionsOffset);
 
+        /// <summary>
+        /// Make the file at |symbolFilePath| the symbol file of |module|, like
+        /// `target symbols add`. Symbol files of several modules can be added at once.
+        /// </summary>
+        SbError AddSymbolFile(SbModule module, string symbolFilePath);
+
         /// <summary>
         /// Fetch all the information required for displaying disassembly in a single gRPC call.
         /// </summary>
         List<InstructionInfo> ReadInstructionInfos(SbAddress address, uint count, string flavor);
 
+        /// <summary>
+        /// Resolves the line entries of |loadAddresses| with one call. Returns one entry per
+        /// address, in order, null for addresses without a line entry. Returns null if the call
+        /// fails.
+        /// </summary>
+        List<LineEntryInfo> ResolveLineEntries(List<ulong> loadAddresses);
+
         /// <summary>
         /// Adds a listener to target's broadcaster.
         /// Only one listener can be subscribed to a specific event type.
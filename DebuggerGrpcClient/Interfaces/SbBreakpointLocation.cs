@@ -58,5 +58,11 @@ namespace DebuggerApi
         /// Get number of hits for the particular location.
         /// </summary>
         uint GetHitCount();
+
+        /// <summary>
+        /// Get the hit and evaluation time counters of the condition set with SetCondition.
+        /// Returns null if the RPC fails.
+        /// </summary>
+        BreakpointConditionStats GetConditionStats();
     }
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
 
 namespace DebuggerApi
 {
@@ -116,14 +117,39 @@ namespace DebuggerApi
         /// </summary>
         ulong WriteMemory(ulong address, byte[] buffer, ulong size, out SbError error);
 
+        /// <summary>
+        /// Performs |writes| in as few remote writes as possible. Adjacent and overlapping
+        /// writes are merged, where later writes take precedence over earlier ones.
+        /// </summary>
+        /// <returns>
+        /// One error object per write, in the order of |writes|.
+        /// </returns>
+        List<SbError> WriteMemory(IList<MemoryWrite> writes);
+
         /// <summary>
         /// Dumps core to dumpUrl path and returns status of the operation.
         /// </summary>
         /// <param name="dumpUrl">The path where dump will be eventually saved.</param>
+        /// <param name="style">Which parts of the process memory to save.</param>
+        /// <param name="customRanges">
+        /// Ranges to save in addition to the stacks when style is Custom. Ignored otherwise.
+        /// </param>
         /// <param name="error">The resulting status of a dump saving.</param>
         /// <returns>
         /// Status in error parameter. Either success or error.
         /// </returns>
-        void SaveCore(string dumpUrl, out SbError error);
+        void SaveCore(string dumpUrl, SaveCoreStyle style, IEnumerable<AddressRange> customRanges,
+                      out SbError error);
+
+        /// <summary>
+        /// Handles the faults and single steps of watchpoints that are too large for the
+        /// debug registers. Must be called on every stop before it is reported.
+        /// </summary>
+        /// <param name="watchpointId">The ID of the watchpoint that was hit.</param>
+        /// <returns>
+        /// Hit if such a watchpoint was hit, in which case the thread that hit it is selected.
+        /// Resumed if the stop should be ignored.
+        /// </returns>
+        PageWatchpointStopResult HandlePageWatchpointStop(out int watchpointId);
     }
 }
\ No newline at end of file
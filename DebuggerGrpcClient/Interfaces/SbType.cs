@@ -74,6 +74,10 @@ namespace DebuggerApi
         // Returns byte size.
         ulong GetByteSize();
 
+        // Returns the offsets and sizes of the data members of the type, including those of its
+        // base classes, or null for unnamed types. Not part of the LLDB API.
+        TypeLayout GetLayout();
+
         // Returns a unique identifier for the type. Not part of the LLDB API.
         long GetId();
     }
@@ -31,5 +31,9 @@ namespace DebuggerApi
 
         // Set the breakpoint to ignore the next |ignoreCount| hits.
         void SetIgnoreCount(uint ignoreCount);
+
+        // Get the hit and fault counters of the watchpoint. Returns null if the counters
+        // couldn't be retrieved.
+        WatchpointStats GetStats();
     }
 }
\ No newline at end of file
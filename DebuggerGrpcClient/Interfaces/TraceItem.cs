@@ -0,0 +1,32 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace DebuggerApi
+{
+    public class TraceItem
+    {
+        public readonly TraceItemKind kind;
+        public readonly string expression;
+        // Bytes read for Memory items, otherwise the maximum number of bytes kept (0 for the
+        // default).
+        public readonly uint size;
+        public TraceItem(TraceItemKind kind, string expression, uint size)
+        {
+            this.kind = kind;
+            this.expression = expression;
+            this.size = size;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System.Collections.Generic;
+
+namespace DebuggerApi
+{
+    // The values collected on one hit of a tracepoint.
+    public class TraceRecord
+    {
+        public readonly ulong sequence;
+        public readonly ulong timestampNanoseconds;
+        public readonly ulong threadId;
+        public readonly ulong pc;
+        public readonly int locationId;
+        // Raw bytes of each trace item, null if the item couldn't be collected.
+        public readonly List<byte[]> values;
+        public TraceRecord(ulong sequence, ulong timestampNanoseconds, ulong threadId, ulong pc,
+                           int locationId, List<byte[]> values)
+        {
+            this.sequence = sequence;
+            this.timestampNanoseconds = timestampNanoseconds;
+            this.threadId = threadId;
+            this.pc = pc;
+            this.locationId = locationId;
+            this.values = values;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Collections.Generic;
+
+namespace DebuggerApi
+{
+    /// <summary>
+    /// A data member in a TypeLayout.
+    /// </summary>
+    public struct TypeLayoutField
+    {
+        // Index into TypeLayout.names.
+        public uint nameId;
+        // Index into TypeLayout.typeNames.
+        public uint typeId;
+        // Byte offset from the start of the type the layout describes.
+        public ulong offset;
+        public ulong size;
+        // Position of a bitfield within the byte at offset. Both are 0 for other fields.
+        public uint bitfieldBitOffset;
+        public uint bitfieldBitSize;
+    }
+
+    /// <summary>
+    /// The data members of a type and of its non-virtual base classes, returned by
+    /// SbType.GetLayout.
+    /// </summary>
+    public class TypeLayout
+    {
+        public readonly ulong byteSize;
+        // True if the type or one of its bases has virtual bases. Their members are missing
+        // from fields.
+        public readonly bool hasVirtualBases;
+        public readonly List<string> names;
+        public readonly List<string> typeNames;
+        // Base class members come first. Members of anonymous structs and unions are listed
+        // as members of the enclosing type.
+        public readonly List<TypeLayoutField> fields;
+
+        public TypeLayout(ulong byteSize, bool hasVirtualBases, List<string> names,
+                          List<string> typeNames, List<TypeLayoutField> fields)
+        {
+            this.byteSize = byteSize;
+            this.hasVirtualBases = hasVirtualBases;
+            this.names = names;
+            this.typeNames = typeNames;
+            this.fields = fields;
+        }
+    }
+}
@@ -15,6 +15,8 @@
 ﻿using NUnit.Framework;
 using NSubstitute;
 using LldbApi;
+using System.Collections.Generic;
+using System.Linq;
 
 namespace DebuggerGrpcServer.Tests
 {
@@ -42,5 +44,34 @@ namespace DebuggerGrpcServer.Tests
             remoteTarget = new RemoteTargetFactory(breakpointFactory).Create(mockTarget);
             mockFunction = Substitute.For<SbFunction>();
         }
+
+        [Test]
+        public void SetTracepoint()
+        {
+            var items = new[]
+            {
+                new TraceItem(TraceItemKind.Register, "rip", 0),
+                new TraceItem(TraceItemKind.Memory, "buffer", 16),
+            };
+            remoteBreakpoint.SetTracepoint(items, 128);
+            mockBreakpoint.Received().SetTracepoint(
+                Arg.Is<List<TraceItem>>(list => list.SequenceEqual(items)), 128);
+        }
+
+        [Test]
+        public void SetTracepointKeepsLocationCondition()
+        {
+            var mockLocation = Substitute.For<SbBreakpointLocation>();
+            mockBreakpoint.FindLocationById(1).Returns(mockLocation);
+            remoteBreakpoint.FindLocationById(1).SetCondition("i == 4711");
+
+            var items = new[] { new TraceItem(TraceItemKind.Expression, "i", 0) };
+            remoteBreakpoint.SetTracepoint(items, 16);
+
+            mockLocation.Received(1).SetCondition(Arg.Any<string>());
+            mockLocation.Received().SetCondition("i == 4711");
+            mockBreakpoint.Received().SetTracepoint(
+                Arg.Is<List<TraceItem>>(list => list.SequenceEqual(items)), 16);
+        }
     }
 }
\ No newline at end of file
@@ -73,6 +73,7 @@ namespace DebuggerGrpcServer.Tests
                                                                  "intel");
             Assert.AreEqual(numberInstructions, instructions.Count);
             Assert.IsNull(instructions[0].SymbolName);
+            mockTarget.Received(1).DisassembleRange(TEST_ADDRESS, numberInstructions, "intel");
         }
 
         [Test]
@@ -97,38 +98,15 @@ namespace DebuggerGrpcServer.Tests
             Assert.AreEqual(instructionsToRead, instructions.Count);
         }
 
-        [Test]
-        public void ReadInstructionsWithoutAddress()
-        {
-            uint numberInstructions = 10;
-
-            // Create mock instructions without address
-            var mockInstructions = MockRead(numberInstructions, mockAddress, mockMemoryRegion,
-                                            TEST_ADDRESS, true, false);
-
-            mockTarget
-                .GetInstructionsWithFlavor(mockAddress, Arg.Any<byte[]>(), Arg.Any<ulong>(),
-                                           "intel").Returns(mockInstructions);
-
-            var instructions = remoteTarget.ReadInstructionInfos(mockAddress, numberInstructions,
-                                                                 "intel");
-            // Should break and return an empty list
-            Assert.AreEqual(0, instructions.Count);
-        }
-
         [Test]
         public void ReadWithSingleSymbol()
         {
             uint numberInstructions = 20;
             int symbolPos = 6;
-            var mockInstructions = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
+            var records = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
 
-            var mockSbAddress = mockInstructions[symbolPos].GetAddress();
-            var mockSymbol = Substitute.For<SbSymbol>();
-            mockSymbol.GetName().Returns(TEST_SYMBOL);
             // Make sure it's the same address as the function
-            mockSymbol.GetStartAddress().Returns(mockSbAddress);
-            mockSbAddress.GetSymbol().Returns(mockSymbol);
+            AddSymbol(records, symbolPos, TEST_ADDRESS + (ulong)symbolPos);
 
             var instructions = remoteTarget.ReadInstructionInfos(mockAddress, numberInstructions,
                                                                  "intel");
@@ -141,15 +119,10 @@ namespace DebuggerGrpcServer.Tests
         {
             uint numberInstructions = 20;
             int symbolPos = 8;
-            var mockInstructions = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
+            var records = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
 
-            var mockSbAddress = mockInstructions[symbolPos].GetAddress();
-            var mockSymbol = Substitute.For<SbSymbol>();
-            mockSymbol.GetName().Returns(TEST_SYMBOL);
             // Make sure it returns an address that is not equal to the instruction
-            mockSymbol.GetStartAddress().GetLoadAddress(mockTarget).
-                Returns(TEST_ADDRESS + 0xdeadbeef);
-            mockSbAddress.GetSymbol().Returns(mockSymbol);
+            AddSymbol(records, symbolPos, TEST_ADDRESS + 0xdeadbeef);
 
             var instructions = remoteTarget.ReadInstructionInfos(mockAddress, numberInstructions,
                 "intel");
@@ -162,15 +135,18 @@ namespace DebuggerGrpcServer.Tests
         {
             uint numberInstructions = 20;
             int lineEntryPos = 9;
-            var mockInstructions = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
+            var records = MockRead(numberInstructions, mockAddress, mockMemoryRegion);
 
-            var mockSbAddress = mockInstructions[lineEntryPos].GetAddress();
-            var mockLineEntry = Substitute.For<SbLineEntry>();
-            mockLineEntry.GetFileName().Returns(TEST_FILENAME);
-            mockLineEntry.GetDirectory().Returns(TEST_DIRECTORY);
-            mockLineEntry.GetLine().Returns(TEST_LINE);
-            mockLineEntry.GetColumn().Returns(TEST_COLUMN);
-            mockSbAddress.GetLineEntry().Returns(mockLineEntry);
+            records.LineEntries.Add(new LineEntryRecord
+            {
+                FileName = TEST_FILENAME,
+                Directory = TEST_DIRECTORY,
+                Line = TEST_LINE,
+                Column = TEST_COLUMN
+            });
+            InstructionRecord record = records.Instructions[lineEntryPos];
+            record.LineEntryIndex = 0;
+            records.Instructions[lineEntryPos] = record;
 
             var instructions = remoteTarget.ReadInstructionInfos(mockAddress, numberInstructions,
                                                                  "intel");
@@ -179,6 +155,31 @@ namespace DebuggerGrpcServer.Tests
             Assert.AreEqual(instructions[lineEntryPos].LineEntry.Directory, TEST_DIRECTORY);
             Assert.AreEqual(instructions[lineEntryPos].LineEntry.Line, TEST_LINE);
             Assert.AreEqual(instructions[lineEntryPos].LineEntry.Column, TEST_COLUMN);
+            Assert.IsNull(instructions[0].LineEntry);
+        }
+
+        [Test]
+        public void ResolveLineEntries()
+        {
+            var addresses = new List<ulong> { TEST_ADDRESS, TEST_ADDRESS + 1 };
+            mockTarget.ResolveLineEntries(addresses).Returns(new List<LineEntryRecord> {
+                new LineEntryRecord
+                {
+                    FileName = TEST_FILENAME,
+                    Directory = TEST_DIRECTORY,
+                    Line = TEST_LINE,
+                    Column = TEST_COLUMN
+                },
+                new LineEntryRecord(),
+            });
+
+            var lineEntries = remoteTarget.ResolveLineEntries(addresses);
+            Assert.AreEqual(2, lineEntries.Count);
+            Assert.AreEqual(TEST_FILENAME, lineEntries[0].FileName);
+            Assert.AreEqual(TEST_DIRECTORY, lineEntries[0].Directory);
+            Assert.AreEqual(TEST_LINE, lineEntries[0].Line);
+            Assert.AreEqual(TEST_COLUMN, lineEntries[0].Column);
+            Assert.IsNull(lineEntries[1]);
         }
 
         [Test]
@@ -189,17 +190,14 @@ namespace DebuggerGrpcServer.Tests
             uint numberInstructionsAfter = numberInstructions - invalidPos - 1u;
 
             var mockBeforeAddress = Substitute.For<SbAddress>();
+            var mockInvalidAddress = Substitute.For<SbAddress>();
             var mockAfterAddress = Substitute.For<SbAddress>();
 
-            // Make sure that it will resolve to the correct address after the invalid instruction
-            mockTarget.ResolveLoadAddress(TEST_ADDRESS + invalidPos + 1).Returns(mockAfterAddress);
-
             // Create valid instructions up to |invalidPos|
-            var mockBeforeInvalidInstructions =
-                MockRead(invalidPos, mockBeforeAddress, mockMemoryRegion);
-
-            var mockAfterInvalidInstructions =
-                MockRead(numberInstructionsAfter, mockAfterAddress, mockMemoryRegion);
+            MockRead(invalidPos, mockBeforeAddress, mockMemoryRegion);
+            MockRead(0, mockInvalidAddress, mockMemoryRegion, TEST_ADDRESS + invalidPos);
+            MockRead(numberInstructionsAfter, mockAfterAddress, mockMemoryRegion,
+                     TEST_ADDRESS + invalidPos + 1);
 
             var instructions = remoteTarget.ReadInstructionInfos(mockBeforeAddress,
                 numberInstructions, "intel");
@@ -208,6 +206,7 @@ namespace DebuggerGrpcServer.Tests
             Assert.AreEqual(numberInstructions, instructions.Count);
             Assert.AreEqual("??", invalidInstruction.Operands);
             Assert.AreEqual("??", invalidInstruction.Mnemonic);
+            Assert.AreNotEqual("??", instructions[(int)invalidPos + 1].Operands);
         }
 
         [Test]
@@ -221,8 +220,7 @@ namespace DebuggerGrpcServer.Tests
 
             // Make sure we did not try to disassemble
             mockTarget.DidNotReceiveWithAnyArgs()
-                .GetInstructionsWithFlavor(mockAddress, Arg.Any<byte[]>(), Arg.Any<ulong>(),
-                                           Arg.Any<string>());
+                .DisassembleRange(Arg.Any<ulong>(), Arg.Any<uint>(), Arg.Any<string>());
             Assert.AreEqual(numberInstructions, instructions.Count);
         }
 
@@ -250,8 +248,9 @@ namespace DebuggerGrpcServer.Tests
             var instructions =
                 remoteTarget.ReadInstructionInfos(mockFirstAddress, instructionsToRead, "intel");
 
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockFirstAddress, Arg.Any<byte[]>(),
-                                                             secondAddress - firstAddress, "intel");
+            mockTarget.Received(1).DisassembleRange(firstAddress, instructionsToRead, "intel");
+            mockTarget.DidNotReceive().DisassembleRange(secondAddress, Arg.Any<uint>(),
+                                                        Arg.Any<string>());
             Assert.AreEqual(instructionsToRead, instructions.Count);
             Assert.AreNotEqual("??", instructions[(int)instructionsToCreate - 1].Operands);
             Assert.AreEqual("??", instructions[(int)instructionsToCreate].Operands);
@@ -276,15 +275,15 @@ namespace DebuggerGrpcServer.Tests
             ulong firstAddress = secondAddress - instructionsToCreate;
 
             MockRead(instructionsToCreate, mockFirstAddress, mockFirstMemoryRegion, firstAddress,
-                     false, true, secondAddress);
+                     false, secondAddress);
             MockRead(instructionsToRead - instructionsToCreate, mockSecondAddress,
                      mockSecondMemoryRegion, secondAddress);
 
             var instructions =
                 remoteTarget.ReadInstructionInfos(mockFirstAddress, instructionsToRead, "intel");
 
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockSecondAddress, Arg.Any<byte[]>(),
-                                                             pageSize, "intel");
+            mockTarget.Received(1).DisassembleRange(
+                secondAddress, instructionsToRead - instructionsToCreate, "intel");
             Assert.AreEqual(instructionsToRead, instructions.Count);
             Assert.AreEqual("??", instructions[(int)instructionsToCreate - 1].Operands);
             Assert.AreNotEqual("??", instructions[(int)instructionsToCreate].Operands);
@@ -306,12 +305,14 @@ namespace DebuggerGrpcServer.Tests
             const ulong secondAddress = invalidInstructionAddress + invalidInstructionCount;
 
             var mockFirstAddress = Substitute.For<SbAddress>();
+            var mockInvalidAddress = Substitute.For<SbAddress>();
             var mockSecondAddress = Substitute.For<SbAddress>();
 
             var mockFirstMemoryRegion = Substitute.For<SbMemoryRegionInfo>();
             var mockSecondMemoryRegion = Substitute.For<SbMemoryRegionInfo>();
 
             MockRead(firstInstructionsCount, mockFirstAddress, mockFirstMemoryRegion, firstAddress);
+            MockRead(0, mockInvalidAddress, mockFirstMemoryRegion, invalidInstructionAddress);
             MockRead(secondInstructionsCount, mockSecondAddress, mockSecondMemoryRegion,
                      secondAddress);
 
@@ -324,11 +325,10 @@ namespace DebuggerGrpcServer.Tests
             mockProcess.DidNotReceive()
                 .GetMemoryRegionInfo(invalidInstructionAddress, out anyRegionInfo);
 
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockFirstAddress, Arg.Any<byte[]>(),
-                                                             pageSize, "intel");
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockSecondAddress, Arg.Any<byte[]>(),
-                                                             pageSize - firstInstructionsCount -
-                                                             invalidInstructionCount, "intel");
+            mockTarget.Received(1).DisassembleRange(firstAddress, totalInstructions, "intel");
+            mockTarget.Received(1).DisassembleRange(
+                secondAddress, totalInstructions - firstInstructionsCount -
+                invalidInstructionCount, "intel");
 
             Assert.That(instructions.Count, Is.EqualTo(totalInstructions));
             Assert.That(instructions[(int) (invalidInstructionAddress - firstAddress)].Operands,
@@ -343,51 +343,39 @@ namespace DebuggerGrpcServer.Tests
         {
             const ulong pageNumber = 1;
             const ulong pageSize = 4096;
-            const uint firstInstructionsCount = 1;
-            const uint secondInstructionsCount = 1;
             const uint boundaryInstructionSize = 3;
-            const uint totalInstructions = firstInstructionsCount + secondInstructionsCount + 1;
+            const uint totalInstructions = 3;
 
             const ulong firstAddress = pageNumber * pageSize - 2;
-            const ulong boundaryInstructionAddress = firstAddress + firstInstructionsCount;
+            const ulong boundaryInstructionAddress = firstAddress + 1;
             const ulong secondAddress = boundaryInstructionAddress + boundaryInstructionSize;
 
             var mockFirstAddress = Substitute.For<SbAddress>();
             var mockSecondAddress = Substitute.For<SbAddress>();
 
-            var mockBoundaryInstructionAddress = Substitute.For<SbAddress>();
-            mockTarget.ResolveLoadAddress(boundaryInstructionAddress)
-                .Returns(mockBoundaryInstructionAddress);
-            mockBoundaryInstructionAddress.GetLoadAddress(mockTarget)
-                .Returns(boundaryInstructionAddress);
-
             var mockFirstMemoryRegion = Substitute.For<SbMemoryRegionInfo>();
             var mockSecondMemoryRegion = Substitute.For<SbMemoryRegionInfo>();
 
-            MockRead(firstInstructionsCount, mockFirstAddress, mockFirstMemoryRegion, firstAddress);
-            MockRead(secondInstructionsCount, mockSecondAddress, mockSecondMemoryRegion,
-                     secondAddress);
-
-            var instruction = Substitute.For<SbInstruction>();
-            instruction.GetByteSize().Returns(boundaryInstructionSize);
-            instruction.GetAddress().Returns(mockBoundaryInstructionAddress);
-            mockTarget.ReadInstructions(mockBoundaryInstructionAddress, 1, "intel")
-                .Returns(new List<SbInstruction>() { instruction });
+            // The instruction that crosses the page boundary is disassembled together with the
+            // one before it.
+            var firstRecords = MockRead(2, mockFirstAddress, mockFirstMemoryRegion, firstAddress);
+            InstructionRecord boundaryInstruction = firstRecords.Instructions[1];
+            boundaryInstruction.Size = boundaryInstructionSize;
+            firstRecords.Instructions[1] = boundaryInstruction;
+            MockRead(1, mockSecondAddress, mockSecondMemoryRegion, secondAddress);
 
             var instructions =
                 remoteTarget.ReadInstructionInfos(mockFirstAddress, totalInstructions, "intel");
 
-            mockTarget.Received(1).ReadInstructions(mockBoundaryInstructionAddress, 1, "intel");
-
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockFirstAddress, Arg.Any<byte[]>(),
-                                                             Arg.Any<ulong>(), "intel");
-            mockTarget.Received(1).GetInstructionsWithFlavor(mockSecondAddress, Arg.Any<byte[]>(),
-                                                             Arg.Any<ulong>(), "intel");
+            mockTarget.Received(1).DisassembleRange(firstAddress, totalInstructions, "intel");
+            mockTarget.Received(1).DisassembleRange(secondAddress, 1, "intel");
 
             Assert.That(instructions.Count, Is.EqualTo(totalInstructions));
             Assert.That(instructions[0].Operands, Is.Not.EqualTo("??"));
             Assert.That(instructions[1].Operands, Is.Not.EqualTo("??"));
+            Assert.That(instructions[1].Address, Is.EqualTo(boundaryInstructionAddress));
             Assert.That(instructions[2].Operands, Is.Not.EqualTo("??"));
+            Assert.That(instructions[2].Address, Is.EqualTo(secondAddress));
         }
 
         [Test]
@@ -400,20 +388,18 @@ namespace DebuggerGrpcServer.Tests
             const ulong address = pageNumber * pageSize;
 
             var mockInstructionAddress = Substitute.For<SbAddress>();
+            var mockInvalidAddress = Substitute.For<SbAddress>();
             var mockInstructionMemoryRegion = Substitute.For<SbMemoryRegionInfo>();
 
             MockRead(instructionsCount, mockInstructionAddress, mockInstructionMemoryRegion,
                      address);
+            MockRead(0, mockInvalidAddress, mockInstructionMemoryRegion,
+                     address + instructionsCount);
 
             var instructions =
                 remoteTarget.ReadInstructionInfos(mockInstructionAddress, 2, "intel");
 
-            mockTarget.DidNotReceive()
-                .ReadInstructions(Arg.Any<SbAddress>(), Arg.Any<uint>(), Arg.Any<string>());
-
-            mockTarget.Received(1)
-                .GetInstructionsWithFlavor(mockInstructionAddress, Arg.Any<byte[]>(),
-                                           Arg.Any<ulong>(), "intel");
+            mockTarget.Received(1).DisassembleRange(address, 2, "intel");
             Assert.That(instructions.Count, Is.EqualTo(2));
             Assert.That(instructions[0].Operands, Is.Not.EqualTo("??"));
             Assert.That(instructions[1].Operands, Is.EqualTo("??"));
@@ -434,8 +420,26 @@ namespace DebuggerGrpcServer.Tests
             Assert.AreEqual(0, instructions.Count);
             mockMemoryRegion.DidNotReceive().IsMapped();
             mockTarget.DidNotReceiveWithAnyArgs()
-                .GetInstructionsWithFlavor(mockAddress, Arg.Any<byte[]>(), Arg.Any<ulong>(),
-                                           Arg.Any<string>());
+                .DisassembleRange(Arg.Any<ulong>(), Arg.Any<uint>(), Arg.Any<string>());
+        }
+
+        [Test]
+        public void BreakpointCreateByLocations()
+        {
+            var locations = new List<SourceLine>
+            {
+                new SourceLine(TEST_FILENAME, 10),
+                new SourceLine(TEST_FILENAME, 20),
+            };
+            mockBreakpoint.GetId().Returns(EXPECTED_ID);
+            mockTarget.BreakpointCreateByLocations(locations)
+                .Returns(new List<SbBreakpoint> { null, mockBreakpoint });
+
+            List<RemoteBreakpoint> breakpoints = remoteTarget.BreakpointCreateByLocations(locations);
+
+            Assert.AreEqual(2, breakpoints.Count);
+            Assert.IsNull(breakpoints[0]);
+            Assert.AreEqual(EXPECTED_ID, breakpoints[1].GetId());
         }
 
         [Test]
@@ -607,20 +611,14 @@ namespace DebuggerGrpcServer.Tests
             return breakpointLocations;
         }
 
-        List<SbInstruction> MockRead(uint instructionsToCreate, SbAddress startSbAddress,
-                                     SbMemoryRegionInfo memoryRegion,
-                                     ulong startAddress = TEST_ADDRESS, bool isMapped = true,
-                                     bool hasAddress = true, ulong regionEnd = ulong.MaxValue)
+        DisassemblyRecords MockRead(uint instructionsToCreate, SbAddress startSbAddress,
+                                    SbMemoryRegionInfo memoryRegion,
+                                    ulong startAddress = TEST_ADDRESS, bool isMapped = true,
+                                    ulong regionEnd = ulong.MaxValue)
         {
-            var instructions =
-                CreateMockInstructions(instructionsToCreate, startAddress, hasAddress);
-
-            ulong currentPage = startAddress / 4096;
-            ulong bytesToRead = (currentPage + 1) * 4096 - startAddress;
+            var records = CreateRecords(instructionsToCreate, startAddress);
 
-            mockTarget
-                .GetInstructionsWithFlavor(startSbAddress, Arg.Any<byte[]>(), bytesToRead, "intel")
-                .Returns(instructions);
+            mockTarget.DisassembleRange(startAddress, Arg.Any<uint>(), "intel").Returns(records);
 
             startSbAddress.GetLoadAddress(mockTarget).Returns(startAddress);
             mockTarget.ResolveLoadAddress(startAddress).Returns(startSbAddress);
@@ -638,46 +636,41 @@ namespace DebuggerGrpcServer.Tests
                 return mockError;
             });
 
-            var anyError = Arg.Any<SbError>();
-            mockProcess.ReadMemory(default, default, default, out anyError)
-                .ReturnsForAnyArgs((x =>
-                {
-                    var bufferArg = (byte[])x[1];
-                    int length = bufferArg?.Length ?? 0;
-                    x[3] = mockError;
-                    return (ulong)length;
-                }));
-
-            return instructions;
+            return records;
         }
 
-        List<SbInstruction> CreateMockInstructions(uint count, ulong startAddress = TEST_ADDRESS,
-                                                   bool hasAddress = true)
+        DisassemblyRecords CreateRecords(uint count, ulong startAddress = TEST_ADDRESS)
         {
-            var instructions = new List<SbInstruction>();
+            var records = new DisassemblyRecords
+            {
+                Instructions = new List<InstructionRecord>(),
+                LineEntries = new List<LineEntryRecord>(),
+                Symbols = new List<SymbolRecord>()
+            };
             for (uint i = 0; i < count; i++)
             {
-                SbAddress mockSbAddress = null;
-                if (hasAddress)
+                records.Instructions.Add(new InstructionRecord
                 {
-                    mockSbAddress = Substitute.For<SbAddress>();
-                    mockSbAddress
-                        .GetLoadAddress(mockTarget)
-                        .Returns(startAddress + i);
-                    mockSbAddress.GetSymbol().Returns((SbSymbol)null);
-                    mockSbAddress.GetLineEntry().Returns((SbLineEntry)null);
-                }
-
-                var mockInstruction = Substitute.For<SbInstruction>();
-                mockInstruction.GetAddress().Returns(mockSbAddress);
-                mockInstruction.GetMnemonic(mockTarget).Returns(TEST_MNEMONIC + i);
-                mockInstruction.GetOperands(mockTarget).Returns(TEST_OPERANDS + i);
-                mockInstruction.GetComment(mockTarget).Returns(TEST_COMMENT);
-                mockInstruction.GetByteSize().Returns(1u);
-
-                instructions.Add(mockInstruction);
+                    Address = startAddress + i,
+                    Size = 1,
+                    Bytes = new byte[] { 0x90 },
+                    Mnemonic = TEST_MNEMONIC + i,
+                    Operands = TEST_OPERANDS + i,
+                    Comment = TEST_COMMENT,
+                    LineEntryIndex = -1,
+                    SymbolIndex = -1
+                });
             }
-            return instructions;
+            return records;
+        }
+
+        void AddSymbol(DisassemblyRecords records, int index, ulong startAddress)
+        {
+            records.Symbols.Add(new SymbolRecord { Name = TEST_SYMBOL,
+                                                   StartAddress = startAddress });
+            InstructionRecord record = records.Instructions[index];
+            record.SymbolIndex = records.Symbols.Count - 1;
+            records.Instructions[index] = record;
         }
     }
 }
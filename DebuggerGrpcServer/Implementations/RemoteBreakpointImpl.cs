@@ -64,6 +64,16 @@ namespace DebuggerGrpcServer
         public void SetCommandLineCommands(IEnumerable<string> commands) =>
             sbBreakpoint.SetCommandLineCommands(commands.ToList());
 
+        public void SetTracepoint(IEnumerable<TraceItem> items, uint capacity) =>
+            sbBreakpoint.SetTracepoint(items.ToList(), capacity);
+
+        public void ClearTracepoint() => sbBreakpoint.ClearTracepoint();
+
+        public List<TraceRecord> DrainTrace(uint maxRecords, out ulong droppedCount) =>
+            sbBreakpoint.DrainTrace(maxRecords, out droppedCount);
+
+        public SbError ExportTrace(string path) => sbBreakpoint.ExportTrace(path);
+
         public SbBreakpoint GetSbBreakpoint() => sbBreakpoint;
 
         #endregion
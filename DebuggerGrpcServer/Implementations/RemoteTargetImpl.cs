@@ -40,7 +40,6 @@ namespace DebuggerGrpcServer
     class RemoteTargetImpl : RemoteTarget
     {
         const ulong _pageSize = 4096;
-        const ulong _maxOpcodeSize = 15;
         readonly SbTarget _sbTarget;
         readonly RemoteBreakpointFactory _breakpointFactory;
 
@@ -58,9 +57,17 @@ namespace DebuggerGrpcServer
         public RemoteBreakpoint BreakpointCreateByLocation(string file, uint line) =>
             _breakpointFactory.Create(_sbTarget.BreakpointCreateByLocation(file, line));
 
+        public List<RemoteBreakpoint> BreakpointCreateByLocations(List<SourceLine> locations) =>
+            _sbTarget.BreakpointCreateByLocations(locations)
+                .Select(_breakpointFactory.Create)
+                .ToList();
+
         public RemoteBreakpoint BreakpointCreateByName(string symbolName) =>
             _breakpointFactory.Create(_sbTarget.BreakpointCreateByName(symbolName));
 
+        public List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches) =>
+            _sbTarget.FindFunctionsMatching(pattern, maxMatches);
+
         public RemoteBreakpoint BreakpointCreateByAddress(ulong address) =>
             _breakpointFactory.Create(_sbTarget.BreakpointCreateByAddress(address));
 
@@ -73,6 +80,8 @@ namespace DebuggerGrpcServer
 
         public SbModule GetModuleAtIndex(int index) => _sbTarget.GetModuleAtIndex(index);
 
+        public List<ModuleSnapshot> GetModuleSnapshot() => _sbTarget.GetModuleSnapshot();
+
         public long GetId() => _sbTarget.GetId();
 
         public SbWatchpoint WatchAddress(long address, ulong size, bool read, bool write,
@@ -98,6 +107,9 @@ namespace DebuggerGrpcServer
         public SbError SetModuleLoadAddress(SbModule module, long sectionsOffset) =>
             _sbTarget.SetModuleLoadAddress(module, sectionsOffset);
 
+        public SbError AddSymbolFile(SbModule module, string symbolFilePath) =>
+            _sbTarget.AddSymbolFile(module, symbolFilePath);
+
         public SbTarget GetSbTarget() => _sbTarget;
 
         public List<InstructionInfo> ReadInstructionInfos(SbAddress address, uint count,
@@ -105,10 +117,10 @@ namespace DebuggerGrpcServer
         {
             SbProcess process = _sbTarget.GetProcess();
             var instructions = new List<InstructionInfo>();
+            ulong currentAddress = address.GetLoadAddress(_sbTarget);
             long lastPageChecked = -1;
             while (instructions.Count < count)
             {
-                ulong currentAddress = address.GetLoadAddress(_sbTarget);
                 ulong currentPage = currentAddress / _pageSize;
 
                 if (lastPageChecked != (long)currentPage)
@@ -130,83 +142,53 @@ namespace DebuggerGrpcServer
                     {
                         uint instructionsLeft = count - (uint)instructions.Count;
 
-                        ulong nextAddress = AddUnmappedInstructions(address, instructionsLeft,
-                                                                    memoryRegion, instructions);
-
-                        address = _sbTarget.ResolveLoadAddress(nextAddress);
+                        currentAddress = AddUnmappedInstructions(currentAddress, instructionsLeft,
+                                                                 memoryRegion, instructions);
 
                         // Continue in case we still need more instructions
                         continue;
                     }
                 }
 
-                ulong nextPage = currentPage + 1;
-                ulong endPageAddress = nextPage * _pageSize - 1;
-
-                ulong size = endPageAddress - currentAddress + 1;
-                var buffer = new byte[size];
-
-                ulong readSize = _sbTarget.GetProcess().ReadMemory(currentAddress, buffer, size,
-                                                                   out SbError readMemoryError);
-
-                if (readMemoryError.Fail() && readSize == 0)
-                {
-                    Trace.WriteLine("Unable to read mapped region");
-                    return new List<InstructionInfo>();
-                }
-
-                List<SbInstruction> sbInstructions =
-                    _sbTarget.GetInstructionsWithFlavor(address, buffer, readSize, flavor);
-
                 int missingInstructions = (int)count - instructions.Count;
-                foreach (SbInstruction sbInstruction in sbInstructions.Take(missingInstructions))
-                {
-                    var instruction = PrepareInstruction(sbInstruction);
-                    // Unexpected error occured, PrepareInstruction should write a log.
-                    if (instruction == null)
-                    {
-                        return  new List<InstructionInfo>();
-                    }
+                DisassemblyRecords records =
+                    _sbTarget.DisassembleRange(currentAddress, (uint)missingInstructions, flavor);
 
-                    instructions.Add(instruction);
-                }
-
-                // Let's check if there is an instruction that is split between two pages.
-                if (instructions.Count < count)
+                // The bytes at |currentAddress| couldn't be read or decoded. Add an invalid
+                // instruction, we represent them with setting both the operands and mnemonic
+                // to question marks.
+                if (records.Instructions.Count == 0)
                 {
-                    bool hasBoundaryInstruction = ReadInstructionOnPageBound(
-                        address, sbInstructions, instructions, endPageAddress, flavor,
-                        out InstructionInfo instruction, out ulong nextInstruction);
-                    if (hasBoundaryInstruction)
+                    instructions.Add(new InstructionInfo
                     {
-                        if (instruction == null)
-                        {
-                            return new List<InstructionInfo>();
-                        }
-
-                        instructions.Add(instruction);
-
-                        address = _sbTarget.ResolveLoadAddress(nextInstruction);
-                        if (instructions.Count < count)
-                        {
-                            continue;
-                        }
-                    }
-
+                        Address = currentAddress, Operands = "??",
+                        Mnemonic = "??"
+                    });
+                    currentAddress++;
+                    continue;
                 }
 
-                if (instructions.Count < count)
+                foreach (InstructionRecord record in records.Instructions.Take(
+                             missingInstructions))
                 {
-                    ulong nextAddress = AddInvalidInstruction(address, sbInstructions, instructions,
-                                                              endPageAddress + 1);
-
-                    // Set the address to the next address after the invalid instruction
-                    address = _sbTarget.ResolveLoadAddress(nextAddress);
+                    instructions.Add(PrepareInstruction(record, records));
+                    currentAddress = record.Address + record.Size;
                 }
             }
             return instructions;
         }
 
+        public List<LineEntryInfo> ResolveLineEntries(List<ulong> loadAddresses) =>
+            _sbTarget.ResolveLineEntries(loadAddresses)
+                .Select(record => record.FileName == null ? null : new LineEntryInfo
+                {
+                    FileName = record.FileName,
+                    Directory = record.Directory,
+                    Line = record.Line,
+                    Column = record.Column,
+                })
+                .ToList();
+
         public BreakpointErrorPair CreateFunctionOffsetBreakpoint(string symbolName, uint offset)
         {
             RemoteBreakpoint functionBreakpoint = BreakpointCreateByName(symbolName);
@@ -260,97 +242,52 @@ namespace DebuggerGrpcServer
         public SbBroadcaster GetBroadcaster() => _sbTarget.GetBroadcaster();
 
         public Tuple<SbType, SbError> CompileExpression(SbType scope, string expression,
-                                                        IDictionary<string, SbType> contextArgs) =>
-            LldbEval.CompileExpression(_sbTarget, scope, expression, contextArgs);
-
-#endregion
-
-#region RemoteTarget Helpers
-
-        /// <summary>
-        /// This method tries to figure out whether we have an instruction on the page boundary.
-        /// It tries to read one instruction right after the last used address if it is on the
-        /// current page. If it reads the instruction and its start and end addresses are on
-        /// different pages, this method will return true and initialize newInstruction and
-        /// nextInstruction parameters. Otherwise, the method returns false.
-        /// </summary>
-        bool ReadInstructionOnPageBound(SbAddress address, List<SbInstruction> sbInstructions,
-                                        List<InstructionInfo> instructions, ulong endPageAddress,
-                                        string flavor, out InstructionInfo newInstruction,
-                                        out ulong nextInstruction)
+                                                        IDictionary<string, SbType> contextArgs)
         {
-            ulong nextInstructionAddress =
-                GetNextInstructionAddress(address, sbInstructions, instructions);
-
-            // Let's check if there is a possibility that the instruction is split between pages.
-            // Its address should still be on the current page, but it's end address, which we
-            // estimate using max possible instruction size, should be on the next page.
-            if (nextInstructionAddress <= endPageAddress &&
-                nextInstructionAddress + _maxOpcodeSize > endPageAddress)
+            Tuple<SbType, SbError> result = LldbEval.CompileExpression(
+                _sbTarget, scope, expression, contextArgs, out long handle);
+            // The handle isn't needed. The compiled expression stays cached after it is
+            // released, and NatVis evaluations of the expression in the same scope reuse it.
+            if (handle != 0)
             {
-                var boundaryInstruction = _sbTarget.ReadInstructions(
-                    _sbTarget.ResolveLoadAddress(nextInstructionAddress), 1, flavor);
-                if (boundaryInstruction.Count == 1)
-                {
-                    ulong startAddress = boundaryInstruction[0].GetAddress()
-                        .GetLoadAddress(_sbTarget);
-                    ulong endAddress = startAddress + boundaryInstruction[0].GetByteSize() - 1;
-                    if (startAddress / _pageSize != endAddress / _pageSize)
-                    {
-                        newInstruction = PrepareInstruction(boundaryInstruction[0]);
-                        nextInstruction = endAddress + 1;
-                        return true;
-                    }
-                }
+                LldbEval.ReleaseCompiledExpression(handle);
             }
-
-            nextInstruction = 0;
-            newInstruction = null;
-            return false;
+            return result;
         }
 
-        InstructionInfo PrepareInstruction(SbInstruction sbInstruction)
-        {
-            SbAddress sbAddress = sbInstruction.GetAddress();
-            if (sbAddress == null)
-            {
-                // It should never happen that we cannot get an address for an instruction
-                Trace.WriteLine("Unable to retrieve address.");
-                return null;
-            }
-
-            ulong instructionAddress = sbAddress.GetLoadAddress(_sbTarget);
+#endregion
 
-            SbSymbol symbol = sbAddress.GetSymbol();
+#region RemoteTarget Helpers
 
+        InstructionInfo PrepareInstruction(InstructionRecord record, DisassemblyRecords records)
+        {
             string symbolName = null;
             // Only set symbolName if it is the start of a function
-            SbAddress startAddress = symbol?.GetStartAddress();
-            if (startAddress != null &&
-                startAddress.GetLoadAddress(_sbTarget) == instructionAddress)
+            if (record.SymbolIndex >= 0 &&
+                records.Symbols[record.SymbolIndex].StartAddress == record.Address)
             {
-                symbolName = symbol.GetName();
+                symbolName = records.Symbols[record.SymbolIndex].Name;
             }
 
-            SbLineEntry lineEntry = sbAddress.GetLineEntry();
             LineEntryInfo lineEntryInfo = null;
-            if (lineEntry != null)
+            if (record.LineEntryIndex >= 0)
             {
+                LineEntryRecord lineEntry = records.LineEntries[record.LineEntryIndex];
                 lineEntryInfo = new LineEntryInfo
                 {
-                    FileName = lineEntry.GetFileName(),
-                    Directory = lineEntry.GetDirectory(),
-                    Line = lineEntry.GetLine(),
-                    Column = lineEntry.GetColumn(),
+                    FileName = lineEntry.FileName,
+                    Directory = lineEntry.Directory,
+                    Line = lineEntry.Line,
+                    Column = lineEntry.Column,
                 };
             }
 
             return new InstructionInfo
             {
-                Address = instructionAddress,
-                Operands = sbInstruction.GetOperands(_sbTarget),
-                Comment = sbInstruction.GetComment(_sbTarget),
-                Mnemonic = sbInstruction.GetMnemonic(_sbTarget),
+                Address = record.Address,
+                Operands = record.Operands,
+                Comment = record.Comment,
+                Mnemonic = record.Mnemonic,
                 SymbolName = symbolName,
                 LineEntry = lineEntryInfo,
             };
@@ -360,7 +297,7 @@ namespace DebuggerGrpcServer
         /// Creates unknown/invalid instructions for an unmapped region.
         /// </summary>
         /// <returns> The address of the next instruction. </returns>
-        ulong AddUnmappedInstructions(SbAddress address, uint instructionsLeft,
+        ulong AddUnmappedInstructions(ulong startAddress, uint instructionsLeft,
                                       SbMemoryRegionInfo memoryRegion,
                                       List<InstructionInfo> instructions)
         {
@@ -369,7 +306,6 @@ namespace DebuggerGrpcServer
             // invalid/unknown instructions before checking again.
             ulong memoryRegionEndAddress = memoryRegion.GetRegionEnd();
 
-            ulong startAddress = address.GetLoadAddress(_sbTarget);
             ulong endAddress = Math.Min(memoryRegionEndAddress, startAddress + instructionsLeft);
 
             for (ulong currentAddress = startAddress; currentAddress < endAddress; currentAddress++)
@@ -383,59 +319,6 @@ namespace DebuggerGrpcServer
             return endAddress;
         }
 
-        /// <summary>
-        /// Figures out the address of the next instruction and adds it as an invalid instruction
-        /// to |instructions| if the last instruction is not on the memory region boundary.
-        /// </summary>
-        /// <returns> The address after the invalid instruction. </returns>
-        ulong AddInvalidInstruction(SbAddress address, List<SbInstruction> sbInstructions,
-                                    List<InstructionInfo> instructions, ulong nextPage)
-        {
-            ulong instructionAddress =
-                GetNextInstructionAddress(address, sbInstructions, instructions);
-
-            // Don't add invalid instruction if we stopped adding instructions because we
-            // reached the end of the page.
-            if (instructionAddress == nextPage)
-            {
-                return nextPage;
-            }
-
-            // Add the invalid instruction, we represent them with setting both the
-            // operands and mnemonic to question marks
-            instructions.Add(new InstructionInfo
-            {
-                Address = instructionAddress, Operands = "??",
-                Mnemonic = "??"
-            });
-
-            return instructionAddress + 1;
-        }
-
-        ulong GetNextInstructionAddress(SbAddress address, List<SbInstruction> sbInstructions,
-                                        List<InstructionInfo> instructions)
-        {
-            if (sbInstructions.Count > 0)
-            {
-                // The address of the next instruction should be the address
-                // of the last instruction + its byte size.
-                SbInstruction lastInstruction = sbInstructions[sbInstructions.Count - 1];
-                return lastInstruction.GetAddress().GetLoadAddress(_sbTarget) +
-                    lastInstruction.GetByteSize();
-            }
-
-            // If we haven't got any instructions yet we use the starting address
-            if (instructions.Count == 0)
-            {
-                return address.GetLoadAddress(_sbTarget);
-            }
-            // If we got no new instructions and we already have some instructions,
-            // use the address of the last instruction + 1 since the last instruction
-            // must have been invalid and therefore the byte size is one.
-
-            return instructions[instructions.Count - 1].Address + 1;
-        }
-
         #endregion
     }
 }
\ No newline at end of file
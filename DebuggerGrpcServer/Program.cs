@@ -42,6 +42,7 @@ using System.Diagnostics;
 using YetiVSI.DebugEngine;
 using System.Linq;
 using System.Threading.Tasks;
+using YetiCommon;
 
 namespace DebuggerGrpcServer
 {
@@ -100,6 +101,10 @@ namespace DebuggerGrpcServer
 
             var fileSpecFactory = new LLDBFileSpecFactory();
 
+            var targetApi = new LLDBTargetApi();
+            targetApi.SetSourceLineIndexCacheDirectory(SDKUtil.GetSourceLineIndexCachePath());
+            targetApi.SetSymbolSearchIndexCacheDirectory(SDKUtil.GetSymbolSearchIndexCachePath());
+
             var sbDebuggerRpc = new SbDebuggerRpcServiceImpl(targetManager,
                 commandInterpreterManager);
             var sbCommandInterpreterRpc = new SbCommandInterpreterRpcServiceImpl(
@@ -73,6 +73,26 @@ namespace DebuggerGrpcServer
         // </summary>
         void SetCommandLineCommands(IEnumerable<string> commands);
 
+        // <summary>
+        // Turn the breakpoint into a tracepoint that collects |items| without stopping.
+        // </summary>
+        void SetTracepoint(IEnumerable<TraceItem> items, uint capacity);
+
+        // <summary>
+        // Turn a tracepoint back into a regular breakpoint.
+        // </summary>
+        void ClearTracepoint();
+
+        // <summary>
+        // Remove and return up to |maxRecords| of the oldest trace records, 0 for all of them.
+        // </summary>
+        List<TraceRecord> DrainTrace(uint maxRecords, out ulong droppedCount);
+
+        // <summary>
+        // Drain all trace records and append them to the binary trace file at |path|.
+        // </summary>
+        SbError ExportTrace(string path);
+
         // <summary>
         // Returns the underlying SbBreakpoint
         // </summary>
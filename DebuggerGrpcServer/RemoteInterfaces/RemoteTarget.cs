@@ -44,11 +44,23 @@ namespace DebuggerGrpcServer
         // </summary>
         RemoteBreakpoint BreakpointCreateByLocation(string file, uint line);
 
+        // <summary>
+        // Set breakpoints at the specified file and line numbers. Returns one breakpoint per
+        // location, in order, or null for locations where no breakpoint could be created.
+        // </summary>
+        List<RemoteBreakpoint> BreakpointCreateByLocations(List<SourceLine> locations);
+
         // <summary>
         // Set breakpoints at all functions that match the specified symbol name.
         // </summary>
         RemoteBreakpoint BreakpointCreateByName(string symbolName);
 
+        // <summary>
+        // Find up to |maxMatches| functions whose names match the regular expression |pattern|.
+        // Returns null if |pattern| is invalid.
+        // </summary>
+        List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches);
+
         // <summary>
         // Set breakpoint at specified memory address.
         // </summary>
@@ -81,6 +93,11 @@ namespace DebuggerGrpcServer
         // </summary>
         SbModule GetModuleAtIndex(int index);
 
+        // <summary>
+        // Get a snapshot of every module in the module list, in module index order.
+        // </summary>
+        List<ModuleSnapshot> GetModuleSnapshot();
+
         // <summary>
         // A unique identifier for the listener.  Not part of the LLDB API.
         // </summary>
@@ -131,11 +148,23 @@ namespace DebuggerGrpcServer
         // </summary>
         SbError SetModuleLoadAddress(SbModule module, long sectionsOffset);
 
+        // <summary>
+        // Make the file at |symbolFilePath| the symbol file of |module|, like
+        // `target symbols add`. Symbol files of several modules can be added at once.
+        // </summary>
+        SbError AddSymbolFile(SbModule module, string symbolFilePath);
+
         // <summary>
         // Fetch all the information required for displaying disassembly in a single gRPC call.
         // </summary>
         List<InstructionInfo> ReadInstructionInfos(SbAddress address, uint count, string flavor);
 
+        // <summary>
+        // Resolves the line entries of |loadAddresses| with one call. Returns one entry per
+        // address, in order, null for addresses without a line entry.
+        // </summary>
+        List<LineEntryInfo> ResolveLineEntries(List<ulong> loadAddresses);
+
         // <summary>
         // Returns the underlying SbTarget
         // </summary>
@@ -14,10 +14,13 @@
 
 using Debugger.RemoteBreakpointRpc;
 using Debugger.Common;
+using Google.Protobuf;
 using Grpc.Core;
 using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.Linq;
 using System.Threading.Tasks;
+using YetiCommon;
 
 namespace DebuggerGrpcServer
 {
@@ -104,6 +107,67 @@ namespace DebuggerGrpcServer
             return Task.FromResult(new SetCommandLineCommandsResponse {});
         }
 
+        public override Task<SetTracepointResponse> SetTracepoint(
+            SetTracepointRequest request, ServerCallContext context)
+        {
+            var breakpoint = GetBreakpoint(_targetStore, request.Breakpoint);
+            breakpoint.SetTracepoint(
+                request.Items.Select(item => new LldbApi.TraceItem(
+                    item.Kind.ConvertTo<LldbApi.TraceItemKind>(), item.Expression, item.Size)),
+                request.Capacity);
+            return Task.FromResult(new SetTracepointResponse());
+        }
+
+        public override Task<ClearTracepointResponse> ClearTracepoint(
+            ClearTracepointRequest request, ServerCallContext context)
+        {
+            var breakpoint = GetBreakpoint(_targetStore, request.Breakpoint);
+            breakpoint.ClearTracepoint();
+            return Task.FromResult(new ClearTracepointResponse());
+        }
+
+        public override Task<DrainTraceResponse> DrainTrace(
+            DrainTraceRequest request, ServerCallContext context)
+        {
+            var breakpoint = GetBreakpoint(_targetStore, request.Breakpoint);
+            List<LldbApi.TraceRecord> records =
+                breakpoint.DrainTrace(request.MaxRecords, out ulong droppedCount);
+            var response = new DrainTraceResponse { DroppedCount = droppedCount };
+            foreach (LldbApi.TraceRecord record in records)
+            {
+                var grpcRecord = new TraceRecord
+                {
+                    Sequence = record.Sequence,
+                    TimestampNanoseconds = record.TimestampNanoseconds,
+                    ThreadId = record.ThreadId,
+                    Pc = record.Pc,
+                    LocationId = record.LocationId
+                };
+                grpcRecord.Values.Add(record.Values.Select(value => new TraceValue
+                {
+                    Valid = value != null,
+                    Data = value != null ? ByteString.CopyFrom(value) : ByteString.Empty
+                }));
+                response.Records.Add(grpcRecord);
+            }
+            return Task.FromResult(response);
+        }
+
+        public override Task<ExportTraceResponse> ExportTrace(
+            ExportTraceRequest request, ServerCallContext context)
+        {
+            var breakpoint = GetBreakpoint(_targetStore, request.Breakpoint);
+            LldbApi.SbError error = breakpoint.ExportTrace(request.Path);
+            return Task.FromResult(new ExportTraceResponse
+            {
+                Error = new GrpcSbError
+                {
+                    Success = error.Success(),
+                    Error = error.GetCString(),
+                }
+            });
+        }
+
         #endregion
 
         internal static RemoteBreakpoint GetBreakpoint(
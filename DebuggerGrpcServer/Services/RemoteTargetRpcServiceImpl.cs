@@ -21,6 +21,7 @@ using LldbApi;
 using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
+using System.Linq;
 using System.Threading.Tasks;
 
 namespace DebuggerGrpcServer
@@ -112,6 +113,48 @@ namespace DebuggerGrpcServer
             return Task.FromResult(response);
         }
 
+        public override Task<BreakpointCreateByLocationsResponse> BreakpointCreateByLocations(
+            BreakpointCreateByLocationsRequest request, ServerCallContext context)
+        {
+            if (!_targetStore.TryGetValue(request.Target.Id, out RemoteTarget target))
+            {
+                ErrorUtils.ThrowError(StatusCode.Internal,
+                                      "Could not find target in store: " + request.Target.Id);
+            }
+
+            List<RemoteBreakpoint> breakpoints = target.BreakpointCreateByLocations(
+                request.Locations.Select(l => new LldbApi.SourceLine(l.File, l.Line)).ToList());
+            var response = new BreakpointCreateByLocationsResponse();
+            foreach (RemoteBreakpoint breakpoint in breakpoints)
+            {
+                var created = new CreatedBreakpoint();
+                if (breakpoint != null)
+                {
+                    created.Breakpoint = new GrpcSbBreakpoint {
+                        Target = request.Target,
+                        Id = breakpoint.GetId(),
+                    };
+                    // Return the locations right away, this saves a round trip per location
+                    // when many breakpoints are restored at once.
+                    uint numLocations = breakpoint.GetNumLocations();
+                    for (uint i = 0; i < numLocations; i++)
+                    {
+                        SbBreakpointLocation location = breakpoint.GetLocationAtIndex(i);
+                        if (location != null)
+                        {
+                            created.Locations.Add(new GrpcSbBreakpointLocation
+                            {
+                                Id = location.GetId(),
+                                Breakpoint = created.Breakpoint,
+                            });
+                        }
+                    }
+                }
+                response.Breakpoints.Add(created);
+            }
+            return Task.FromResult(response);
+        }
+
         public override Task<BreakpointCreateByNameResponse> BreakpointCreateByName(
             BreakpointCreateByNameRequest request, ServerCallContext context)
         {
@@ -133,6 +176,32 @@ namespace DebuggerGrpcServer
             return Task.FromResult(response);
         }
 
+        public override Task<FindFunctionsMatchingResponse> FindFunctionsMatching(
+            FindFunctionsMatchingRequest request, ServerCallContext context)
+        {
+            if (!_targetStore.TryGetValue(request.Target.Id, out RemoteTarget target))
+            {
+                ErrorUtils.ThrowError(StatusCode.Internal,
+                                      "Could not find target in store: " + request.Target.Id);
+            }
+
+            var response = new FindFunctionsMatchingResponse();
+            List<FunctionMatch> matches =
+                target.FindFunctionsMatching(request.Pattern, request.MaxMatches);
+            if (matches == null)
+            {
+                response.InvalidPattern = true;
+                return Task.FromResult(response);
+            }
+            response.Matches.AddRange(matches.Select(match => new GrpcFunctionMatch {
+                Name = match.Name,
+                ModuleName = match.ModuleName,
+                FileAddress = match.FileAddress,
+                LoadAddress = match.LoadAddress,
+            }));
+            return Task.FromResult(response);
+        }
+
         public override Task<BreakpointCreateByAddressResponse> BreakpointCreateByAddress(
             BreakpointCreateByAddressRequest request, ServerCallContext context)
         {
@@ -222,6 +291,33 @@ namespace DebuggerGrpcServer
             return Task.FromResult(response);
         }
 
+        public override Task<GetModuleSnapshotResponse> GetModuleSnapshot(
+            GetModuleSnapshotRequest request, ServerCallContext context)
+        {
+            if (!_targetStore.TryGetValue(request.Target.Id, out RemoteTarget target))
+            {
+                ErrorUtils.ThrowError(StatusCode.Internal,
+                                      "Could not find target in store: " + request.Target.Id);
+            }
+
+            var response = new GetModuleSnapshotResponse();
+            response.Modules.AddRange(target.GetModuleSnapshot().Select(
+                module => new GrpcModuleSnapshot {
+                    PlatformPath = module.PlatformPath,
+                    SymbolPath = module.SymbolPath,
+                    Uuid = module.Uuid,
+                    Triple = module.Triple,
+                    CodeLoadAddress = module.CodeLoadAddress,
+                    CodeSize = module.CodeSize,
+                    HasSymbols = module.HasSymbols,
+                    HasCompileUnits = module.HasCompileUnits,
+                    Module = module.Module != null
+                        ? new GrpcSbModule { Id = _moduleStore.AddObject(module.Module) }
+                        : null,
+                }));
+            return Task.FromResult(response);
+        }
+
         public override Task<WatchAddressResponse> WatchAddress(WatchAddressRequest request,
                                                                 ServerCallContext context)
         {
@@ -326,6 +422,17 @@ namespace DebuggerGrpcServer
             return Task.FromResult(new SetModuleLoadAddressResponse { Error = grpcError });
         }
 
+        public override Task<AddSymbolFileResponse> AddSymbolFile(AddSymbolFileRequest request,
+                                                                  ServerCallContext context)
+        {
+            RemoteTarget target = GrpcLookupUtils.GetTarget(request.Target, _targetStore);
+            SbModule module = _moduleStore.GetObject(request.Module.Id);
+            SbError error = target.AddSymbolFile(module, request.SymbolFilePath);
+            var grpcError =
+                new GrpcSbError { Success = error.Success(), Error = error.GetCString() };
+            return Task.FromResult(new AddSymbolFileResponse { Error = grpcError });
+        }
+
         public override Task<ReadInstructionInfosResponse> ReadInstructionInfos(
             ReadInstructionInfosRequest request, ServerCallContext context)
         {
@@ -357,6 +464,28 @@ namespace DebuggerGrpcServer
             return Task.FromResult(response);
         }
 
+        public override Task<ResolveLineEntriesResponse> ResolveLineEntries(
+            ResolveLineEntriesRequest request, ServerCallContext context)
+        {
+            RemoteTarget target = GrpcLookupUtils.GetTarget(request.Target, _targetStore);
+            var response = new ResolveLineEntriesResponse();
+            foreach (LineEntryInfo lineEntry in target.ResolveLineEntries(
+                         request.LoadAddresses.ToList()))
+            {
+                var resolved = new ResolvedLineEntry();
+                if (lineEntry != null)
+                {
+                    resolved.LineEntry = new GrpcLineEntryInfo {
+                        FileName = lineEntry.FileName ?? "",
+                        Directory = lineEntry.Directory ?? "",
+                        Line = lineEntry.Line, Column = lineEntry.Column
+                    };
+                }
+                response.LineEntries.Add(resolved);
+            }
+            return Task.FromResult(response);
+        }
+
         public override Task<AddListenerResponse> AddListener(
             AddListenerRequest request, ServerCallContext context)
         {
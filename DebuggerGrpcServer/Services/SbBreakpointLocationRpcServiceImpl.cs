@@ -111,6 +111,20 @@ namespace DebuggerGrpcServer
             return Task.FromResult(new GetHitCountResponse { Result = result });
         }
 
+        public override Task<GetConditionStatsResponse> GetConditionStats(
+            GetConditionStatsRequest request, ServerCallContext context)
+        {
+            SbBreakpointLocation location = GetBreakpointLocation(request.BreakpointLocation);
+            BreakpointConditionStats stats = location.GetConditionStats();
+            return Task.FromResult(new GetConditionStatsResponse
+            {
+                HitCount = stats.HitCount,
+                TrueCount = stats.TrueCount,
+                TotalEvaluationNanoseconds = stats.TotalEvaluationNanoseconds,
+                MaxEvaluationNanoseconds = stats.MaxEvaluationNanoseconds
+            });
+        }
+
         #endregion
 
         private SbBreakpointLocation GetBreakpointLocation(
@@ -13,12 +13,14 @@
 // limitations under the License.
 
 using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.Threading.Tasks;
 using Debugger.Common;
 using Debugger.SbProcessRpc;
 using Google.Protobuf;
 using Grpc.Core;
 using LldbApi;
+using YetiCommon;
 
 namespace DebuggerGrpcServer
 {
@@ -216,13 +218,42 @@ namespace DebuggerGrpcServer
                 Size = sizeWrote
             });
         }
+
+        public override Task<WriteMemoryBatchResponse> WriteMemoryBatch(
+            WriteMemoryBatchRequest request, ServerCallContext context)
+        {
+            SbProcess sbProcess = GrpcLookupUtils.GetProcess(request.Process, _processStore);
+            var writes = new List<LldbApi.MemoryWrite>(request.Writes.Count);
+            foreach (Debugger.SbProcessRpc.MemoryWrite write in request.Writes)
+            {
+                writes.Add(new LldbApi.MemoryWrite(write.Address, write.Buffer.ToByteArray()));
+            }
+            var response = new WriteMemoryBatchResponse();
+            foreach (SbError error in sbProcess.WriteMemory(writes))
+            {
+                response.Errors.Add(new GrpcSbError
+                {
+                    Success = error.Success(),
+                    Error = error.GetCString()
+                });
+            }
+            return Task.FromResult(response);
+        }
 
 
         public override Task<SaveCoreResponse> SaveCore(
            SaveCoreRequest request, ServerCallContext context)
         {
             SbProcess sbProcess = GrpcLookupUtils.GetProcess(request.Process, _processStore);
-            SbError error = sbProcess.SaveCore(request.DumpPath);
+            var customRanges = new List<MemoryRange>();
+            foreach (GrpcAddressRange range in request.CustomRanges)
+            {
+                customRanges.Add(
+                    new MemoryRange(range.AddressMin, range.AddressMax - range.AddressMin));
+            }
+            SbError error = sbProcess.SaveCore(
+                request.DumpPath, request.Style.ConvertTo<LldbApi.SaveCoreStyle>(),
+                customRanges);
             return Task.FromResult(new SaveCoreResponse
             {
                 Error = new GrpcSbError
@@ -232,6 +263,19 @@ namespace DebuggerGrpcServer
                 },
             });
         }
+
+        public override Task<HandlePageWatchpointStopResponse> HandlePageWatchpointStop(
+            HandlePageWatchpointStopRequest request, ServerCallContext context)
+        {
+            SbProcess sbProcess = GrpcLookupUtils.GetProcess(request.Process, _processStore);
+            LldbApi.PageWatchpointStopResult result =
+                sbProcess.HandlePageWatchpointStop(out int watchpointId);
+            return Task.FromResult(new HandlePageWatchpointStopResponse
+            {
+                Result = result.ConvertTo<Debugger.SbProcessRpc.PageWatchpointStopResult>(),
+                WatchpointId = watchpointId
+            });
+        }
         #endregion
     }
 }
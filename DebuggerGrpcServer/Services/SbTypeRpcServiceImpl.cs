@@ -119,6 +119,32 @@ namespace DebuggerGrpcServer
             return Task.FromResult(new GetByteSizeResponse { ByteSize = type.GetByteSize() });
         }
 
+        public override Task<GetLayoutResponse> GetLayout(GetLayoutRequest request,
+                                                          ServerCallContext context)
+        {
+            SbType type = typeStore.GetObject(request.Type.Id);
+            TypeLayout layout = type.GetLayout();
+            var response = new GetLayoutResponse();
+            if (layout != null)
+            {
+                response.HasLayout = true;
+                response.ByteSize = layout.ByteSize;
+                response.HasVirtualBases = layout.HasVirtualBases;
+                response.Names.AddRange(layout.Names);
+                response.TypeNames.AddRange(layout.TypeNames);
+                foreach (TypeLayoutField field in layout.Fields)
+                {
+                    response.NameIds.Add(field.NameId);
+                    response.TypeIds.Add(field.TypeId);
+                    response.Offsets.Add(field.Offset);
+                    response.Sizes.Add(field.Size);
+                    response.BitfieldBitOffsets.Add(field.BitfieldBitOffset);
+                    response.BitfieldBitSizes.Add(field.BitfieldBitSize);
+                }
+            }
+            return Task.FromResult(response);
+        }
+
         #endregion
     }
 }
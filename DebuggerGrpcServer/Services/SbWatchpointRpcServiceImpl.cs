@@ -71,6 +71,20 @@ namespace DebuggerGrpcServer
             watchpoint.SetIgnoreCount(request.IgnoreCount);
             return Task.FromResult(new SetIgnoreCountResponse { });
         }
+
+        public override Task<GetStatsResponse> GetStats(GetStatsRequest request,
+            ServerCallContext context)
+        {
+            var watchpoint = watchpointStore.GetObject(request.Watchpoint.Id);
+            WatchpointStats stats = watchpoint.GetStats();
+            return Task.FromResult(new GetStatsResponse
+            {
+                HitCount = stats.HitCount,
+                FaultCount = stats.FaultCount,
+                FilteredFaultCount = stats.FilteredFaultCount,
+                TotalHandlingNanoseconds = stats.TotalHandlingNanoseconds
+            });
+        }
         #endregion
 
     }
@@ -0,0 +1,60 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Collections.Generic;
+
+namespace LldbApi
+{
+    /// <summary>
+    /// A disassembled instruction. Not part of the LLDB API.
+    /// </summary>
+    public struct InstructionRecord
+    {
+        public ulong Address;
+        public uint Size;
+        public byte[] Bytes;
+        public string Mnemonic;
+        public string Operands;
+        public string Comment;
+        // Indices into DisassemblyRecords.LineEntries and DisassemblyRecords.Symbols, -1 if
+        // the instruction has none.
+        public int LineEntryIndex;
+        public int SymbolIndex;
+    }
+
+    public struct LineEntryRecord
+    {
+        public string FileName;
+        public string Directory;
+        public uint Line;
+        public uint Column;
+    }
+
+    public struct SymbolRecord
+    {
+        public string Name;
+        public ulong StartAddress;
+    }
+
+    /// <summary>
+    /// Instructions returned by SbTarget.DisassembleRange. Line entries and symbols shared by
+    /// several instructions are stored once. Not part of the LLDB API.
+    /// </summary>
+    public class DisassemblyRecords
+    {
+        public List<InstructionRecord> Instructions;
+        public List<LineEntryRecord> LineEntries;
+        public List<SymbolRecord> Symbols;
+    }
+}
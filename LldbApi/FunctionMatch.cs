@@ -0,0 +1,29 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace LldbApi
+{
+    /// <summary>
+    /// A function found by SbTarget.FindFunctionsMatching. Not part of the LLDB API.
+    /// </summary>
+    public struct FunctionMatch
+    {
+        public string Name;
+        // Platform file name of the module that contains the function.
+        public string ModuleName;
+        public ulong FileAddress;
+        // ulong.MaxValue if the module isn't loaded.
+        public ulong LoadAddress;
+    }
+}
@@ -156,6 +156,24 @@ namespace LldbApi
         AutoContinueChanged = 1 << 12
     }
 
+    // Which parts of the process memory are written to a core dump. Mirrors
+    // lldb::SaveCoreStyle, with the addition of Custom for caller-provided ranges.
+    public enum SaveCoreStyle
+    {
+        StackOnly,
+        ModifiedPages, // Writable regions, or their dirty pages if known
+        Full,          // All readable regions
+        Custom,        // Stacks plus the ranges passed to SbProcess.SaveCore
+    }
+
+    // Result of SbProcess.HandlePageWatchpointStop. Not part of the LLDB API.
+    public enum PageWatchpointStopResult
+    {
+        NotHandled, // The stop is not caused by a page watchpoint
+        Resumed,    // The stop was handled internally and the process resumed
+        Hit,        // A page watchpoint was hit
+    }
+
     // LLDB defines and constants
     public static class LldbConstants
     {
@@ -0,0 +1,35 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace LldbApi
+{
+    /// <summary>
+    /// What the Modules window shows about a module, returned by SbTarget.GetModuleSnapshot.
+    /// Not part of the LLDB API.
+    /// </summary>
+    public struct ModuleSnapshot
+    {
+        // Null if the module at this index is invalid.
+        public SbModule Module;
+        public string PlatformPath;
+        // File the symbols were loaded from, empty if none.
+        public string SymbolPath;
+        public string Uuid;
+        public string Triple;
+        public ulong CodeLoadAddress;
+        public ulong CodeSize;
+        public bool HasSymbols;
+        public bool HasCompileUnits;
+    }
+}
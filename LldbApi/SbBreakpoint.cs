@@ -49,5 +49,19 @@ namespace LldbApi
 
         // Set the commands to be executed when the breakpoint is hit.
         void SetCommandLineCommands(List<string> commands);
+
+        // Turn the breakpoint into a tracepoint. Hits don't stop the process, instead |items|
+        // are collected into a buffer holding the latest |capacity| hits.
+        void SetTracepoint(List<TraceItem> items, uint capacity);
+
+        // Turn a tracepoint back into a regular breakpoint and drop its buffer.
+        void ClearTracepoint();
+
+        // Remove and return up to |maxRecords| of the oldest trace records, 0 for all of them.
+        // |droppedCount| is the number of records overwritten since the previous call.
+        List<TraceRecord> DrainTrace(uint maxRecords, out ulong droppedCount);
+
+        // Drain all trace records and append them to the binary trace file at |path|.
+        SbError ExportTrace(string path);
     }
 }
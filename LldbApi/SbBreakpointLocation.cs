@@ -40,5 +40,8 @@ namespace LldbApi
 
         // Get number of times the breakpoint location was already hit.
         uint GetHitCount();
+
+        // Get the hit and evaluation time counters of the condition set with SetCondition.
+        BreakpointConditionStats GetConditionStats();
     }
 }
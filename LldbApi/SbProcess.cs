@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+using System.Collections.Generic;
+
 namespace LldbApi
 {
     /// <summary>
@@ -107,6 +109,15 @@ namespace LldbApi
         /// </summary>
         ulong WriteMemory(ulong address, byte[] buffer, ulong size, out SbError error);
 
+        /// <summary>
+        /// Performs |writes| in as few remote writes as possible. Adjacent and overlapping
+        /// writes are merged, where later writes take precedence over earlier ones.
+        /// </summary>
+        /// <returns>
+        /// One error object per write, in the order of |writes|.
+        /// </returns>
+        List<SbError> WriteMemory(List<MemoryWrite> writes);
+
         /// <summary>
         /// Queries |address| and stores the details of the memory region that contains it
         /// in |memoryRegion|.
@@ -118,11 +129,24 @@ namespace LldbApi
         SbError GetMemoryRegionInfo(ulong address, out SbMemoryRegionInfo memoryRegion);
 
         /// <summary>
-        /// Saves dump of a current process to |file_name|.
+        /// Saves dump of a current process to |file_name|. |style| selects which memory is
+        /// written in addition to thread stacks. |customRanges| is only used with
+        /// SaveCoreStyle.Custom and may be null otherwise.
         /// </summary>
         /// <returns>
         /// An error object that describes any error that occurred during the process.
         /// </returns>
-        SbError SaveCore(string fileName);
+        SbError SaveCore(string fileName, SaveCoreStyle style, List<MemoryRange> customRanges);
+
+        /// <summary>
+        /// Handles the faults and single steps of watchpoints that are too large for the
+        /// debug registers. Must be called on every stop before it is reported. Not part of
+        /// the LLDB API.
+        /// </summary>
+        /// <returns>
+        /// Hit if such a watchpoint was hit, in which case |watchpointId| is its ID and the
+        /// thread that hit it is selected. Resumed if the stop should be ignored.
+        /// </returns>
+        PageWatchpointStopResult HandlePageWatchpointStop(out int watchpointId);
     }
 }
@@ -31,11 +31,25 @@ namespace LldbApi
         /// </summary>
         SbBreakpoint BreakpointCreateByLocation(string file, uint line);
 
+        /// <summary>
+        /// Set breakpoints at the specified file and line numbers. Returns one breakpoint per
+        /// location, in order, or null for locations where no breakpoint could be created.
+        /// </summary>
+        List<SbBreakpoint> BreakpointCreateByLocations(List<SourceLine> locations);
+
         /// <summary>
         /// Set breakpoints at all functions that match the specified symbol name.
         /// </summary>
         SbBreakpoint BreakpointCreateByName(string symbolName);
 
+        /// <summary>
+        /// Finds up to |maxMatches| functions whose names match the regular expression
+        /// |pattern|, in module and symbol order. A pattern without metacharacters matches
+        /// names that contain it. Candidates are looked up in per-module trigram indexes of the
+        /// symbol names. Returns null if |pattern| is invalid. Not part of the LLDB API.
+        /// </summary>
+        List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches);
+
         /// <summary>
         /// Set a breakpoint at the specified memory address.
         /// </summary>
@@ -62,6 +76,12 @@ namespace LldbApi
         /// </summary>
         SbModule GetModuleAtIndex(int index);
 
+        /// <summary>
+        /// Get a snapshot of every module in the module list, in module index order, with one
+        /// call. Not part of the LLDB API.
+        /// </summary>
+        List<ModuleSnapshot> GetModuleSnapshot();
+
         /// <summary>
         /// A unique identifier for the listener.  Not part of the LLDB API.
         /// </summary>
@@ -95,6 +115,21 @@ namespace LldbApi
         List<SbInstruction> GetInstructionsWithFlavor(SbAddress baseAddress, byte[] buffer,
                                                       ulong size, string flavor);
 
+        /// <summary>
+        /// Disassembles up to |count| instructions starting at the load address |address|,
+        /// including their text, line entries and symbols. Stops early at memory that can't
+        /// be read or decoded. Whole functions are disassembled and cached, so scrolling
+        /// through a function only disassembles it once. Not part of the LLDB API.
+        /// </summary>
+        DisassemblyRecords DisassembleRange(ulong address, uint count, string flavor);
+
+        /// <summary>
+        /// Resolves the line entries of |loadAddresses| with one call, using a flat address to
+        /// line table built once per module. Returns one record per address, in order. The
+        /// FileName of addresses without a line entry is null. Not part of the LLDB API.
+        /// </summary>
+        List<LineEntryRecord> ResolveLineEntries(List<ulong> loadAddresses);
+
         /// <summary>
         /// Load a core dump file.
         /// </summary>
@@ -118,6 +153,14 @@ namespace LldbApi
         /// </summary>
         SbError SetModuleLoadAddress(SbModule module, long sectionsOffset);
 
+        /// <summary>
+        /// Make the file at |symbolFilePath| the symbol file of |module|, like
+        /// `target symbols add`. Unlike the command, this doesn't hold the target's API mutex
+        /// while the symbol file is parsed, so symbol files of several modules can be added at
+        /// once.
+        /// </summary>
+        SbError AddSymbolFile(SbModule module, string symbolFilePath);
+
         /// <summary>
         /// Gets the process corresponding to the target.
         /// </summary>
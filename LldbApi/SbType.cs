@@ -93,5 +93,12 @@ namespace LldbApi
         /// Returns byte size of the type.
         /// </summary>
         ulong GetByteSize();
+
+        /// <summary>
+        /// Returns the offsets and sizes of the data members of the type, including those of its
+        /// base classes. Layouts are cached, so repeated calls for the same type are cheap.
+        /// Returns null for unnamed types. Not part of the LLDB API.
+        /// </summary>
+        TypeLayout GetLayout();
     }
 }
\ No newline at end of file
@@ -31,5 +31,8 @@ namespace LldbApi
 
         // Set the breakpoint to ignore the next |ignoreCount| hits.
         void SetIgnoreCount(uint ignoreCount);
+
+        // Get the hit and fault counters of the watchpoint. Not part of the LLDB API.
+        WatchpointStats GetStats();
     }
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace LldbApi
+{
+    public enum TraceItemKind
+    {
+        // Value of the register named by the expression.
+        Register,
+        // Value of the expression, evaluated with lldb-eval.
+        Expression,
+        // Size bytes of memory at the address the expression evaluates to.
+        Memory,
+    }
+
+    /// <summary>
+    /// A value collected on every hit of a tracepoint. Not part of the LLDB API.
+    /// </summary>
+    public struct TraceItem
+    {
+        public TraceItemKind Kind;
+        public string Expression;
+        // Bytes read for Memory items. For the other kinds, the maximum number of bytes kept,
+        // 0 for the default.
+        public uint Size;
+
+        public TraceItem(TraceItemKind kind, string expression, uint size)
+        {
+            Kind = kind;
+            Expression = expression;
+            Size = size;
+        }
+    }
+}
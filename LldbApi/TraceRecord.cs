@@ -0,0 +1,33 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System.Collections.Generic;
+
+namespace LldbApi
+{
+    /// <summary>
+    /// The values collected on one hit of a tracepoint. Not part of the LLDB API.
+    /// </summary>
+    public class TraceRecord
+    {
+        public ulong Sequence;
+        public ulong TimestampNanoseconds;
+        public ulong ThreadId;
+        public ulong Pc;
+        public int LocationId;
+        // Raw bytes of each trace item, null if the item couldn't be collected.
+        public List<byte[]> Values;
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Collections.Generic;
+
+namespace LldbApi
+{
+    /// <summary>
+    /// A data member in a TypeLayout. Not part of the LLDB API.
+    /// </summary>
+    public struct TypeLayoutField
+    {
+        // Index into TypeLayout.Names.
+        public uint NameId;
+        // Index into TypeLayout.TypeNames.
+        public uint TypeId;
+        // Byte offset from the start of the type the layout describes.
+        public ulong Offset;
+        public ulong Size;
+        // Position of a bitfield within the byte at Offset. Both are 0 for other fields.
+        public uint BitfieldBitOffset;
+        public uint BitfieldBitSize;
+    }
+
+    /// <summary>
+    /// The data members of a type and of its non-virtual base classes, returned by
+    /// SbType.GetLayout. Not part of the LLDB API.
+    /// </summary>
+    public class TypeLayout
+    {
+        public ulong ByteSize;
+        // True if the type or one of its bases has virtual bases. Their members are missing
+        // from Fields.
+        public bool HasVirtualBases;
+        public List<string> Names;
+        public List<string> TypeNames;
+        // Base class members come first. Members of anonymous structs and unions are listed
+        // as members of the enclosing type.
+        public List<TypeLayoutField> Fields;
+    }
+}
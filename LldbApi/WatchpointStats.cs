@@ -0,0 +1,31 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace LldbApi
+{
+    /// <summary>
+    /// Counters of a watchpoint. Only watchpoints that are too large for the debug registers
+    /// fault, for them the counters show the overhead of watching whole pages. Not part of
+    /// the LLDB API.
+    /// </summary>
+    public struct WatchpointStats
+    {
+        public uint HitCount;
+        // Faults caused by the protection of the watched pages.
+        public uint FaultCount;
+        // Faults on the watched pages that are outside of the watched range.
+        public uint FilteredFaultCount;
+        public ulong TotalHandlingNanoseconds;
+    }
+}
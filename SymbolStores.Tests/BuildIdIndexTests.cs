@@ -0,0 +1,131 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.IO;
+using System.IO.Abstractions.TestingHelpers;
+using NUnit.Framework;
+using YetiCommon;
+
+namespace SymbolStores.Tests
+{
+    [TestFixture]
+    class BuildIdIndexTests
+    {
+        const string _filepath = @"C:\store\test.debug";
+        static readonly BuildId _buildId = new BuildId("1234");
+
+        MockFileSystem _fakeFileSystem;
+        string _tempDirectory;
+        string _indexPath;
+
+        [SetUp]
+        public void SetUp()
+        {
+            _fakeFileSystem = new MockFileSystem();
+            _fakeFileSystem.AddFile(_filepath, new MockFileData(new byte[16]));
+            _tempDirectory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            _indexPath = Path.Combine(_tempDirectory, "BuildIdIndex.bin");
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Directory.Delete(_tempDirectory, true);
+        }
+
+        [Test]
+        public void IsVerified_AfterSetVerified()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                Assert.False(index.IsVerified(_filepath, _buildId, ModuleFormat.Elf));
+
+                index.SetVerified(_filepath, _buildId, ModuleFormat.Elf);
+
+                Assert.True(index.IsVerified(_filepath, _buildId, ModuleFormat.Elf));
+                Assert.False(index.IsVerified(_filepath, new BuildId("5678"), ModuleFormat.Elf));
+                Assert.False(index.IsVerified(_filepath, _buildId, ModuleFormat.Pdb));
+            }
+        }
+
+        [Test]
+        public void IsVerified_FileChanged()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                index.SetVerified(_filepath, _buildId, ModuleFormat.Elf);
+                _fakeFileSystem.AddFile(_filepath, new MockFileData(new byte[32]));
+
+                Assert.False(index.IsVerified(_filepath, _buildId, ModuleFormat.Elf));
+            }
+        }
+
+        [Test]
+        public void IsVerified_FileMissing()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                index.SetVerified(@"C:\missing\test.debug", _buildId, ModuleFormat.Elf);
+
+                Assert.False(
+                    index.IsVerified(@"C:\missing\test.debug", _buildId, ModuleFormat.Elf));
+            }
+        }
+
+        [Test]
+        public void Open_KeepsEntries()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                index.SetVerified(_filepath, _buildId, ModuleFormat.Elf);
+            }
+
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                Assert.True(index.IsVerified(_filepath, _buildId, ModuleFormat.Elf));
+            }
+        }
+
+        [Test]
+        public void Open_OtherCapacity_ClearsEntries()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                index.SetVerified(_filepath, _buildId, ModuleFormat.Elf);
+            }
+
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 32))
+            {
+                Assert.False(index.IsVerified(_filepath, _buildId, ModuleFormat.Elf));
+            }
+        }
+
+        [Test]
+        public void SetVerified_MoreFilesThanSlots()
+        {
+            using (var index = BuildIdIndex.Open(_fakeFileSystem, _indexPath, 16))
+            {
+                for (int i = 0; i < 64; ++i)
+                {
+                    string filepath = $@"C:\store\{i}.debug";
+                    _fakeFileSystem.AddFile(filepath, new MockFileData(new byte[i]));
+                    index.SetVerified(filepath, _buildId, ModuleFormat.Elf);
+                }
+
+                Assert.True(index.IsVerified(@"C:\store\63.debug", _buildId, ModuleFormat.Elf));
+            }
+        }
+    }
+}
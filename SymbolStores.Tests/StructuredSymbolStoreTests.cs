@@ -14,6 +14,7 @@
 
 using System;
 using System.IO;
+using System.IO.Abstractions.TestingHelpers;
 using System.Threading.Tasks;
 using NUnit.Framework;
 using YetiCommon;
@@ -67,6 +68,65 @@ namespace SymbolStores.Tests
                 exception.Message);
         }
 
+        [Test]
+        public async Task AddFile_OverMaxSize_EvictsLeastRecentlyAccessedFileAsync()
+        {
+            var store = new StructuredSymbolStore(_fakeFileSystem, _storePath, maxSize: 15);
+            var buildIdA = new BuildId("AAAA");
+            var buildIdB = new BuildId("BBBB");
+            _fakeFileSystem.AddFile(@"C:\sourceA", new MockFileData(new byte[10]));
+            _fakeFileSystem.AddFile(@"C:\sourceB", new MockFileData(new byte[10]));
+
+            IFileReference fileA = await store.AddFileAsync(
+                new FileReference(_fakeFileSystem, @"C:\sourceA"), _filename, buildIdA,
+                _elfFormat, _log);
+            _fakeFileSystem.File.SetLastAccessTimeUtc(fileA.Location,
+                                                      new DateTime(2000, 1, 1));
+            IFileReference fileB = await store.AddFileAsync(
+                new FileReference(_fakeFileSystem, @"C:\sourceB"), _filename, buildIdB,
+                _elfFormat, _log);
+
+            Assert.False(_fakeFileSystem.File.Exists(fileA.Location));
+            Assert.False(_fakeFileSystem.Directory.Exists(Path.GetDirectoryName(fileA.Location)));
+            Assert.True(_fakeFileSystem.File.Exists(fileB.Location));
+            StringAssert.Contains(Strings.EvictedFile(fileA.Location), _log.ToString());
+        }
+
+        [Test]
+        public async Task AddFile_OverMaxSize_KeepsFilesFoundSinceAsync()
+        {
+            var store = new StructuredSymbolStore(_fakeFileSystem, _storePath, maxSize: 25);
+            var buildIdA = new BuildId("AAAA");
+            _fakeFileSystem.AddFile(@"C:\source", new MockFileData(new byte[10]));
+            var source = new FileReference(_fakeFileSystem, @"C:\source");
+
+            IFileReference fileA =
+                await store.AddFileAsync(source, _filename, buildIdA, _elfFormat, _log);
+            IFileReference fileB = await store.AddFileAsync(
+                source, _filename, new BuildId("BBBB"), _elfFormat, _log);
+            await store.FindFileAsync(new ModuleSearchQuery(_filename, buildIdA, _elfFormat),
+                                      _log);
+            IFileReference fileC = await store.AddFileAsync(
+                source, _filename, new BuildId("CCCC"), _elfFormat, _log);
+
+            Assert.True(_fakeFileSystem.File.Exists(fileA.Location));
+            Assert.False(_fakeFileSystem.File.Exists(fileB.Location));
+            Assert.True(_fakeFileSystem.File.Exists(fileC.Location));
+        }
+
+        [Test]
+        public async Task AddFile_WithinMaxSize_KeepsFilesAsync()
+        {
+            var store = new StructuredSymbolStore(_fakeFileSystem, _storePath, maxSize: 1024);
+            IFileReference fileA = await store.AddFileAsync(
+                _sourceSymbolFile, _filename, new BuildId("AAAA"), _elfFormat, _log);
+            IFileReference fileB = await store.AddFileAsync(
+                _sourceSymbolFile, _filename, new BuildId("BBBB"), _elfFormat, _log);
+
+            Assert.True(_fakeFileSystem.File.Exists(fileA.Location));
+            Assert.True(_fakeFileSystem.File.Exists(fileB.Location));
+        }
+
         [Test]
         public void DeepEquals()
         {
@@ -184,6 +184,35 @@ namespace SymbolStores.Tests
                             fileReference.Location);
         }
 
+        [Test]
+        public async Task FindFile_BuildIdInIndex_SkipsParsingAsync()
+        {
+            var buildIdIndex = Substitute.For<IBuildIdIndex>();
+            buildIdIndex.IsVerified(Arg.Any<string>(), _buildId, _elfFormat).Returns(true);
+            _storeSequence = new SymbolStoreSequence(_moduleParser, buildIdIndex);
+            await _storeA.AddFileAsync(_sourceSymbolFile, _filename, _buildId, _elfFormat, _log);
+            _storeSequence.AddStore(_storeA);
+
+            var fileReference = await _storeSequence.FindFileAsync(_searchQuery, _log);
+
+            Assert.NotNull(fileReference);
+            _moduleParser.DidNotReceiveWithAnyArgs().ParseBuildIdInfo(default, default);
+            buildIdIndex.DidNotReceiveWithAnyArgs().SetVerified(default, default, default);
+        }
+
+        [Test]
+        public async Task FindFile_BuildIdMatches_AddsToIndexAsync()
+        {
+            var buildIdIndex = Substitute.For<IBuildIdIndex>();
+            _storeSequence = new SymbolStoreSequence(_moduleParser, buildIdIndex);
+            await _storeA.AddFileAsync(_sourceSymbolFile, _filename, _buildId, _elfFormat, _log);
+            _storeSequence.AddStore(_storeA);
+
+            var fileReference = await _storeSequence.FindFileAsync(_searchQuery, _log);
+
+            buildIdIndex.Received(1).SetVerified(fileReference.Location, _buildId, _elfFormat);
+        }
+
         [Test]
         public async Task FindFile_NoStoresAsync()
         {
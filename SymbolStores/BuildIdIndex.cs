@@ -0,0 +1,257 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Diagnostics;
+using System.IO;
+using System.IO.Abstractions;
+using System.IO.MemoryMappedFiles;
+using YetiCommon;
+
+namespace SymbolStores
+{
+    /// <summary>
+    /// Remembers the files whose build ID was verified, so they aren't parsed again while their
+    /// size and write time stay the same.
+    /// </summary>
+    public interface IBuildIdIndex
+    {
+        /// <summary>
+        /// Returns true if the file was recorded with the build ID and format, and its size and
+        /// write time haven't changed since.
+        /// </summary>
+        bool IsVerified(string filepath, BuildId buildId, ModuleFormat format);
+
+        /// <summary>
+        /// Records that the file has the build ID, along with its current size and write time.
+        /// </summary>
+        void SetVerified(string filepath, BuildId buildId, ModuleFormat format);
+    }
+
+    /// <summary>
+    /// IBuildIdIndex kept in a memory-mapped file, so it survives restarts. The file is a hash
+    /// table with a fixed number of slots. Each slot holds a hash of the path, build ID and
+    /// format, the file size and the write time. A lookup probes a few slots and stats the file.
+    /// When all probed slots are taken, the first one is replaced, so the index never grows.
+    /// Writes are only serialized within an instance. A slot torn by another process can at
+    /// worst hold the key of one file with the size and write time of another.
+    /// </summary>
+    public sealed class BuildIdIndex : IBuildIdIndex, IDisposable
+    {
+        public const int DefaultCapacity = 1 << 16;
+
+        const uint _magic = 0x58444942; // "BIDX"
+        const uint _version = 1;
+        const int _headerSize = 16;
+        const int _slotSize = 24;
+        const int _maxProbes = 16;
+
+        readonly IFileSystem _fileSystem;
+        readonly MemoryMappedFile _file;
+        readonly MemoryMappedViewAccessor _view;
+        readonly int _capacity;
+        readonly object _lock = new object();
+
+        BuildIdIndex(IFileSystem fileSystem, MemoryMappedFile file,
+                     MemoryMappedViewAccessor view, int capacity)
+        {
+            _fileSystem = fileSystem;
+            _file = file;
+            _view = view;
+            _capacity = capacity;
+        }
+
+        /// <summary>
+        /// Opens the index file at |path|, or creates it. An index with a different layout is
+        /// cleared. Files are stat'ed through |fileSystem|.
+        /// </summary>
+        /// <param name="capacity">Number of slots, a power of two.</param>
+        /// <returns>The index, or null if the file can't be opened.</returns>
+        public static BuildIdIndex Open(IFileSystem fileSystem, string path,
+                                        int capacity = DefaultCapacity)
+        {
+            Debug.Assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+            long size = _headerSize + (long)capacity * _slotSize;
+            MemoryMappedFile file = null;
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(path));
+                var fileInfo = new FileInfo(path);
+                if (fileInfo.Exists && fileInfo.Length != size)
+                {
+                    fileInfo.Delete();
+                }
+
+                // Shared, so that several debug sessions and Visual Studio instances can use
+                // the index at the same time.
+                var stream = new FileStream(path, FileMode.OpenOrCreate, FileAccess.ReadWrite,
+                                            FileShare.ReadWrite | FileShare.Delete);
+                try
+                {
+                    file = MemoryMappedFile.CreateFromFile(stream, null, size,
+                                                           MemoryMappedFileAccess.ReadWrite, null,
+                                                           HandleInheritability.None, false);
+                }
+                catch
+                {
+                    stream.Dispose();
+                    throw;
+                }
+
+                MemoryMappedViewAccessor view = file.CreateViewAccessor();
+                var index = new BuildIdIndex(fileSystem, file, view, capacity);
+                index.ClearIfInvalid();
+                return index;
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException ||
+                                      e is NotSupportedException || e is ArgumentException)
+            {
+                Trace.WriteLine($"Failed to open build ID index '{path}': {e.Message}");
+                file?.Dispose();
+                return null;
+            }
+        }
+
+        public bool IsVerified(string filepath, BuildId buildId, ModuleFormat format)
+        {
+            if (!TryGetFileState(filepath, out long length, out long lastWriteTicks))
+            {
+                return false;
+            }
+
+            ulong key = GetKey(filepath, buildId, format);
+            lock (_lock)
+            {
+                long slot = FindSlot(key, false);
+                return slot >= 0 && _view.ReadInt64(slot + 8) == length &&
+                    _view.ReadInt64(slot + 16) == lastWriteTicks;
+            }
+        }
+
+        public void SetVerified(string filepath, BuildId buildId, ModuleFormat format)
+        {
+            if (!TryGetFileState(filepath, out long length, out long lastWriteTicks))
+            {
+                return;
+            }
+
+            ulong key = GetKey(filepath, buildId, format);
+            lock (_lock)
+            {
+                long slot = FindSlot(key, true);
+                _view.Write(slot, key);
+                _view.Write(slot + 8, length);
+                _view.Write(slot + 16, lastWriteTicks);
+            }
+        }
+
+        public void Dispose()
+        {
+            _view.Dispose();
+            _file.Dispose();
+        }
+
+        /// <summary>
+        /// Returns the offset of the slot holding |key|. If there is none, returns the offset of
+        /// the first free probed slot (or of the first probed slot if all are taken) when
+        /// |forInsert| is set, and -1 otherwise.
+        /// </summary>
+        long FindSlot(ulong key, bool forInsert)
+        {
+            long freeSlot = -1;
+            for (int i = 0; i < _maxProbes; ++i)
+            {
+                long slot = GetSlotOffset((int)((key + (ulong)i) & (ulong)(_capacity - 1)));
+                ulong slotKey = _view.ReadUInt64(slot);
+                if (slotKey == key)
+                {
+                    return slot;
+                }
+
+                if (slotKey == 0 && freeSlot < 0)
+                {
+                    freeSlot = slot;
+                }
+            }
+
+            if (!forInsert)
+            {
+                return -1;
+            }
+
+            return freeSlot >= 0 ? freeSlot : GetSlotOffset((int)(key & (ulong)(_capacity - 1)));
+        }
+
+        long GetSlotOffset(int index) => _headerSize + (long)index * _slotSize;
+
+        void ClearIfInvalid()
+        {
+            if (_view.ReadUInt32(0) == _magic && _view.ReadUInt32(4) == _version &&
+                _view.ReadInt32(8) == _capacity)
+            {
+                return;
+            }
+
+            for (int i = 0; i < _capacity; ++i)
+            {
+                _view.Write(GetSlotOffset(i), 0UL);
+            }
+
+            _view.Write(0, _magic);
+            _view.Write(4, _version);
+            _view.Write(8, _capacity);
+            _view.Flush();
+        }
+
+        bool TryGetFileState(string filepath, out long length, out long lastWriteTicks)
+        {
+            length = 0;
+            lastWriteTicks = 0;
+            try
+            {
+                var fileInfo = _fileSystem.FileInfo.FromFileName(filepath);
+                if (!fileInfo.Exists)
+                {
+                    return false;
+                }
+
+                length = fileInfo.Length;
+                lastWriteTicks = fileInfo.LastWriteTimeUtc.Ticks;
+                return true;
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException ||
+                                      e is NotSupportedException || e is ArgumentException)
+            {
+                return false;
+            }
+        }
+
+        /// <summary>
+        /// 64-bit FNV-1a hash of the path, build ID and format. Paths are compared
+        /// case-insensitively, like on Windows. 0 marks a free slot, so it is never returned.
+        /// </summary>
+        static ulong GetKey(string filepath, BuildId buildId, ModuleFormat format)
+        {
+            string key = $"{filepath.ToLowerInvariant()}|{buildId}|{format}";
+            ulong hash = 14695981039346656037;
+            foreach (char c in key)
+            {
+                hash ^= c;
+                hash *= 1099511628211;
+            }
+
+            return hash == 0 ? 1 : hash;
+        }
+    }
+}
@@ -15,6 +15,7 @@
 ﻿using System;
 using System.IO;
 using System.IO.Abstractions;
+using System.Runtime.InteropServices;
 using System.Threading.Tasks;
 
 namespace SymbolStores
@@ -24,9 +25,14 @@ namespace SymbolStores
     {
         readonly IFileSystem fileSystem;
 
-        public FileReference(IFileSystem fileSystem, string filepath)
+        // True if the file is in a symbol store. Store files are never modified in place, so
+        // copies of them may be hard links.
+        readonly bool isInStore;
+
+        public FileReference(IFileSystem fileSystem, string filepath, bool isInStore = false)
         {
             this.fileSystem = fileSystem;
+            this.isInStore = isInStore;
             Location = filepath ?? throw new ArgumentNullException(nameof(filepath));
         }
 
@@ -60,6 +66,15 @@ namespace SymbolStores
                     fileSystem.Directory.CreateDirectory(destDirectory);
                 }
 
+                // Store files on the same volume are hard linked instead of copied, so a file
+                // that is in several stores is only stored once. Creating a link is atomic.
+                // Other files, e.g. build outputs, can be rewritten in place later, which
+                // would also change a linked copy, so they are always copied.
+                if (TryCreateHardLink(destFilepath))
+                {
+                    return Task.CompletedTask;
+                }
+
                 // Copy to a temp file and rename in order to avoid potentially leaving a
                 // half-copied file in the case of an event such as a power failure.
                 // TODO: Potentially consolidate the temp files in a hidden folder
@@ -85,5 +100,21 @@ namespace SymbolStores
         }
 
 #endregion
+
+        bool TryCreateHardLink(string destFilepath)
+        {
+            // Links can only be created on the real file system.
+            if (!isInStore || !(fileSystem is FileSystem))
+            {
+                return false;
+            }
+
+            return CreateHardLink(Path.GetFullPath(destFilepath), Path.GetFullPath(Location),
+                                  IntPtr.Zero);
+        }
+
+        [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+        static extern bool CreateHardLink(string lpFileName, string lpExistingFileName,
+                                          IntPtr lpSecurityAttributes);
     }
 }
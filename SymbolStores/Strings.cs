@@ -58,6 +58,15 @@ namespace SymbolStores
                                                            string message) =>
             $"Could not copy '{filename}' to symbol store '{path}'. {message}";
 
+        public static string EvictedFile(string filepath) =>
+            $"Deleted '{filepath}' to keep the symbol store within its size limit.";
+
+        public static string FailedToEvictFile(string filepath, string message) =>
+            $"Could not delete '{filepath}' from the symbol store. {message}";
+
+        public static string FailedToMarkAccessed(string filepath, string message) =>
+            $"Could not update the access time of '{filepath}'. {message}";
+
         public static string FailedToCopyToSymbolServer(string filename) =>
             $"Could not copy '{filename}' to any store in the symbol server.";
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.IO.Abstractions;
@@ -36,6 +37,9 @@ namespace SymbolStores
     /// structure "path/symbolFileName/buildId/symbolFile".
     /// A structured store can be disambiguated from a flat store by the existence of an empty
     /// marker file named "pingme.txt".
+    /// A store can be given a size budget. Files found in it are marked as accessed, and when
+    /// an added file takes the store over the budget, the least recently accessed files are
+    /// deleted.
     /// </summary>
     public class StructuredSymbolStore : SymbolStoreBase, IStructuredSymbolStore
     {
@@ -52,7 +56,27 @@ namespace SymbolStores
         [JsonProperty("Path")]
         readonly string _path;
 
-        public StructuredSymbolStore(IFileSystem fileSystem, string path, bool isCache = false)
+        // Size budget in bytes, or 0 if the store is unbounded.
+        readonly long _maxSize;
+
+        // Size and access order of a file in the store.
+        class IndexedFile
+        {
+            public long Size;
+            public long LastAccess;
+        }
+
+        // Sizes and access order of the files in a store with a budget, by full path. Loaded
+        // with one walk of the store on first use and kept up to date as files are found,
+        // added and evicted, so adding a file doesn't walk the store. Files added by other
+        // processes are only seen by instances created after them.
+        Dictionary<string, IndexedFile> _index;
+        long _indexedSize;
+        long _accessCount;
+        readonly object _indexLock = new object();
+
+        public StructuredSymbolStore(IFileSystem fileSystem, string path, bool isCache = false,
+                                     long maxSize = 0)
             : base(true, isCache)
         {
             if (string.IsNullOrEmpty(path))
@@ -63,6 +87,7 @@ namespace SymbolStores
 
             _fileSystem = fileSystem;
             _path = fileSystem.Path.GetFullPath(path);
+            _maxSize = maxSize;
         }
 
         public override Task<IFileReference> FindFileAsync(ModuleSearchQuery searchQuery,
@@ -92,7 +117,9 @@ namespace SymbolStores
             }
 
             log.WriteLineAndTrace(Strings.FileFound(filepath));
-            return Task.FromResult<IFileReference>(new FileReference(_fileSystem, filepath));
+            MarkAccessed(filepath);
+            return Task.FromResult<IFileReference>(
+                new FileReference(_fileSystem, filepath, isInStore: true));
         }
 
         public override async Task<IFileReference> AddFileAsync(IFileReference source,
@@ -132,8 +159,10 @@ namespace SymbolStores
                 await source.CopyToAsync(filepath);
 
                 log.WriteLineAndTrace(Strings.CopiedFile(filename, filepath));
+                MarkAccessed(filepath, isNew: true);
+                EvictFilesOverBudget(filepath, log);
 
-                return new FileReference(_fileSystem, filepath);
+                return new FileReference(_fileSystem, filepath, isInStore: true);
             }
             catch (Exception e) when (e is SymbolStoreException || e is IOException ||
                                       e is UnauthorizedAccessException ||
@@ -159,5 +188,136 @@ namespace SymbolStores
             _fileSystem.Directory.CreateDirectory(_path);
             _fileSystem.File.Create(markerFilePath).Close();
         }
+
+        // Updates the access time of |filepath| on disk, so the order outlives the index, and
+        // in the index. |isNew| is true if the file was just added.
+        void MarkAccessed(string filepath, bool isNew = false)
+        {
+            if (_maxSize <= 0)
+            {
+                return;
+            }
+
+            try
+            {
+                _fileSystem.File.SetLastAccessTimeUtc(filepath, DateTime.UtcNow);
+
+                lock (_indexLock)
+                {
+                    if (_index == null)
+                    {
+                        // The file is picked up when the index is loaded.
+                        return;
+                    }
+
+                    // Files that aren't indexed yet were added by another process.
+                    if (!_index.TryGetValue(filepath, out IndexedFile file) || isNew)
+                    {
+                        long size = _fileSystem.FileInfo.FromFileName(filepath).Length;
+                        if (file == null)
+                        {
+                            file = new IndexedFile();
+                            _index.Add(filepath, file);
+                        }
+
+                        _indexedSize += size - file.Size;
+                        file.Size = size;
+                    }
+
+                    file.LastAccess = ++_accessCount;
+                }
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Trace.WriteLine(Strings.FailedToMarkAccessed(filepath, e.Message));
+            }
+        }
+
+        // Walks the store once and orders its files by their access times on disk.
+        void LoadIndexIfNeeded()
+        {
+            if (_index != null)
+            {
+                return;
+            }
+
+            string markerFilePath = Path.Combine(_path, _markerFileName);
+            _index = new Dictionary<string, IndexedFile>(StringComparer.OrdinalIgnoreCase);
+            _indexedSize = 0;
+            foreach (FileInfoBase file in _fileSystem.DirectoryInfo.FromDirectoryName(_path)
+                         .GetFiles("*", SearchOption.AllDirectories)
+                         .Where(f => !string.Equals(f.FullName, markerFilePath,
+                                                    StringComparison.OrdinalIgnoreCase))
+                         .OrderBy(f => f.LastAccessTimeUtc))
+            {
+                _index[file.FullName] =
+                    new IndexedFile { Size = file.Length, LastAccess = ++_accessCount };
+                _indexedSize += file.Length;
+            }
+        }
+
+        /// <summary>
+        /// Deletes the least recently accessed files until the store fits in its budget.
+        /// |keepFilepath| is never deleted.
+        /// </summary>
+        void EvictFilesOverBudget(string keepFilepath, TextWriter log)
+        {
+            if (_maxSize <= 0)
+            {
+                return;
+            }
+
+            lock (_indexLock)
+            {
+                LoadIndexIfNeeded();
+                if (_indexedSize <= _maxSize)
+                {
+                    return;
+                }
+
+                foreach (KeyValuePair<string, IndexedFile> file in _index
+                             .OrderBy(f => f.Value.LastAccess)
+                             .ToList())
+                {
+                    if (_indexedSize <= _maxSize)
+                    {
+                        break;
+                    }
+
+                    if (string.Equals(file.Key, keepFilepath,
+                                      StringComparison.OrdinalIgnoreCase))
+                    {
+                        continue;
+                    }
+
+                    try
+                    {
+                        _fileSystem.File.Delete(file.Key);
+                        _index.Remove(file.Key);
+                        _indexedSize -= file.Value.Size;
+                        log.WriteLineAndTrace(Strings.EvictedFile(file.Key));
+                        DeleteEmptyDirectories(Path.GetDirectoryName(file.Key));
+                    }
+                    catch (Exception e) when (e is IOException ||
+                                              e is UnauthorizedAccessException)
+                    {
+                        Trace.WriteLine(Strings.FailedToEvictFile(file.Key, e.Message));
+                    }
+                }
+            }
+        }
+
+        // Deletes |directory| and its parents up to the store root while they are empty.
+        void DeleteEmptyDirectories(string directory)
+        {
+            while (!string.IsNullOrEmpty(directory) &&
+                   directory.StartsWith(_path, StringComparison.OrdinalIgnoreCase) &&
+                   directory.Length > _path.Length &&
+                   !_fileSystem.Directory.EnumerateFileSystemEntries(directory).Any())
+            {
+                _fileSystem.Directory.Delete(directory);
+                directory = Path.GetDirectoryName(directory);
+            }
+        }
     }
 }
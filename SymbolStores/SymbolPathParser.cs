@@ -49,6 +49,16 @@ namespace SymbolStores
         // any HTTP stores that would otherwise not be cached.
         readonly string _defaultCachePath;
 
+        // Size budget of the default cache in bytes, or 0 if it is unbounded.
+        readonly long _defaultCacheMaxSize;
+
+        // The default cache, shared by all parsed sequences so that its size index is only
+        // loaded once.
+        StructuredSymbolStore _defaultCache;
+
+        // Shared by the parsed store sequences. May be null.
+        readonly IBuildIdIndex _buildIdIndex;
+
         // Used to replace any empty symbol server path elements that are encountered.
         readonly string _defaultSymbolStorePath;
 
@@ -63,7 +73,8 @@ namespace SymbolStores
         public SymbolPathParser(IFileSystem fileSystem, IModuleParser moduleParser,
                                 HttpClient httpClient, ICrashReportClient crashReportClient,
                                 string defaultCachePath, string defaultSymbolStorePath,
-                                IEnumerable<string> hostExcludeList = null)
+                                IEnumerable<string> hostExcludeList = null,
+                                IBuildIdIndex buildIdIndex = null, long defaultCacheMaxSize = 0)
         {
             _fileSystem = fileSystem;
             _moduleParser = moduleParser;
@@ -71,6 +82,8 @@ namespace SymbolStores
             _crashReportClient = crashReportClient;
             _defaultCachePath = defaultCachePath;
             _defaultSymbolStorePath = defaultSymbolStorePath;
+            _buildIdIndex = buildIdIndex;
+            _defaultCacheMaxSize = defaultCacheMaxSize;
             _hostExcludeList = new HashSet<string>(
                 hostExcludeList ?? Enumerable.Empty<string>(), StringComparer.OrdinalIgnoreCase);
         }
@@ -95,7 +108,7 @@ namespace SymbolStores
 
             Trace.WriteLine($"Parsing symbol paths: '{symbolPaths}'");
 
-            var storeSequence = new SymbolStoreSequence(_moduleParser);
+            var storeSequence = new SymbolStoreSequence(_moduleParser, _buildIdIndex);
 
             foreach (string pathElement in symbolPaths.Split(';'))
             {
@@ -230,7 +243,7 @@ namespace SymbolStores
 
                 if (!string.IsNullOrWhiteSpace(defaultPath))
                 {
-                    var symbolStore = new StructuredSymbolStore(_fileSystem, defaultPath);
+                    var symbolStore = CreateStructuredStore(defaultPath);
                     server.AddStore(symbolStore);
                 }
             }
@@ -275,10 +288,22 @@ namespace SymbolStores
                     "but no downstream cache exists and no default cache path has been provided.");
                 return false;
             }
-            server.AddStore(new StructuredSymbolStore(_fileSystem, _defaultCachePath));
+            server.AddStore(CreateStructuredStore(_defaultCachePath));
             Trace.WriteLine($"Automatically added default cache as '{upstreamPathForLogging}' " +
                             "would not otherwise be cached.");
             return true;
         }
+
+        // The default cache is filled automatically, so it is kept within its budget.
+        StructuredSymbolStore CreateStructuredStore(string path)
+        {
+            if (!string.Equals(path, _defaultCachePath, StringComparison.OrdinalIgnoreCase))
+            {
+                return new StructuredSymbolStore(_fileSystem, path);
+            }
+
+            return _defaultCache ?? (_defaultCache = new StructuredSymbolStore(
+                                         _fileSystem, path, false, _defaultCacheMaxSize));
+        }
     }
 }
@@ -34,15 +34,20 @@ namespace SymbolStores
         public bool HasCache => _stores.Any(s => s.IsCache);
 
         readonly IModuleParser _moduleParser;
+        readonly IBuildIdIndex _buildIdIndex;
 
         [JsonProperty("Stores")]
         readonly IList<ISymbolStore> _stores;
 
         readonly IList<FlatSymbolStore> _flatSymbolStores = new List<FlatSymbolStore>();
 
-        public SymbolStoreSequence(IModuleParser moduleParser) : base(false, false)
+        /// <param name="buildIdIndex">Remembers verified build IDs, so unchanged files aren't
+        /// parsed again. Optional.</param>
+        public SymbolStoreSequence(IModuleParser moduleParser,
+                                   IBuildIdIndex buildIdIndex = null) : base(false, false)
         {
             _moduleParser = moduleParser;
+            _buildIdIndex = buildIdIndex;
             _stores = new List<ISymbolStore>();
         }
 
@@ -160,7 +165,13 @@ namespace SymbolStores
                 return false;
             }
 
-            if (BuildId.IsNullOrEmpty(query.BuildId))
+            if (BuildId.IsNullOrEmpty(query.BuildId) || query.SkipBuildIdVerification)
+            {
+                return true;
+            }
+
+            if (_buildIdIndex != null &&
+                _buildIdIndex.IsVerified(filepath, query.BuildId, query.ModuleFormat))
             {
                 return true;
             }
@@ -175,6 +186,7 @@ namespace SymbolStores
 
             if (actualBuildId.Data.Matches(query.BuildId, query.ModuleFormat))
             {
+                _buildIdIndex?.SetVerified(filepath, query.BuildId, query.ModuleFormat);
                 return true;
             }
 
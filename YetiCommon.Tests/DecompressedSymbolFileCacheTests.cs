@@ -0,0 +1,200 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.IO;
+using System.IO.Compression;
+using System.Linq;
+using NUnit.Framework;
+
+namespace YetiCommon.Tests
+{
+    [TestFixture]
+    public class DecompressedSymbolFileCacheTests
+    {
+        const ulong _shfCompressed = 0x800;
+        static readonly BuildId _buildId = new BuildId("0102030405060708");
+        static readonly byte[] _debugInfo =
+            Enumerable.Range(0, 1000).Select(i => (byte)(i % 7)).ToArray();
+
+        string _tempDir;
+        StringWriter _log;
+        DecompressedSymbolFileCache _cache;
+
+        [SetUp]
+        public void SetUp()
+        {
+            _tempDir = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(_tempDir);
+            _log = new StringWriter();
+            _cache = new DecompressedSymbolFileCache(Path.Combine(_tempDir, "cache"));
+        }
+
+        [TearDown]
+        public void TearDown()
+        {
+            Directory.Delete(_tempDir, true);
+        }
+
+        [Test]
+        public void GetDecompressedFileDecompressesSections()
+        {
+            string path = WriteElf("module.debug", true);
+
+            string cachedPath = _cache.GetDecompressedFile(path, _buildId, _log);
+
+            Assert.That(cachedPath, Is.Not.EqualTo(path));
+            Assert.That(_log.ToString(), Does.Contain("Decompressing 1 debug sections"));
+            using (var reader = new BinaryReader(File.OpenRead(cachedPath)))
+            {
+                // The section header follows the header and the compressed data.
+                reader.BaseStream.Position = BitConverter.ToInt64(
+                    File.ReadAllBytes(cachedPath), 0x28) + 64 + 8;
+                ulong flags = reader.ReadUInt64();
+                reader.BaseStream.Position += 8;
+                long offset = (long)reader.ReadUInt64();
+                long size = (long)reader.ReadUInt64();
+                Assert.That(flags & _shfCompressed, Is.EqualTo(0));
+                Assert.That(size, Is.EqualTo(_debugInfo.Length));
+                reader.BaseStream.Position = offset;
+                Assert.That(reader.ReadBytes((int)size), Is.EqualTo(_debugInfo));
+            }
+        }
+
+        [Test]
+        public void GetDecompressedFileReusesCachedCopy()
+        {
+            string path = WriteElf("module.debug", true);
+            string cachedPath = _cache.GetDecompressedFile(path, _buildId, _log);
+            _log = new StringWriter();
+
+            Assert.That(_cache.GetDecompressedFile(path, _buildId, _log),
+                        Is.EqualTo(cachedPath));
+            Assert.That(_log.ToString(), Does.Contain("Using decompressed copy"));
+        }
+
+        [Test]
+        public void GetDecompressedFileEvictsLeastRecentlyAccessedCopies()
+        {
+            string path = WriteElf("module.debug", true);
+            string firstPath = _cache.GetDecompressedFile(path, _buildId, _log);
+            long copySize = new FileInfo(firstPath).Length;
+            var cache = new DecompressedSymbolFileCache(Path.Combine(_tempDir, "cache"),
+                                                        copySize * 2);
+            string secondPath =
+                cache.GetDecompressedFile(path, new BuildId("0807060504030201"), _log);
+            File.SetLastAccessTimeUtc(firstPath, DateTime.UtcNow.AddDays(-1));
+            // Using the older copy makes the second one the least recently accessed.
+            Assert.That(cache.GetDecompressedFile(path, _buildId, _log), Is.EqualTo(firstPath));
+            File.SetLastAccessTimeUtc(secondPath, DateTime.UtcNow.AddDays(-1));
+
+            string thirdPath =
+                cache.GetDecompressedFile(path, new BuildId("1112131415161718"), _log);
+
+            Assert.That(File.Exists(firstPath));
+            Assert.That(File.Exists(secondPath), Is.False);
+            Assert.That(File.Exists(thirdPath));
+            Assert.That(_log.ToString(), Does.Contain("Evicted decompressed copy"));
+        }
+
+        [Test]
+        public void GetDecompressedFileKeepsUncompressedFile()
+        {
+            string path = WriteElf("module.debug", false);
+
+            Assert.That(_cache.GetDecompressedFile(path, _buildId, _log), Is.EqualTo(path));
+        }
+
+        [Test]
+        public void GetDecompressedFileRequiresBuildId()
+        {
+            string path = WriteElf("module.debug", true);
+
+            Assert.That(_cache.GetDecompressedFile(path, new BuildId(""), _log), Is.EqualTo(path));
+        }
+
+        [Test]
+        public void GetDecompressedFileIgnoresOtherFiles()
+        {
+            string path = Path.Combine(_tempDir, "module.pdb");
+            File.WriteAllBytes(path, new byte[] { 1, 2, 3 });
+
+            Assert.That(_cache.GetDecompressedFile(path, _buildId, _log), Is.EqualTo(path));
+            Assert.That(_log.ToString(), Is.Empty);
+        }
+
+        /// <summary>
+        /// Writes a 64-bit ELF file with a null section and a .debug_info section holding
+        /// _debugInfo, optionally zlib compressed.
+        /// </summary>
+        string WriteElf(string name, bool compress)
+        {
+            byte[] data = compress ? Compress(_debugInfo) : _debugInfo;
+            string path = Path.Combine(_tempDir, name);
+            using (var writer = new BinaryWriter(File.Create(path)))
+            {
+                long sectionHeadersOffset = 64 + data.Length;
+                writer.Write(new byte[] { 0x7f, (byte)'E', (byte)'L', (byte)'F', 2, 1, 1 });
+                writer.Write(new byte[9]);
+                writer.Write((ushort)1);       // e_type
+                writer.Write((ushort)62);      // e_machine
+                writer.Write(1u);              // e_version
+                writer.Write(0ul);             // e_entry
+                writer.Write(0ul);             // e_phoff
+                writer.Write((ulong)sectionHeadersOffset);
+                writer.Write(0u);              // e_flags
+                writer.Write((ushort)64);      // e_ehsize
+                writer.Write((ushort)0);       // e_phentsize
+                writer.Write((ushort)0);       // e_phnum
+                writer.Write((ushort)64);      // e_shentsize
+                writer.Write((ushort)2);       // e_shnum
+                writer.Write((ushort)0);       // e_shstrndx
+                writer.Write(data);
+
+                writer.Write(new byte[64]);
+                writer.Write(0u);              // sh_name
+                writer.Write(1u);              // sh_type
+                writer.Write(compress ? _shfCompressed : 0ul);
+                writer.Write(0ul);             // sh_addr
+                writer.Write(64ul);            // sh_offset
+                writer.Write((ulong)data.Length);
+                writer.Write(0u);              // sh_link
+                writer.Write(0u);              // sh_info
+                writer.Write(compress ? 1ul : 8ul);
+                writer.Write(0ul);             // sh_entsize
+            }
+            return path;
+        }
+
+        static byte[] Compress(byte[] data)
+        {
+            using (var stream = new MemoryStream())
+            {
+                var writer = new BinaryWriter(stream);
+                writer.Write(1u);              // ch_type
+                writer.Write(0u);              // ch_reserved
+                writer.Write((ulong)data.Length);
+                writer.Write(8ul);             // ch_addralign
+                // zlib header. The checksum trailer isn't read.
+                writer.Write(new byte[] { 0x78, 0x9c });
+                writer.Flush();
+                using (var deflater = new DeflateStream(stream, CompressionMode.Compress, true))
+                {
+                    deflater.Write(data, 0, data.Length);
+                }
+                return stream.ToArray();
+            }
+        }
+    }
+}
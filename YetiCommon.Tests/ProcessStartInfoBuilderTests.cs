@@ -58,6 +58,24 @@ namespace YetiCommon.Tests
             Assert.True(startInfo.Arguments.Contains("cloudcast@1.2.3.4 -p 56"));
             Assert.True(startInfo.Arguments.Contains(
                 $"-oUserKnownHostsFile=\"\"\"{GetKnownHostsPath()}\"\"\""));
+            Assert.False(startInfo.Arguments.Contains("-C "));
+        }
+
+        [Test]
+        public void BuildForSshPortForwardCompressed()
+        {
+            var ports = new List<ProcessStartInfoBuilder.PortForwardEntry>()
+            {
+                new ProcessStartInfoBuilder.PortForwardEntry()
+                {
+                    LocalPort = 123,
+                    RemotePort = 234,
+                },
+            };
+            var startInfo = ProcessStartInfoBuilder.BuildForSshPortForward(
+                ports, new SshTarget("1.2.3.4:56"), compress: true);
+            Assert.True(startInfo.Arguments.Contains("-nNT -C "));
+            Assert.True(startInfo.Arguments.Contains("-L123:localhost:234"));
         }
 
         [Test]
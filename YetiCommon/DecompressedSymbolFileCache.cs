@@ -0,0 +1,364 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.IO.Compression;
+using System.Linq;
+using System.Threading.Tasks;
+using YetiCommon.Logging;
+
+namespace YetiCommon
+{
+    /// <summary>
+    /// Stores copies of ELF symbol files with their compressed debug sections decompressed,
+    /// keyed by build ID, so LLDB can map the sections instead of inflating them on every load.
+    /// </summary>
+    /// <remarks>
+    /// The decompressed sections are appended to the copy and their section headers are pointed
+    /// at them. The compressed data stays in the copy but is no longer referenced. Only 64-bit
+    /// little-endian files are rewritten, and only zlib compressed sections are decompressed.
+    ///
+    /// The cache can be given a size budget. Cache hits update the access time of the copy, and
+    /// when a new copy takes the cache over the budget, the least recently accessed copies are
+    /// deleted. Copies that are in use can't be deleted and are kept.
+    /// </remarks>
+    public class DecompressedSymbolFileCache : IDecompressedSymbolFileCache
+    {
+        const ulong _shfAlloc = 0x2;
+        const ulong _shfCompressed = 0x800;
+        const uint _shtNobits = 8;
+        const uint _elfCompressZlib = 1;
+        const int _sectionHeaderSize = 64;
+        const int _compressionHeaderSize = 24;
+        const int _bufferSize = 1 << 16;
+
+        class CompressedSection
+        {
+            // File offset of the section header.
+            public long HeaderOffset;
+            public ulong Flags;
+            // File offset of the zlib stream, which follows the compression header.
+            public long DataOffset;
+            public long CompressedSize;
+            public long Size;
+            public ulong Alignment;
+            // File offset of the decompressed data in the copy.
+            public long NewOffset;
+        }
+
+        readonly string _cacheDirectory;
+
+        // Size budget in bytes, or 0 if the cache is unbounded.
+        readonly long _maxSize;
+
+        public DecompressedSymbolFileCache(string cacheDirectory, long maxSize = 0)
+        {
+            _cacheDirectory = cacheDirectory;
+            _maxSize = maxSize;
+        }
+
+        public string GetDecompressedFile(string filepath, BuildId buildId, TextWriter log)
+        {
+            if (BuildId.IsNullOrEmpty(buildId))
+            {
+                return filepath;
+            }
+
+            try
+            {
+                string cachedPath = Path.Combine(_cacheDirectory, buildId.ToHexString(),
+                                                 Path.GetFileName(filepath));
+                if (File.Exists(cachedPath))
+                {
+                    log.WriteLineAndTrace(
+                        $"Using decompressed copy '{cachedPath}' of '{filepath}'.");
+                    MarkAccessed(cachedPath);
+                    return cachedPath;
+                }
+
+                List<CompressedSection> sections = ReadCompressedSections(filepath);
+                if (sections.Count == 0)
+                {
+                    return filepath;
+                }
+
+                Stopwatch stopwatch = Stopwatch.StartNew();
+                WriteDecompressedFile(filepath, cachedPath, sections);
+                log.WriteLineAndTrace(
+                    $"Decompressing {sections.Count} debug sections of '{filepath}' " +
+                    $"({sections.Sum(s => s.CompressedSize)} to {sections.Sum(s => s.Size)} " +
+                    $"bytes) took {stopwatch.ElapsedMilliseconds} ms.");
+                EvictFilesOverBudget(cachedPath, log);
+                return cachedPath;
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException ||
+                e is InvalidDataException || e is NotSupportedException ||
+                e is ArgumentException)
+            {
+                log.WriteLineAndTrace(
+                    $"Failed to decompress the debug sections of '{filepath}': {e.Message}");
+                return filepath;
+            }
+        }
+
+        void MarkAccessed(string cachedPath)
+        {
+            if (_maxSize <= 0)
+            {
+                return;
+            }
+
+            try
+            {
+                File.SetLastAccessTimeUtc(cachedPath, DateTime.UtcNow);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                Trace.WriteLine($"Failed to update the access time of '{cachedPath}': " +
+                                e.Message);
+            }
+        }
+
+        /// <summary>
+        /// Deletes the least recently accessed copies until the cache fits in its budget.
+        /// |keepPath| is never deleted. The cache is only walked after a file was decompressed,
+        /// which takes much longer than the walk.
+        /// </summary>
+        void EvictFilesOverBudget(string keepPath, TextWriter log)
+        {
+            if (_maxSize <= 0)
+            {
+                return;
+            }
+
+            // Temporary files of decompressions in progress are skipped.
+            FileInfo[] files = new DirectoryInfo(_cacheDirectory)
+                .GetFiles("*", SearchOption.AllDirectories)
+                .Where(f => !f.Name.EndsWith(".tmp", StringComparison.OrdinalIgnoreCase))
+                .ToArray();
+            long totalSize = files.Sum(f => f.Length);
+            foreach (FileInfo file in files.OrderBy(f => f.LastAccessTimeUtc))
+            {
+                if (totalSize <= _maxSize)
+                {
+                    break;
+                }
+
+                if (string.Equals(file.FullName, Path.GetFullPath(keepPath),
+                                  StringComparison.OrdinalIgnoreCase))
+                {
+                    continue;
+                }
+
+                try
+                {
+                    long length = file.Length;
+                    file.Delete();
+                    totalSize -= length;
+                    log.WriteLineAndTrace($"Evicted decompressed copy '{file.FullName}'.");
+                    if (!Directory.EnumerateFileSystemEntries(file.DirectoryName).Any())
+                    {
+                        Directory.Delete(file.DirectoryName);
+                    }
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    Trace.WriteLine(
+                        $"Failed to evict decompressed copy '{file.FullName}': {e.Message}");
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the zlib compressed sections that aren't loaded into memory. Returns an
+        /// empty list for files that aren't 64-bit little-endian ELF files.
+        /// </summary>
+        static List<CompressedSection> ReadCompressedSections(string filepath)
+        {
+            var sections = new List<CompressedSection>();
+            using (var stream = new FileStream(filepath, FileMode.Open, FileAccess.Read,
+                                               FileShare.Read))
+            using (var reader = new BinaryReader(stream))
+            {
+                byte[] ident = reader.ReadBytes(16);
+                if (ident.Length < 16 || ident[0] != 0x7f || ident[1] != 'E' ||
+                    ident[2] != 'L' || ident[3] != 'F' || ident[4] != 2 || ident[5] != 1)
+                {
+                    return sections;
+                }
+
+                stream.Position = 0x28;
+                long sectionHeadersOffset = (long)reader.ReadUInt64();
+                stream.Position = 0x3a;
+                int sectionHeaderSize = reader.ReadUInt16();
+                long numSections = reader.ReadUInt16();
+                if (sectionHeadersOffset == 0 || sectionHeaderSize < _sectionHeaderSize)
+                {
+                    return sections;
+                }
+
+                if (numSections == 0)
+                {
+                    // With 0xff00 or more sections, the count is stored in the size of the
+                    // first section header.
+                    stream.Position = sectionHeadersOffset + 32;
+                    numSections = (long)reader.ReadUInt64();
+                }
+
+                for (long i = 0; i < numSections; i++)
+                {
+                    long headerOffset = sectionHeadersOffset + i * sectionHeaderSize;
+                    stream.Position = headerOffset + 4;
+                    uint type = reader.ReadUInt32();
+                    ulong flags = reader.ReadUInt64();
+                    stream.Position = headerOffset + 24;
+                    long offset = (long)reader.ReadUInt64();
+                    long size = (long)reader.ReadUInt64();
+                    if (type == _shtNobits || (flags & _shfCompressed) == 0 ||
+                        (flags & _shfAlloc) != 0 || size < _compressionHeaderSize)
+                    {
+                        continue;
+                    }
+
+                    stream.Position = offset;
+                    uint compressionType = reader.ReadUInt32();
+                    reader.ReadUInt32();
+                    long decompressedSize = (long)reader.ReadUInt64();
+                    ulong alignment = reader.ReadUInt64();
+                    if (compressionType != _elfCompressZlib)
+                    {
+                        continue;
+                    }
+
+                    sections.Add(new CompressedSection
+                    {
+                        HeaderOffset = headerOffset,
+                        Flags = flags,
+                        DataOffset = offset + _compressionHeaderSize,
+                        CompressedSize = size - _compressionHeaderSize,
+                        Size = decompressedSize,
+                        Alignment = Math.Max(alignment, 1),
+                    });
+                }
+            }
+
+            return sections;
+        }
+
+        static void WriteDecompressedFile(string filepath, string cachedPath,
+                                          List<CompressedSection> sections)
+        {
+            Directory.CreateDirectory(Path.GetDirectoryName(cachedPath));
+            string tempPath = $"{cachedPath}.{Guid.NewGuid():N}.tmp";
+            try
+            {
+                File.Copy(filepath, tempPath);
+                long end = new FileInfo(tempPath).Length;
+                foreach (CompressedSection section in sections)
+                {
+                    end = (long)(((ulong)end + section.Alignment - 1) / section.Alignment *
+                                 section.Alignment);
+                    section.NewOffset = end;
+                    end += section.Size;
+                }
+
+                using (var output = new FileStream(tempPath, FileMode.Open, FileAccess.Write,
+                                                   FileShare.ReadWrite))
+                {
+                    output.SetLength(end);
+                }
+
+                // A zlib stream can't be split, so sections are the unit of parallelism.
+                Task.WhenAll(sections.Select(
+                        s => Task.Run(() => DecompressSection(filepath, tempPath, s))))
+                    .GetAwaiter()
+                    .GetResult();
+
+                using (var output = new FileStream(tempPath, FileMode.Open, FileAccess.Write,
+                                                   FileShare.Read))
+                using (var writer = new BinaryWriter(output))
+                {
+                    foreach (CompressedSection section in sections)
+                    {
+                        output.Position = section.HeaderOffset + 8;
+                        writer.Write(section.Flags & ~_shfCompressed);
+                        output.Position = section.HeaderOffset + 24;
+                        writer.Write((ulong)section.NewOffset);
+                        writer.Write((ulong)section.Size);
+                        output.Position = section.HeaderOffset + 48;
+                        writer.Write(section.Alignment);
+                    }
+                }
+
+                try
+                {
+                    File.Move(tempPath, cachedPath);
+                }
+                catch (IOException) when (File.Exists(cachedPath))
+                {
+                    // Another load of the same file finished first.
+                }
+            }
+            finally
+            {
+                if (File.Exists(tempPath))
+                {
+                    File.Delete(tempPath);
+                }
+            }
+        }
+
+        static void DecompressSection(string filepath, string tempPath,
+                                      CompressedSection section)
+        {
+            using (var input = new FileStream(filepath, FileMode.Open, FileAccess.Read,
+                                              FileShare.Read, _bufferSize))
+            using (var output = new FileStream(tempPath, FileMode.Open, FileAccess.Write,
+                                               FileShare.ReadWrite, _bufferSize))
+            {
+                input.Position = section.DataOffset;
+                // DeflateStream reads raw deflate data, so the zlib header is skipped. Streams
+                // that need a preset dictionary can't be inflated without it.
+                int method = input.ReadByte();
+                int flags = input.ReadByte();
+                if ((method & 0x0f) != 8 || (flags & 0x20) != 0)
+                {
+                    throw new InvalidDataException("Unsupported zlib stream");
+                }
+
+                output.Position = section.NewOffset;
+                using (var inflater = new DeflateStream(input, CompressionMode.Decompress, true))
+                {
+                    var buffer = new byte[_bufferSize];
+                    long remaining = section.Size;
+                    while (remaining > 0)
+                    {
+                        int read = inflater.Read(buffer, 0,
+                                                 (int)Math.Min(buffer.Length, remaining));
+                        if (read == 0)
+                        {
+                            throw new InvalidDataException("Compressed section is truncated");
+                        }
+
+                        output.Write(buffer, 0, read);
+                        remaining -= read;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.IO;
+
+namespace YetiCommon
+{
+    public interface IDecompressedSymbolFileCache
+    {
+        /// <summary>
+        /// Returns the path of a copy of an ELF file in which the compressed debug sections
+        /// (SHF_COMPRESSED) are stored uncompressed. The copy is created on first use and
+        /// reused by later sessions. Returns <paramref name="filepath"/> itself if the file has no
+        /// compressed sections, has no build ID or can't be decompressed. This method doesn't
+        /// throw, errors are written to <paramref name="log"/>.
+        /// </summary>
+        /// <param name="filepath">Full path to the ELF file.</param>
+        /// <param name="buildId">Build ID of the file, used as the cache key.</param>
+        /// <param name="log">Receives the decompression time and any errors.</param>
+        string GetDecompressedFile(string filepath, BuildId buildId, TextWriter log);
+    }
+}
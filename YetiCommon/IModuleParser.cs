@@ -63,6 +63,14 @@ namespace YetiCommon
         /// is populated.</param>
         /// <param name="errorMessage">Generated error message.</param>
         bool IsValidElf(string filepath, bool isDebugInfoFile, out string errorMessage);
+
+        /// <summary>
+        /// Checks whether an ELF file uses split DWARF, i.e. it has a skeleton unit whose debug
+        /// info is in a .dwo file or a DWARF package. This method doesn't throw,
+        /// files that can't be read are reported as not using split DWARF.
+        /// </summary>
+        /// <param name="filepath">Full path to the file to check.</param>
+        bool HasSplitDwarf(string filepath);
     }
 
     public class DebugLinkLocationInfo
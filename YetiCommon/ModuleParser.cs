@@ -34,6 +34,14 @@ namespace YetiCommon
         readonly string _debugDirName = ".note.debug_info_dir";
         readonly string _buildIdName = ".note.gnu.build-id";
         readonly string _debugInfoName = ".debug_info";
+        readonly string _debugAddrName = ".debug_addr";
+        readonly string _debugAbbrevName = ".debug_abbrev";
+
+        const ulong _shfCompressed = 0x800;
+        const byte _dwUtSkeleton = 0x04;
+        const ulong _dwAtDwoName = 0x76;
+        const ulong _dwAtGnuDwoName = 0x2130;
+        const ulong _dwFormImplicitConst = 0x21;
         readonly string _fileFormat = "file format";
 
         static readonly Regex _hexDumpRegex =
@@ -414,6 +422,201 @@ namespace YetiCommon
             return false;
         }
 
+        public bool HasSplitDwarf(string filepath)
+        {
+            if (!File.Exists(filepath))
+            {
+                return false;
+            }
+
+            try
+            {
+                using (Stream stream = File.OpenRead(filepath))
+                {
+                    if (!ELFReader.TryLoad(stream, false, out IELF elfReader))
+                    {
+                        return false;
+                    }
+
+                    using (elfReader)
+                    {
+                        if (!elfReader.TryGetSection(_debugInfoName, out ISection debugInfo))
+                        {
+                            return false;
+                        }
+
+                        // DWARF 4 has no unit types, but only split DWARF (the GNU extension)
+                        // produces .debug_addr for it.
+                        bool hasDebugAddr = elfReader.TryGetSection(_debugAddrName, out ISection _);
+                        if (!hasDebugAddr)
+                        {
+                            return false;
+                        }
+
+                        GetSectionLocation(debugInfo, out ulong offset, out ulong size,
+                                           out ulong flags);
+                        // The unit headers of a compressed section can't be read in place.
+                        if ((flags & _shfCompressed) != 0)
+                        {
+                            return true;
+                        }
+
+                        ulong? abbrevOffset = null;
+                        if (elfReader.TryGetSection(_debugAbbrevName, out ISection debugAbbrev))
+                        {
+                            GetSectionLocation(debugAbbrev, out ulong sectionOffset, out ulong _,
+                                               out ulong abbrevFlags);
+                            if ((abbrevFlags & _shfCompressed) == 0)
+                            {
+                                abbrevOffset = sectionOffset;
+                            }
+                        }
+
+                        return HasSkeletonUnit(stream, offset, size, abbrevOffset);
+                    }
+                }
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException ||
+                e is NotSupportedException || e is ArgumentException)
+            {
+                Trace.WriteLine($"Error checking {filepath} for split DWARF: {e.Message}");
+                return false;
+            }
+        }
+
+        static void GetSectionLocation(ISection section, out ulong offset, out ulong size,
+                                       out ulong flags)
+        {
+            if (section is Section<ulong> section64)
+            {
+                offset = section64.Offset;
+                size = section64.Size;
+                flags = section64.RawFlags;
+            }
+            else
+            {
+                var section32 = (Section<uint>)section;
+                offset = section32.Offset;
+                size = section32.Size;
+                flags = section32.RawFlags;
+            }
+        }
+
+        /// <summary>
+        /// Returns true if the .debug_info section at |offset| has a skeleton unit. Mixed files
+        /// can have skeletons anywhere, so the unit headers are scanned until one is found.
+        /// DWARF 5 skeletons have their own unit type. DWARF 4 skeletons are compile units with
+        /// DW_AT_GNU_dwo_name, which is looked up in the .debug_abbrev section at
+        /// |abbrevOffset|. Without it, DWARF 4 units count as skeletons, since only split DWARF
+        /// produces .debug_addr for DWARF 4.
+        /// </summary>
+        static bool HasSkeletonUnit(Stream stream, ulong offset, ulong size, ulong? abbrevOffset)
+        {
+            using (var reader = new BinaryReader(stream, Encoding.ASCII, true))
+            {
+                ulong unitOffset = 0;
+                while (unitOffset < size)
+                {
+                    stream.Seek((long)(offset + unitOffset), SeekOrigin.Begin);
+                    ulong unitLength = reader.ReadUInt32();
+                    ulong headerSize = 4;
+                    bool is64Bit = unitLength == 0xffffffff;
+                    // 64-bit DWARF has an escape before the actual length.
+                    if (is64Bit)
+                    {
+                        unitLength = reader.ReadUInt64();
+                        headerSize = 12;
+                    }
+
+                    ushort version = reader.ReadUInt16();
+                    if (version >= 5)
+                    {
+                        if (reader.ReadByte() == _dwUtSkeleton)
+                        {
+                            return true;
+                        }
+                    }
+                    else
+                    {
+                        ulong unitAbbrevOffset =
+                            is64Bit ? reader.ReadUInt64() : reader.ReadUInt32();
+                        reader.ReadByte();
+                        ulong code = ReadULEB128(reader);
+                        if (abbrevOffset == null ||
+                            AbbreviationHasDwoName(reader, abbrevOffset.Value + unitAbbrevOffset,
+                                                   code))
+                        {
+                            return true;
+                        }
+                    }
+
+                    unitOffset += headerSize + unitLength;
+                }
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Returns true if abbreviation |code| of the abbreviation table at |offset| has a DWO
+        /// name, which only skeleton units have.
+        /// </summary>
+        static bool AbbreviationHasDwoName(BinaryReader reader, ulong offset, ulong code)
+        {
+            reader.BaseStream.Seek((long)offset, SeekOrigin.Begin);
+            ulong abbreviationCode;
+            while ((abbreviationCode = ReadULEB128(reader)) != 0)
+            {
+                // The tag and DW_CHILDREN.
+                ReadULEB128(reader);
+                reader.ReadByte();
+                while (true)
+                {
+                    ulong name = ReadULEB128(reader);
+                    ulong form = ReadULEB128(reader);
+                    if (name == 0 && form == 0)
+                    {
+                        break;
+                    }
+
+                    if (abbreviationCode == code &&
+                        (name == _dwAtDwoName || name == _dwAtGnuDwoName))
+                    {
+                        return true;
+                    }
+
+                    // The constant is stored in the abbreviation. Reading it as unsigned skips
+                    // the same bytes.
+                    if (form == _dwFormImplicitConst)
+                    {
+                        ReadULEB128(reader);
+                    }
+                }
+
+                if (abbreviationCode == code)
+                {
+                    return false;
+                }
+            }
+
+            return false;
+        }
+
+        static ulong ReadULEB128(BinaryReader reader)
+        {
+            ulong value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                byte b = reader.ReadByte();
+                value |= (ulong)(b & 0x7f) << shift;
+                if ((b & 0x80) == 0)
+                {
+                    break;
+                }
+            }
+            return value;
+        }
+
         public string ParseStringValue(byte[] contents)
         {
             IEnumerable<byte> stringBytes = contents.TakeWhile(x => x != 0);
@@ -60,6 +60,13 @@ namespace YetiCommon
         /// </summary>
         public bool RequireDebugInfo { get; set; }
 
+        /// <summary>
+        /// Accept files without checking their build ID. Used for files that have no build ID
+        /// of their own, like DWARF packages, which are stored under the build ID of their
+        /// module.
+        /// </summary>
+        public bool SkipBuildIdVerification { get; set; }
+
         /// <summary>
         /// When set to False and previous search of this symbol in a remote
         /// SymbolStore failed, we won't try to look again and immediately return
@@ -50,16 +50,18 @@ namespace YetiCommon
 
         /// <summary>
         /// Returns ProcessStartInfo for forwarding a local port to a remote gamelet using SSH.
+        /// If |compress| is set, the forwarded traffic is zlib-compressed by SSH.
         /// </summary>
         public static ProcessStartInfo BuildForSshPortForward(
-            IEnumerable<PortForwardEntry> ports, SshTarget target)
+            IEnumerable<PortForwardEntry> ports, SshTarget target, bool compress = false)
         {
             var portsArgument =
                 string.Join(" ", ports.Select(e => $"-L{e.LocalPort}:localhost:{e.RemotePort}"));
+            var compressArgument = compress ? "-C " : "";
             return new ProcessStartInfo()
             {
                 FileName = Path.Combine(SDKUtil.GetSshPath(), YetiConstants.SshWinExecutable),
-                Arguments = $"-nNT -i \"{SDKUtil.GetSshKeyFilePath()}\" " +
+                Arguments = $"-nNT {compressArgument}-i \"{SDKUtil.GetSshKeyFilePath()}\" " +
                     $"-F \"{SDKUtil.GetSshConfigFilePath()}\" -oStrictHostKeyChecking=yes " +
                     $"-oUserKnownHostsFile=\"\"\"{SDKUtil.GetSshKnownHostsFilePath()}\"\"\" " +
                     $"{portsArgument} cloudcast@{target.IpAddress} -p {target.Port}"
@@ -169,6 +169,47 @@ namespace YetiCommon
             return Path.Combine(GetLocalAppDataPath(), "SymbolStore");
         }
 
+        /// <summary>
+        /// Returns the directory the debugger persists source line indexes in.
+        /// </summary>
+        public static string GetSourceLineIndexCachePath()
+        {
+            return Path.Combine(GetLocalAppDataPath(), "SourceLineIndexCache");
+        }
+
+        /// <summary>
+        /// Returns the directory the debugger persists symbol search indexes in.
+        /// </summary>
+        public static string GetSymbolSearchIndexCachePath()
+        {
+            return Path.Combine(GetLocalAppDataPath(), "SymbolSearchIndexCache");
+        }
+
+        /// <summary>
+        /// Returns the directory copies of symbol files with decompressed debug sections are
+        /// cached in.
+        /// </summary>
+        public static string GetDecompressedSymbolFileCachePath()
+        {
+            return Path.Combine(GetLocalAppDataPath(), "DecompressedSymbolCache");
+        }
+
+        /// <summary>
+        /// Returns the path of the index of verified symbol file build IDs.
+        /// </summary>
+        public static string GetBuildIdIndexPath()
+        {
+            return Path.Combine(GetLocalAppDataPath(), "BuildIdIndex.bin");
+        }
+
+        /// <summary>
+        /// Returns the directory LLDB caches symbol tables and DWARF indexes in.
+        /// </summary>
+        public static string GetLldbIndexCachePath()
+        {
+            return Path.Combine(GetLocalAppDataPath(), "LldbIndexCache");
+        }
+
         /// <summary>
         /// Returns the path of the SDK services configuration, e.g.
         /// %APPDATA%\GGP\services.
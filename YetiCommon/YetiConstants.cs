@@ -47,6 +47,17 @@ namespace YetiCommon
 
         public static readonly string[] SymbolServerExcludeList = { "msdl.microsoft.com" };
 
+        /// <summary>
+        /// Size in bytes the default symbol cache is trimmed to when files are added to it.
+        /// </summary>
+        public const long DefaultSymbolCacheMaxSize = 20L * 1024 * 1024 * 1024;
+
+        /// <summary>
+        /// Size in bytes the cache of decompressed symbol files is trimmed to when files are
+        /// added to it.
+        /// </summary>
+        public const long DecompressedSymbolFileCacheMaxSize = 20L * 1024 * 1024 * 1024;
+
         /// <summary>
         /// Directory where the current code is executed from.
         /// In production, this is the GGP extension directory.
@@ -0,0 +1,235 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "AddressLineTable.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "ParallelUtil.h"
+#include "lldb/API/SBCompileUnit.h"
+#include "lldb/API/SBFileSpec.h"
+#include "lldb/API/SBLineEntry.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the table registry. <mutex> is not available when compiling with
+// /clr.
+private
+ref class AddressLineTableLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// Tables by module UUID. Rows hold file addresses, so a table is shared by
+// all loads of a module. Tables are shared, so clearing the registry doesn't
+// free a table that is being searched.
+std::unordered_map<std::string, std::shared_ptr<AddressLineTable>> g_tables;
+
+std::string ToString(const char* str) { return str ? str : ""; }
+
+// A line table row as read from a compile unit. File specs store their
+// components as pooled strings, so the pointers identify the file.
+struct RawRow {
+  uint64_t start;
+  uint64_t end;
+  uint32_t compile_unit;
+  const char* directory;
+  const char* file_name;
+  uint32_t line;
+  uint32_t column;
+};
+
+// Returns the index of the last element of |keys| that is <= |key|, or -1 if
+// there is none. The loop has no data-dependent branches, so it compiles to
+// conditional moves.
+int64_t FindLastNotAbove(const std::vector<uint64_t>& keys, uint64_t key) {
+  if (keys.empty() || keys[0] > key) {
+    return -1;
+  }
+  const uint64_t* base = keys.data();
+  size_t size = keys.size();
+  while (size > 1) {
+    size_t half = size / 2;
+    base = base[half] <= key ? base + half : base;
+    size -= half;
+  }
+  return base - keys.data();
+}
+
+}  // namespace
+
+std::shared_ptr<AddressLineTable> AddressLineTable::Build(
+    lldb::SBModule module) {
+  uint32_t num_compile_units = module.GetNumCompileUnits();
+  std::vector<std::vector<RawRow>> partial_rows(num_compile_units);
+  ParallelFor(num_compile_units, [&](int32_t cu_index) {
+    lldb::SBCompileUnit compile_unit = module.GetCompileUnitAtIndex(cu_index);
+    std::vector<RawRow>& rows = partial_rows[cu_index];
+    uint32_t num_entries = compile_unit.GetNumLineEntries();
+    rows.reserve(num_entries);
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      lldb::SBLineEntry entry = compile_unit.GetLineEntryAtIndex(i);
+      // End-of-sequence rows only end the previous row. LLDB never returns
+      // them.
+      if (entry.IsTerminalEntry()) {
+        continue;
+      }
+      uint64_t start = entry.GetStartAddress().GetFileAddress();
+      uint64_t end = entry.GetEndAddress().GetFileAddress();
+      if (start == LLDB_INVALID_ADDRESS || end == LLDB_INVALID_ADDRESS ||
+          end < start) {
+        continue;
+      }
+      // Rows that share their start address with the next row are empty.
+      // They are kept, since LLDB returns the first row of an address.
+      lldb::SBFileSpec file_spec = entry.GetFileSpec();
+      rows.push_back({start, end, static_cast<uint32_t>(cu_index),
+                      file_spec.GetDirectory(), file_spec.GetFilename(),
+                      entry.GetLine(), entry.GetColumn()});
+    }
+  });
+
+  std::vector<RawRow> rows;
+  for (auto& cu_rows : partial_rows) {
+    rows.insert(rows.end(), cu_rows.begin(), cu_rows.end());
+    std::vector<RawRow>().swap(cu_rows);
+  }
+  // The sort is stable, so the rows of an address stay in line table order
+  // and the compile units stay in module order.
+  std::stable_sort(rows.begin(), rows.end(),
+                   [](const RawRow& a, const RawRow& b) {
+                     return a.start < b.start;
+                   });
+
+  auto table = std::make_shared<AddressLineTable>();
+  std::map<std::pair<const char*, const char*>, uint32_t> file_ids;
+  uint32_t previous_compile_unit = 0;
+  for (const RawRow& raw : rows) {
+    if (!table->starts_.empty()) {
+      // Where the line tables of compile units overlap, keep the rows of the
+      // first one, like a search of the compile units in order would.
+      uint64_t previous_start = table->starts_.back();
+      uint64_t previous_end = previous_start + table->rows_.back().size;
+      if (raw.start == previous_start
+              ? raw.compile_unit != previous_compile_unit
+              : raw.start < previous_end) {
+        continue;
+      }
+    }
+    auto file_id = file_ids.find({raw.directory, raw.file_name});
+    if (file_id == file_ids.end()) {
+      file_id = file_ids
+                    .emplace(std::make_pair(raw.directory, raw.file_name),
+                             static_cast<uint32_t>(table->files_.size()))
+                    .first;
+      table->files_.push_back(
+          {ToString(raw.file_name), ToString(raw.directory)});
+    }
+    previous_compile_unit = raw.compile_unit;
+    uint64_t size = std::min<uint64_t>(raw.end - raw.start, UINT32_MAX);
+    table->starts_.push_back(raw.start);
+    table->rows_.push_back({static_cast<uint32_t>(size), file_id->second,
+                            raw.line, raw.column});
+  }
+  table->starts_.shrink_to_fit();
+  table->rows_.shrink_to_fit();
+  return table;
+}
+
+bool AddressLineTable::Lookup(uint64_t file_address,
+                              ResolvedLineEntry* entry) const {
+  int64_t index = FindLastNotAbove(starts_, file_address);
+  if (index < 0) {
+    return false;
+  }
+  if (file_address == starts_[index]) {
+    // Only the last row of an address has a size. LLDB matches an address
+    // where rows start with the first of them, even if it is empty.
+    while (index > 0 && starts_[index - 1] == file_address) {
+      --index;
+    }
+  } else if (file_address - starts_[index] >= rows_[index].size) {
+    return false;
+  }
+  const Row& row = rows_[index];
+  const File& file = files_[row.file_id];
+  entry->file_name = file.file_name;
+  entry->directory = file.directory;
+  entry->line = row.line;
+  entry->column = row.column;
+  entry->start_file_address = starts_[index];
+  return true;
+}
+
+std::shared_ptr<const AddressLineTable> GetAddressLineTable(
+    lldb::SBModule module) {
+  const char* uuid = module.GetUUIDString();
+  if (uuid == nullptr || *uuid == '\0' || module.GetNumCompileUnits() == 0) {
+    return nullptr;
+  }
+
+  {
+    msclr::lock lock(AddressLineTableLock::instance);
+    auto it = g_tables.find(uuid);
+    if (it != g_tables.end()) {
+      return it->second;
+    }
+  }
+
+  // Built outside of the lock, so lookups in other modules aren't blocked. If
+  // two threads build the same table, the first one is kept.
+  std::shared_ptr<AddressLineTable> table = AddressLineTable::Build(module);
+  msclr::lock lock(AddressLineTableLock::instance);
+  auto it = g_tables.emplace(uuid, std::move(table)).first;
+  return it->second;
+}
+
+void ClearAddressLineTables() {
+  msclr::lock lock(AddressLineTableLock::instance);
+  g_tables.clear();
+}
+
+bool ResolveLineEntry(lldb::SBAddress address, ResolvedLineEntry* entry) {
+  std::shared_ptr<const AddressLineTable> table =
+      GetAddressLineTable(address.GetModule());
+  if (table != nullptr) {
+    return table->Lookup(address.GetFileAddress(), entry);
+  }
+
+  lldb::SBLineEntry line_entry = address.GetLineEntry();
+  if (!line_entry.IsValid()) {
+    return false;
+  }
+  lldb::SBFileSpec file_spec = line_entry.GetFileSpec();
+  entry->file_name = ToString(file_spec.GetFilename());
+  entry->directory = ToString(file_spec.GetDirectory());
+  entry->line = line_entry.GetLine();
+  entry->column = line_entry.GetColumn();
+  entry->start_file_address = line_entry.GetStartAddress().GetFileAddress();
+  return true;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBModule.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+struct ResolvedLineEntry {
+  std::string file_name;
+  std::string directory;
+  uint32_t line = 0;
+  uint32_t column = 0;
+  // File address of the start of the line table row.
+  uint64_t start_file_address = 0;
+};
+
+// The line tables of all compile units of a module, flattened into one array
+// of rows sorted by file address. Rows are kept as they are in the line
+// tables, so lookups return the same rows as LLDB.
+class AddressLineTable {
+ public:
+  // Builds the table from the line tables of |module|. Compile units are
+  // processed in parallel.
+  static std::shared_ptr<AddressLineTable> Build(lldb::SBModule module);
+
+  // Finds the row of |file_address| like LLDB does: an address inside a row
+  // gets the last row starting at that row's address, an address where rows
+  // start gets the first of them. Returns false if there is none.
+  bool Lookup(uint64_t file_address, ResolvedLineEntry* entry) const;
+
+  size_t GetNumRows() const { return starts_.size(); }
+
+ private:
+  struct Row {
+    uint32_t size;
+    uint32_t file_id;
+    uint32_t line;
+    uint32_t column;
+  };
+
+  struct File {
+    std::string file_name;
+    std::string directory;
+  };
+
+  // Kept apart from the rows so the search only touches the addresses.
+  std::vector<uint64_t> starts_;
+  std::vector<Row> rows_;
+  std::vector<File> files_;
+};
+
+// Returns the table of |module|, which is built on first use. Returns nullptr
+// for modules without UUID or line tables.
+std::shared_ptr<const AddressLineTable> GetAddressLineTable(
+    lldb::SBModule module);
+
+// Drops all tables. Called when modules are unloaded or get new symbols.
+void ClearAddressLineTables();
+
+// Resolves the line entry of |address| with the table of its module, or with
+// LLDB if the module has none. Returns false if there is no line entry.
+bool ResolveLineEntry(lldb::SBAddress address, ResolvedLineEntry* entry);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,45 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "AddressRangeUtil.h"
+
+#include <algorithm>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+std::vector<AddressRange> CoalesceRanges(std::vector<AddressRange> ranges) {
+  ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                              [](const AddressRange& r) { return r.size == 0; }),
+               ranges.end());
+  std::sort(ranges.begin(), ranges.end(),
+            [](const AddressRange& lhs, const AddressRange& rhs) {
+              return lhs.base < rhs.base;
+            });
+
+  std::vector<AddressRange> result;
+  for (const AddressRange& range : ranges) {
+    if (!result.empty() && range.base <= result.back().End()) {
+      uint64_t end = std::max(result.back().End(), range.End());
+      result.back().size = end - result.back().base;
+    } else {
+      result.push_back(range);
+    }
+  }
+  return result;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// A native [base, base + size) range of the process address space.
+struct AddressRange {
+  uint64_t base;
+  uint64_t size;
+
+  uint64_t End() const { return base + size; }
+};
+
+// Sorts |ranges| by base address and merges ranges that overlap or touch.
+// Empty ranges are dropped.
+std::vector<AddressRange> CoalesceRanges(std::vector<AddressRange> ranges);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
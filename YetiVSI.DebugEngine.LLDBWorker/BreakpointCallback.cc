@@ -0,0 +1,36 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "BreakpointCallback.h"
+
+#include "BreakpointCondition.h"
+#include "Tracepoint.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+bool BreakpointHitCallback(void* baton, lldb::SBProcess& process,
+                           lldb::SBThread& thread,
+                           lldb::SBBreakpointLocation& location) {
+  if (!EvaluateBreakpointCondition(thread, location)) {
+    return false;
+  }
+  // Tracepoints never stop, so the hit doesn't reach the event loop or Visual
+  // Studio.
+  return !CollectTracepointHit(process, thread, location);
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "lldb/API/SBBreakpointLocation.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBThread.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Callback installed by both conditions and tracepoints. LLDB only calls one
+// callback per hit, and a location's callback overrides the callback of its
+// breakpoint, so conditions (set per location) and tracepoints (set per
+// breakpoint) share this one. It evaluates the condition of |location| first,
+// and then collects the trace items if the breakpoint is a tracepoint. Returns
+// true if the process should stop.
+bool BreakpointHitCallback(void* baton, lldb::SBProcess& process,
+                           lldb::SBThread& thread,
+                           lldb::SBBreakpointLocation& location);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
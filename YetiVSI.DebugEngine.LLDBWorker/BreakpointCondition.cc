@@ -0,0 +1,131 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "BreakpointCondition.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <utility>
+
+#include "BreakpointCallback.h"
+#include "lldb/API/SBBreakpoint.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBThread.h"
+#include "lldb/API/SBValue.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the condition registry and the counters of the conditions. <mutex> is
+// not available when compiling with /clr.
+private
+ref class BreakpointConditionLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// Breakpoint ID and location ID.
+using LocationKey = std::pair<int32_t, int32_t>;
+
+std::map<LocationKey, std::shared_ptr<BreakpointCondition>> g_conditions;
+
+LocationKey GetLocationKey(lldb::SBBreakpointLocation location) {
+  return {location.GetBreakpoint().GetID(), location.GetID()};
+}
+
+std::shared_ptr<BreakpointCondition> FindCondition(
+    lldb::SBBreakpointLocation location) {
+  msclr::lock lock(BreakpointConditionLock::instance);
+  auto it = g_conditions.find(GetLocationKey(location));
+  return it != g_conditions.end() ? it->second : nullptr;
+}
+
+}  // namespace
+
+BreakpointCondition::BreakpointCondition(std::string expression)
+    : expression_evaluator_(std::move(expression)) {}
+
+bool BreakpointCondition::ShouldStop(lldb::SBFrame frame,
+                                     lldb::SBBreakpointLocation location) {
+  auto start = std::chrono::steady_clock::now();
+
+  lldb::SBError error;
+  lldb::SBValue result = expression_evaluator_.Evaluate(frame, location, error);
+  bool stop = error.Fail() || result.GetValueAsUnsigned(1) != 0;
+
+  uint64_t elapsed_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  msclr::lock lock(BreakpointConditionLock::instance);
+  stats_.hit_count++;
+  if (stop) {
+    stats_.true_count++;
+  }
+  stats_.total_eval_ns += elapsed_ns;
+  stats_.max_eval_ns = std::max(stats_.max_eval_ns, elapsed_ns);
+  return stop;
+}
+
+ConditionStats BreakpointCondition::stats() const {
+  msclr::lock lock(BreakpointConditionLock::instance);
+  return stats_;
+}
+
+void SetBreakpointCondition(lldb::SBBreakpointLocation location,
+                            std::string expression) {
+  LocationKey key = GetLocationKey(location);
+  {
+    msclr::lock lock(BreakpointConditionLock::instance);
+    if (expression.empty()) {
+      g_conditions.erase(key);
+    } else {
+      g_conditions[key] =
+          std::make_shared<BreakpointCondition>(std::move(expression));
+    }
+  }
+  // The callback stays installed when the condition is removed. It then only
+  // handles a tracepoint of the breakpoint, if any.
+  location.SetCallback(BreakpointHitCallback, nullptr);
+}
+
+bool EvaluateBreakpointCondition(lldb::SBThread thread,
+                                 lldb::SBBreakpointLocation location) {
+  std::shared_ptr<BreakpointCondition> condition = FindCondition(location);
+  if (condition == nullptr) {
+    return true;
+  }
+  return condition->ShouldStop(thread.GetSelectedFrame(), location);
+}
+
+ConditionStats GetBreakpointConditionStats(
+    lldb::SBBreakpointLocation location) {
+  std::shared_ptr<BreakpointCondition> condition = FindCondition(location);
+  return condition != nullptr ? condition->stats() : ConditionStats();
+}
+
+void ClearBreakpointConditions(int32_t breakpoint_id) {
+  msclr::lock lock(BreakpointConditionLock::instance);
+  g_conditions.erase(g_conditions.lower_bound({breakpoint_id, INT32_MIN}),
+                     g_conditions.upper_bound({breakpoint_id, INT32_MAX}));
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
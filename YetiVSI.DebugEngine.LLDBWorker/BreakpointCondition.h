@@ -0,0 +1,83 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "FrameExpression.h"
+#include "lldb/API/SBBreakpointLocation.h"
+#include "lldb/API/SBFrame.h"
+#include "lldb/API/SBThread.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Counters collected while evaluating the condition of a breakpoint location.
+struct ConditionStats {
+  uint64_t hit_count = 0;
+  uint64_t true_count = 0;
+  uint64_t total_eval_ns = 0;
+  uint64_t max_eval_ns = 0;
+};
+
+// Condition attached to a breakpoint location. The condition is compiled once
+// per location (see FrameExpression).
+class BreakpointCondition {
+ public:
+  explicit BreakpointCondition(std::string expression);
+
+  // Returns true if the process should stop at |location|. Errors are treated
+  // as true to match Visual Studio, which only skips a conditional breakpoint
+  // if the condition evaluates to false.
+  bool ShouldStop(lldb::SBFrame frame, lldb::SBBreakpointLocation location);
+
+  // Returns a copy of the counters. Safe to call while the condition is
+  // evaluated on LLDB's event thread.
+  ConditionStats stats() const;
+
+ private:
+  FrameExpression expression_evaluator_;
+  // Guarded by BreakpointConditionLock.
+  ConditionStats stats_;
+};
+
+// Sets the condition of |location|, replacing its previous condition and
+// counters. An empty |expression| removes the condition. Conditions are kept
+// by breakpoint and location ID, so all SbBreakpointLocation wrappers of a
+// location share them.
+void SetBreakpointCondition(lldb::SBBreakpointLocation location,
+                            std::string expression);
+
+// Evaluates the condition of |location| in the selected frame of |thread|,
+// which is stopped at it. The condition is looked up on every hit, so that it
+// can be replaced while the process is running. Returns true if the process
+// should stop, including when |location| has no condition.
+bool EvaluateBreakpointCondition(lldb::SBThread thread,
+                                 lldb::SBBreakpointLocation location);
+
+// Returns the counters of the condition of |location|. All counters are zero if
+// the location has no condition.
+ConditionStats GetBreakpointConditionStats(lldb::SBBreakpointLocation location);
+
+// Drops the conditions of all locations of the breakpoint |breakpoint_id|.
+void ClearBreakpointConditions(int32_t breakpoint_id);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
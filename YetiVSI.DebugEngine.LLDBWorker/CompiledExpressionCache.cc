@@ -0,0 +1,423 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "CompiledExpressionCache.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBProcess.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the expression registry. <mutex> is not available when compiling
+// with /clr.
+private
+ref class CompiledExpressionLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// Upper bound on the number of cached expressions. When it is reached, the
+// expressions without live handles are dropped, so the registry can't grow
+// without bound while visualizing many template instantiations. Expressions
+// with live handles are kept until their handles are released.
+constexpr size_t kMaxCompiledExpressions = 4096;
+
+// What a compiled expression depends on, so it can be evicted when that
+// changes.
+struct ExpressionScope {
+  // Unique ID of the process of the target, or 0 if it has none.
+  uint32_t process_id = 0;
+  // Names of the types the expression was compiled with, as they are looked
+  // up in modules. Builtin types don't depend on any module and are left out.
+  std::vector<std::string> type_names;
+  // Set if one of the types has no name to look it up by, in which case any
+  // module of the process can define it.
+  bool any_module = false;
+};
+
+struct CachedExpression {
+  // Live handle of the expression, or 0 if it has none. Failed compilations
+  // never have a handle.
+  int64_t handle;
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled;
+  lldb::SBError error;
+  ExpressionScope scope;
+};
+
+struct HandleEntry {
+  // Empty for expressions that aren't cached by key.
+  std::string key;
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled;
+  // Number of times the handle was returned and not released yet.
+  int ref_count;
+  ExpressionScope scope;
+  // Set when the expression was evicted while the handle was live. The
+  // handle stays registered, without an expression, until it is released.
+  bool stale;
+};
+
+std::unordered_map<std::string, CachedExpression> g_expressions;
+std::unordered_map<int64_t, HandleEntry> g_handles;
+int64_t g_next_handle = 1;
+
+std::string ToString(const char* str) { return str ? str : ""; }
+
+// Returns the canonical name of |type|, or an empty string if the name
+// doesn't identify a definition.
+std::string GetTypeKey(lldb::SBType type) {
+  lldb::SBType canonical_type = type.GetCanonicalType();
+  std::string name = ToString(canonical_type.GetName());
+  if (name.empty() || name.find("(anonymous") != std::string::npos ||
+      name.find("(unnamed") != std::string::npos) {
+    return "";
+  }
+  return name + '\0' + std::to_string(canonical_type.GetByteSize());
+}
+
+uint32_t GetProcessId(lldb::SBTarget target) {
+  lldb::SBProcess process = target.GetProcess();
+  return process.IsValid() ? process.GetUniqueID() : 0;
+}
+
+// Adds the name that a module defining |type| finds it by to |scope|. That's
+// the canonical name of the type, or of the type that it points or refers to
+// or is an array of.
+void AddTypeName(lldb::SBType type, ExpressionScope* scope) {
+  lldb::SBType canonical_type = type.GetCanonicalType();
+  while (canonical_type.IsPointerType() || canonical_type.IsReferenceType() ||
+         canonical_type.IsArrayType()) {
+    if (canonical_type.IsPointerType()) {
+      canonical_type = canonical_type.GetPointeeType();
+    } else if (canonical_type.IsReferenceType()) {
+      canonical_type = canonical_type.GetDereferencedType();
+    } else {
+      canonical_type = canonical_type.GetArrayElementType();
+    }
+    canonical_type = canonical_type.GetCanonicalType();
+  }
+  canonical_type = canonical_type.GetUnqualifiedType();
+  if (canonical_type.GetBasicType() != lldb::eBasicTypeInvalid) {
+    return;
+  }
+  std::string name = ToString(canonical_type.GetName());
+  if (name.empty() || name.find("(anonymous") != std::string::npos ||
+      name.find("(unnamed") != std::string::npos) {
+    scope->any_module = true;
+    return;
+  }
+  scope->type_names.push_back(std::move(name));
+}
+
+ExpressionScope GetExpressionScope(
+    lldb::SBTarget target, lldb::SBType scope,
+    const std::vector<lldb_eval::ContextArgument>& args,
+    const std::shared_ptr<lldb_eval::CompiledExpr>& compiled) {
+  ExpressionScope expression_scope;
+  expression_scope.process_id = GetProcessId(target);
+  AddTypeName(scope, &expression_scope);
+  for (const lldb_eval::ContextArgument& arg : args) {
+    AddTypeName(arg.type, &expression_scope);
+  }
+  if (compiled != nullptr) {
+    AddTypeName(compiled->result_type, &expression_scope);
+  }
+  return expression_scope;
+}
+
+// Returns the registry key of the expression, or an empty string if it can't
+// be cached.
+std::string GetExpressionKey(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args) {
+  // The same type name can mean different types in different targets, so the
+  // key starts with the unique ID of the target's process. Unlike target
+  // indices, the IDs aren't reused.
+  uint32_t process_id = GetProcessId(target);
+  std::string scope_key = GetTypeKey(scope);
+  if (process_id == 0 || scope_key.empty()) {
+    return "";
+  }
+  std::string key =
+      std::to_string(process_id) + '\0' + scope_key + '\0' + expression;
+
+  // The order of the arguments doesn't change the compiled expression.
+  std::vector<std::pair<std::string, std::string>> arg_keys;
+  arg_keys.reserve(args.size());
+  for (const lldb_eval::ContextArgument& arg : args) {
+    std::string type_key = GetTypeKey(arg.type);
+    if (type_key.empty()) {
+      return "";
+    }
+    arg_keys.emplace_back(ToString(arg.name), std::move(type_key));
+  }
+  std::sort(arg_keys.begin(), arg_keys.end());
+  for (const auto& arg_key : arg_keys) {
+    key += '\0' + arg_key.first + '\0' + arg_key.second;
+  }
+  return key;
+}
+
+std::shared_ptr<lldb_eval::CompiledExpr> Compile(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args, lldb::SBError& error) {
+  // Compiled expressions are evaluated for NatVis, whose expressions are
+  // supposed to be idempotent. Thus side effects are not allowed.
+  lldb_eval::Options opts;
+  opts.allow_side_effects = false;
+  opts.context_args = {args.data(), args.size()};
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled =
+      lldb_eval::CompileExpression(target, scope, expression.c_str(), opts,
+                                   error);
+  if (error.Fail()) {
+    compiled.reset();
+  }
+  return compiled;
+}
+
+// Drops the cached expressions that have no live handle. Requires the lock.
+void EvictUnreferencedExpressions() {
+  for (auto it = g_expressions.begin(); it != g_expressions.end();) {
+    if (it->second.handle == 0) {
+      it = g_expressions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+// Returns a reference to the handle of the expression of |key|, and creates
+// the handle if the expression has none. Requires the lock.
+int64_t AcquireHandle(const std::string& key,
+                      std::shared_ptr<lldb_eval::CompiledExpr> compiled,
+                      const ExpressionScope& scope) {
+  auto expression_it =
+      key.empty() ? g_expressions.end() : g_expressions.find(key);
+  if (expression_it != g_expressions.end() &&
+      expression_it->second.handle != 0) {
+    auto handle_it = g_handles.find(expression_it->second.handle);
+    if (handle_it != g_handles.end()) {
+      ++handle_it->second.ref_count;
+      return handle_it->first;
+    }
+  }
+
+  int64_t handle = g_next_handle++;
+  g_handles.emplace(handle,
+                    HandleEntry{key, std::move(compiled), 1, scope, false});
+  if (expression_it != g_expressions.end()) {
+    expression_it->second.handle = handle;
+  }
+  return handle;
+}
+
+// Looks up the expression of |key|, or compiles and caches it. Returns the
+// cached entry by value, so it stays valid after the lock is released.
+CachedExpression FindOrCompile(
+    const std::string& key, lldb::SBTarget target, lldb::SBType scope,
+    const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args) {
+  {
+    msclr::lock lock(CompiledExpressionLock::instance);
+    auto it = g_expressions.find(key);
+    if (it != g_expressions.end()) {
+      return it->second;
+    }
+  }
+
+  // Compiled outside of the lock, so evaluations of other expressions aren't
+  // blocked. If two threads compile the same expression, the first one is
+  // kept.
+  CachedExpression entry{0, nullptr, lldb::SBError(), ExpressionScope()};
+  entry.compiled = Compile(target, scope, expression, args, entry.error);
+  entry.scope = GetExpressionScope(target, scope, args, entry.compiled);
+  msclr::lock lock(CompiledExpressionLock::instance);
+  auto it = g_expressions.find(key);
+  if (it != g_expressions.end()) {
+    return it->second;
+  }
+  if (g_expressions.size() >= kMaxCompiledExpressions) {
+    EvictUnreferencedExpressions();
+  }
+  g_expressions.emplace(key, entry);
+  return entry;
+}
+
+}  // namespace
+
+std::shared_ptr<lldb_eval::CompiledExpr> CompileExpressionHandle(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args, int64_t* handle,
+    lldb::SBError& error) {
+  std::string key = GetExpressionKey(target, scope, expression, args);
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled;
+  ExpressionScope expression_scope;
+  if (key.empty()) {
+    compiled = Compile(target, scope, expression, args, error);
+    expression_scope = GetExpressionScope(target, scope, args, compiled);
+  } else {
+    CachedExpression entry =
+        FindOrCompile(key, target, scope, expression, args);
+    error = entry.error;
+    compiled = entry.compiled;
+    expression_scope = std::move(entry.scope);
+  }
+
+  if (compiled == nullptr) {
+    *handle = 0;
+    return nullptr;
+  }
+  msclr::lock lock(CompiledExpressionLock::instance);
+  *handle = AcquireHandle(key, compiled, expression_scope);
+  return compiled;
+}
+
+std::shared_ptr<lldb_eval::CompiledExpr> FindOrCompileExpression(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args, lldb::SBError& error) {
+  std::string key = GetExpressionKey(target, scope, expression, args);
+  if (key.empty()) {
+    return Compile(target, scope, expression, args, error);
+  }
+
+  CachedExpression entry = FindOrCompile(key, target, scope, expression, args);
+  error = entry.error;
+  return entry.compiled;
+}
+
+std::shared_ptr<lldb_eval::CompiledExpr> GetCompiledExpression(
+    int64_t handle, CompiledExpressionState* state) {
+  msclr::lock lock(CompiledExpressionLock::instance);
+  auto it = g_handles.find(handle);
+  if (it == g_handles.end()) {
+    *state = CompiledExpressionState::kReleased;
+    return nullptr;
+  }
+  *state = it->second.stale ? CompiledExpressionState::kStale
+                            : CompiledExpressionState::kLive;
+  return it->second.compiled;
+}
+
+void ReleaseCompiledExpression(int64_t handle) {
+  msclr::lock lock(CompiledExpressionLock::instance);
+  auto it = g_handles.find(handle);
+  if (it == g_handles.end() || --it->second.ref_count > 0) {
+    return;
+  }
+  // The expression stays cached, but can be evicted from now on.
+  if (!it->second.key.empty()) {
+    auto expression_it = g_expressions.find(it->second.key);
+    if (expression_it != g_expressions.end() &&
+        expression_it->second.handle == handle) {
+      expression_it->second.handle = 0;
+    }
+  }
+  g_handles.erase(it);
+}
+
+void EvictCompiledExpressions(lldb::SBTarget target,
+                              const std::vector<lldb::SBModule>& modules) {
+  uint32_t process_id = GetProcessId(target);
+  if (process_id == 0 || modules.empty()) {
+    return;
+  }
+
+  // Collect the type names of the process first, and look them up in the
+  // modules without the lock, so evaluations aren't blocked meanwhile.
+  std::unordered_set<std::string> type_names;
+  {
+    msclr::lock lock(CompiledExpressionLock::instance);
+    for (const auto& expression : g_expressions) {
+      if (expression.second.scope.process_id == process_id) {
+        type_names.insert(expression.second.scope.type_names.begin(),
+                          expression.second.scope.type_names.end());
+      }
+    }
+    for (const auto& handle : g_handles) {
+      if (handle.second.scope.process_id == process_id) {
+        type_names.insert(handle.second.scope.type_names.begin(),
+                          handle.second.scope.type_names.end());
+      }
+    }
+  }
+  std::unordered_set<std::string> module_type_names;
+  for (const std::string& name : type_names) {
+    for (lldb::SBModule module : modules) {
+      if (module.FindFirstType(name.c_str()).IsValid()) {
+        module_type_names.insert(name);
+        break;
+      }
+    }
+  }
+
+  auto uses_modules = [&](const ExpressionScope& scope) {
+    return scope.any_module ||
+           std::any_of(scope.type_names.begin(), scope.type_names.end(),
+                       [&](const std::string& name) {
+                         return module_type_names.count(name) > 0;
+                       });
+  };
+
+  msclr::lock lock(CompiledExpressionLock::instance);
+  for (auto it = g_expressions.begin(); it != g_expressions.end();) {
+    // Failed compilations are dropped too, since the types they were missing
+    // may be defined now.
+    if (it->second.scope.process_id == process_id &&
+        (it->second.compiled == nullptr || uses_modules(it->second.scope))) {
+      it = g_expressions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto& handle : g_handles) {
+    if (handle.second.scope.process_id == process_id && !handle.second.stale &&
+        uses_modules(handle.second.scope)) {
+      handle.second.stale = true;
+      handle.second.compiled.reset();
+    }
+  }
+}
+
+void ForgetCompiledExpressions(lldb::SBProcess process) {
+  uint32_t process_id = process.GetUniqueID();
+  msclr::lock lock(CompiledExpressionLock::instance);
+  for (auto it = g_expressions.begin(); it != g_expressions.end();) {
+    if (it->second.scope.process_id == process_id) {
+      it = g_expressions.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto& handle : g_handles) {
+    if (handle.second.scope.process_id == process_id) {
+      handle.second.stale = true;
+      handle.second.compiled.reset();
+    }
+  }
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
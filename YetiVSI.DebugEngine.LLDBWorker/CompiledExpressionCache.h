@@ -0,0 +1,88 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lldb-eval/api.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
+#include "lldb/API/SBType.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+enum class CompiledExpressionState {
+  kLive,
+  // The handle was never returned, or every reference to it was released.
+  kReleased,
+  // The expression was evicted while the handle was live. The handle must
+  // still be released.
+  kStale,
+};
+
+// Compiles |expression| without side effects in the scope of |scope|, with
+// |args| as context arguments, and returns a handle to the compiled
+// expression. Expressions are compiled once per process of |target|,
+// canonical scope type name and size, expression text and context argument
+// types. Later calls return the same handle while it is live. Every call that
+// returns a handle must be paired with a ReleaseCompiledExpression() call.
+// Returns nullptr and sets |error| if compilation fails, in which case
+// |handle| is 0.
+std::shared_ptr<lldb_eval::CompiledExpr> CompileExpressionHandle(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args, int64_t* handle,
+    lldb::SBError& error);
+
+// Like CompileExpressionHandle(), but doesn't create a handle for expressions
+// in the scope of unnamed types, which can't be cached. Failed compilations
+// are cached as well.
+std::shared_ptr<lldb_eval::CompiledExpr> FindOrCompileExpression(
+    lldb::SBTarget target, lldb::SBType scope, const std::string& expression,
+    const std::vector<lldb_eval::ContextArgument>& args, lldb::SBError& error);
+
+// Returns the expression of |handle| and sets |state| to kLive. Returns
+// nullptr if the handle was released or is stale, and sets |state| to say
+// which.
+std::shared_ptr<lldb_eval::CompiledExpr> GetCompiledExpression(
+    int64_t handle, CompiledExpressionState* state);
+
+// Releases one reference to |handle|. The handle stays valid until every
+// CompileExpressionHandle() call that returned it is released. The expression
+// stays cached afterwards, but can be evicted.
+void ReleaseCompiledExpression(int64_t handle);
+
+// Evicts the expressions of the process of |target| that use types defined in
+// |modules|, and the failed compilations of the process. Called when
+// |modules| are unloaded or their symbols are loaded, since either can change
+// those types. Live handles of evicted expressions become stale. Expressions
+// of other processes, and of types that |modules| don't define, are kept.
+void EvictCompiledExpressions(lldb::SBTarget target,
+                              const std::vector<lldb::SBModule>& modules);
+
+// Evicts all expressions of |process|, which exited. Its live handles become
+// stale.
+void ForgetCompiledExpressions(lldb::SBProcess process);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,449 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma managed(on)
+
+#include "DisassemblyCache.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBData.h"
+#include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBFileSpec.h"
+#include "lldb/API/SBFrame.h"
+#include "lldb/API/SBFunction.h"
+#include "lldb/API/SBInstruction.h"
+#include "lldb/API/SBInstructionList.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBSymbol.h"
+#include "lldb/API/SBThread.h"
+
+#include "AddressLineTable.h"
+#include "ParallelUtil.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the range cache and the prefetch flavors, which are used from
+// concurrent RPC threads and prefetch work.
+// <mutex> is not available when compiling with /clr.
+private
+ref class DisassemblyCacheLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+constexpr uint64_t kPageSize = 4096;
+constexpr uint64_t kMaxOpcodeSize = 15;
+// The cache is dropped as a whole when it grows past this many ranges.
+constexpr size_t kMaxCachedRanges = 1024;
+// Number of frames of the selected thread whose code is prefetched on a stop.
+constexpr uint32_t kPrefetchFrameCount = 4;
+
+// Module UUID, symbol file, start and end load address of the function or
+// symbol, and flavor. Load addresses stay the same while the module is loaded,
+// so entries are reused across stops. The symbol file changes when symbols are
+// loaded for the module, which adds functions and line entries to its code.
+using RangeKey =
+    std::tuple<std::string, std::string, uint64_t, uint64_t, std::string>;
+
+// A disassembled range and the stop at which its bytes last matched memory.
+struct CachedRange {
+  std::shared_ptr<const DisassemblyRange> range;
+  uint32_t process_id = 0;
+  uint32_t stop_id = 0;
+};
+
+std::map<RangeKey, CachedRange> g_ranges;
+
+// Flavor of the last disassembly by debugger ID. Stops of debuggers that have
+// disassembled code are prefetched with it.
+std::map<uint64_t, std::string> g_prefetch_flavors;
+
+// A function, or a symbol of code without debug info, that is disassembled and
+// cached as a whole.
+struct CodeRange {
+  lldb::SBFunction function;
+  lldb::SBSymbol symbol;
+  RangeKey key;
+  // False if the module has no UUID, so the key doesn't identify its code.
+  bool cacheable = false;
+};
+
+std::string ToString(const char* str) { return str ? str : ""; }
+
+// Appends instructions to a range, storing every line entry and symbol once.
+class RangeBuilder {
+ public:
+  explicit RangeBuilder(DisassemblyRange* range) : range_(range) {}
+
+  void Add(lldb::SBTarget target, lldb::SBInstruction instruction) {
+    lldb::SBAddress address = instruction.GetAddress();
+    DisassembledInstruction result;
+    result.address = address.GetLoadAddress(target);
+    result.size = static_cast<uint32_t>(instruction.GetByteSize());
+    lldb::SBData data = instruction.GetData(target);
+    result.bytes.resize(data.GetByteSize());
+    if (!result.bytes.empty()) {
+      lldb::SBError error;
+      data.ReadRawData(error, 0, result.bytes.data(), result.bytes.size());
+    }
+    result.mnemonic = ToString(instruction.GetMnemonic(target));
+    result.operands = ToString(instruction.GetOperands(target));
+    result.comment = ToString(instruction.GetComment(target));
+
+    ResolvedLineEntry line_entry;
+    if (ResolveLineEntry(address, &line_entry)) {
+      result.line_entry_index =
+          AddLineEntry({std::move(line_entry.file_name),
+                        std::move(line_entry.directory), line_entry.line,
+                        line_entry.column});
+    }
+    lldb::SBSymbol symbol = address.GetSymbol();
+    if (symbol.IsValid()) {
+      result.symbol_index =
+          AddSymbol({ToString(symbol.GetName()),
+                     symbol.GetStartAddress().GetLoadAddress(target)});
+    }
+    range_->instructions.push_back(std::move(result));
+  }
+
+  // Adds an instruction of another range.
+  void Add(const DisassemblyRange& source,
+           const DisassembledInstruction& instruction) {
+    DisassembledInstruction result = instruction;
+    if (instruction.line_entry_index >= 0) {
+      result.line_entry_index =
+          AddLineEntry(source.line_entries[instruction.line_entry_index]);
+    }
+    if (instruction.symbol_index >= 0) {
+      result.symbol_index =
+          AddSymbol(source.symbols[instruction.symbol_index]);
+    }
+    range_->instructions.push_back(std::move(result));
+  }
+
+ private:
+  int32_t AddLineEntry(const DisassemblyLineEntry& line_entry) {
+    auto key = std::make_tuple(line_entry.file_name, line_entry.directory,
+                               line_entry.line, line_entry.column);
+    auto it = line_entry_indices_.find(key);
+    if (it != line_entry_indices_.end()) {
+      return it->second;
+    }
+    int32_t index = static_cast<int32_t>(range_->line_entries.size());
+    range_->line_entries.push_back(line_entry);
+    line_entry_indices_.emplace(std::move(key), index);
+    return index;
+  }
+
+  int32_t AddSymbol(const DisassemblySymbol& symbol) {
+    auto key = std::make_pair(symbol.name, symbol.start_address);
+    auto it = symbol_indices_.find(key);
+    if (it != symbol_indices_.end()) {
+      return it->second;
+    }
+    int32_t index = static_cast<int32_t>(range_->symbols.size());
+    range_->symbols.push_back(symbol);
+    symbol_indices_.emplace(std::move(key), index);
+    return index;
+  }
+
+  DisassemblyRange* range_;
+  std::map<std::tuple<std::string, std::string, uint32_t, uint32_t>, int32_t>
+      line_entry_indices_;
+  std::map<std::pair<std::string, uint64_t>, int32_t> symbol_indices_;
+};
+
+bool GetCodeRange(lldb::SBTarget target, lldb::SBAddress address,
+                  const std::string& flavor, CodeRange* range) {
+  lldb::SBModule module = address.GetModule();
+  if (!module.IsValid()) {
+    return false;
+  }
+  lldb::SBAddress start;
+  lldb::SBAddress end;
+  range->function = address.GetFunction();
+  if (range->function.IsValid()) {
+    start = range->function.GetStartAddress();
+    end = range->function.GetEndAddress();
+  } else {
+    range->symbol = address.GetSymbol();
+    if (!range->symbol.IsValid()) {
+      return false;
+    }
+    start = range->symbol.GetStartAddress();
+    end = range->symbol.GetEndAddress();
+  }
+  uint64_t start_load = start.GetLoadAddress(target);
+  uint64_t end_load = end.GetLoadAddress(target);
+  if (start_load == LLDB_INVALID_ADDRESS || end_load == LLDB_INVALID_ADDRESS ||
+      end_load <= start_load) {
+    return false;
+  }
+  std::string uuid = ToString(module.GetUUIDString());
+  lldb::SBFileSpec symbol_file = module.GetSymbolFileSpec();
+  std::string symbol_path = ToString(symbol_file.GetDirectory()) + "/" +
+                            ToString(symbol_file.GetFilename());
+  range->cacheable = !uuid.empty();
+  range->key = std::make_tuple(std::move(uuid), std::move(symbol_path),
+                               start_load, end_load, flavor);
+  return true;
+}
+
+// Returns true if the bytes of |range| are still in memory. Code can be patched
+// at runtime, e.g. by hot patching or JIT compilers.
+bool MatchesMemory(lldb::SBProcess process, const DisassemblyRange& range) {
+  const DisassembledInstruction& first = range.instructions.front();
+  const DisassembledInstruction& last = range.instructions.back();
+  std::vector<uint8_t> memory(last.address + last.size - first.address);
+  lldb::SBError error;
+  if (process.ReadMemory(first.address, memory.data(), memory.size(), error) !=
+      memory.size()) {
+    return false;
+  }
+  for (const DisassembledInstruction& instruction : range.instructions) {
+    if (!std::equal(instruction.bytes.begin(), instruction.bytes.end(),
+                    memory.begin() + (instruction.address - first.address))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the cached range for |key|. The bytes of an entry are compared with
+// memory the first time it is used in a stop, and a stale entry is dropped.
+std::shared_ptr<const DisassemblyRange> FindCachedRange(lldb::SBProcess process,
+                                                        const RangeKey& key,
+                                                        uint32_t stop_id) {
+  uint32_t process_id = process.GetUniqueID();
+  std::shared_ptr<const DisassemblyRange> range;
+  {
+    msclr::lock lock(DisassemblyCacheLock::instance);
+    auto it = g_ranges.find(key);
+    if (it == g_ranges.end()) {
+      return nullptr;
+    }
+    if (it->second.process_id == process_id &&
+        it->second.stop_id == stop_id) {
+      return it->second.range;
+    }
+    range = it->second.range;
+  }
+
+  // Memory is read without the lock, so other ranges can be served meanwhile.
+  bool matches = MatchesMemory(process, *range);
+  bool stopped = process.GetStopID() == stop_id &&
+                 process.GetState() == lldb::eStateStopped;
+  msclr::lock lock(DisassemblyCacheLock::instance);
+  auto it = g_ranges.find(key);
+  if (it == g_ranges.end() || it->second.range != range) {
+    return matches ? range : nullptr;
+  }
+  if (!matches) {
+    g_ranges.erase(it);
+    return nullptr;
+  }
+  if (stopped) {
+    it->second.process_id = process_id;
+    it->second.stop_id = stop_id;
+  }
+  return range;
+}
+
+// Returns the cached disassembly of |range|, which must be cacheable,
+// disassembling it if needed. The result is only cached if it isn't empty and
+// the process hasn't resumed since |stop_id|, since the code may have been read
+// while it was running.
+std::shared_ptr<const DisassemblyRange> GetCachedRange(lldb::SBTarget target,
+                                                       const CodeRange& range,
+                                                       uint32_t stop_id) {
+  lldb::SBProcess process = target.GetProcess();
+  std::shared_ptr<const DisassemblyRange> cached =
+      FindCachedRange(process, range.key, stop_id);
+  if (cached) {
+    return cached;
+  }
+
+  const std::string& flavor = std::get<4>(range.key);
+  auto result = std::make_shared<DisassemblyRange>();
+  RangeBuilder builder(result.get());
+  lldb::SBInstructionList instructions =
+      range.function.IsValid()
+          ? range.function.GetInstructions(target, flavor.c_str())
+          : range.symbol.GetInstructions(target, flavor.c_str());
+  size_t size = instructions.GetSize();
+  result->instructions.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    builder.Add(target, instructions.GetInstructionAtIndex(i));
+  }
+
+  if (result->instructions.empty() || process.GetStopID() != stop_id ||
+      process.GetState() != lldb::eStateStopped) {
+    return result;
+  }
+  msclr::lock lock(DisassemblyCacheLock::instance);
+  if (g_ranges.size() >= kMaxCachedRanges) {
+    g_ranges.clear();
+  }
+  CachedRange& entry = g_ranges[range.key];
+  entry.range = result;
+  entry.process_id = process.GetUniqueID();
+  entry.stop_id = stop_id;
+  return result;
+}
+
+void Prefetch(lldb::SBProcess process, const std::string& flavor,
+              uint32_t stop_id) {
+  lldb::SBTarget target = process.GetTarget();
+  lldb::SBThread thread = process.GetSelectedThread();
+  // Frames are fetched one by one, since counting them unwinds the whole stack.
+  for (uint32_t i = 0; i < kPrefetchFrameCount; ++i) {
+    if (process.GetStopID() != stop_id) {
+      return;
+    }
+    lldb::SBFrame frame = thread.GetFrameAtIndex(i);
+    if (!frame.IsValid()) {
+      return;
+    }
+    // Return addresses point past the call, which may be the start of the
+    // next function, so the call instruction is looked up instead.
+    uint64_t pc = frame.GetPC();
+    if (i > 0 && pc > 0) {
+      --pc;
+    }
+    CodeRange range;
+    if (GetCodeRange(target, target.ResolveLoadAddress(pc), flavor, &range) &&
+        range.cacheable) {
+      GetCachedRange(target, range, stop_id);
+    }
+  }
+}
+
+// Reads and decodes memory at |address| for up to |count| instructions.
+void AddFromMemory(lldb::SBTarget target, uint64_t address, uint32_t count,
+                   const std::string& flavor, RangeBuilder* builder) {
+  lldb::SBProcess process = target.GetProcess();
+  uint64_t end = address + count * kMaxOpcodeSize;
+  std::vector<uint8_t> buffer(end - address);
+  uint64_t read_end = address;
+  // Read page by page so a read stops at the first unreadable page.
+  while (read_end < end) {
+    uint64_t chunk_end = std::min(end, (read_end / kPageSize + 1) * kPageSize);
+    lldb::SBError error;
+    size_t read =
+        process.ReadMemory(read_end, buffer.data() + (read_end - address),
+                           chunk_end - read_end, error);
+    read_end += read;
+    if (read_end != chunk_end) {
+      break;
+    }
+  }
+  if (read_end == address) {
+    return;
+  }
+
+  lldb::SBInstructionList instructions = target.GetInstructionsWithFlavor(
+      target.ResolveLoadAddress(address), flavor.c_str(), buffer.data(),
+      read_end - address);
+  size_t size = std::min<size_t>(instructions.GetSize(), count);
+  for (size_t i = 0; i < size; ++i) {
+    builder->Add(target, instructions.GetInstructionAtIndex(i));
+  }
+}
+
+}  // namespace
+
+DisassemblyRange DisassembleRange(lldb::SBTarget target, uint64_t address,
+                                  uint32_t count, const std::string& flavor) {
+  {
+    msclr::lock lock(DisassemblyCacheLock::instance);
+    g_prefetch_flavors[target.GetDebugger().GetID()] = flavor;
+  }
+  uint32_t stop_id = target.GetProcess().GetStopID();
+  DisassemblyRange result;
+  RangeBuilder builder(&result);
+  uint64_t current = address;
+  while (result.instructions.size() < count) {
+    size_t previous_size = result.instructions.size();
+    uint32_t left = count - static_cast<uint32_t>(previous_size);
+    // Code of modules without a UUID isn't cached. Only the requested
+    // instructions are decoded from memory below, rather than the whole
+    // function.
+    CodeRange range;
+    if (GetCodeRange(target, target.ResolveLoadAddress(current), flavor,
+                     &range) &&
+        range.cacheable) {
+      std::shared_ptr<const DisassemblyRange> cached =
+          GetCachedRange(target, range, stop_id);
+      auto it = std::lower_bound(
+          cached->instructions.begin(), cached->instructions.end(), current,
+          [](const DisassembledInstruction& instruction, uint64_t address) {
+            return instruction.address < address;
+          });
+      // Addresses that aren't instruction boundaries of the range are
+      // decoded from memory below, like LLDB would.
+      for (; it != cached->instructions.end() && it->address == current &&
+             result.instructions.size() < count;
+           ++it) {
+        builder.Add(*cached, *it);
+        current = it->address + it->size;
+      }
+    }
+    if (result.instructions.size() == previous_size) {
+      AddFromMemory(target, current, left, flavor, &builder);
+    }
+    if (result.instructions.size() == previous_size ||
+        result.instructions.back().size == 0) {
+      break;
+    }
+    const DisassembledInstruction& last = result.instructions.back();
+    current = last.address + last.size;
+  }
+  return result;
+}
+
+void PrefetchDisassembly(lldb::SBProcess process) {
+  std::string flavor;
+  {
+    msclr::lock lock(DisassemblyCacheLock::instance);
+    auto it =
+        g_prefetch_flavors.find(process.GetTarget().GetDebugger().GetID());
+    if (it == g_prefetch_flavors.end()) {
+      return;
+    }
+    flavor = it->second;
+  }
+  uint32_t stop_id = process.GetStopID();
+  RunInBackground(
+      [process, flavor, stop_id]() { Prefetch(process, flavor, stop_id); });
+}
+
+void ClearDisassembly() {
+  msclr::lock lock(DisassemblyCacheLock::instance);
+  g_ranges.clear();
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
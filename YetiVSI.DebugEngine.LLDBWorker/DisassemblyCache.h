@@ -0,0 +1,82 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+struct DisassembledInstruction {
+  uint64_t address = 0;
+  uint32_t size = 0;
+  std::vector<uint8_t> bytes;
+  std::string mnemonic;
+  std::string operands;
+  std::string comment;
+  // Indices into DisassemblyRange::line_entries and symbols, -1 if none.
+  int32_t line_entry_index = -1;
+  int32_t symbol_index = -1;
+};
+
+struct DisassemblyLineEntry {
+  std::string file_name;
+  std::string directory;
+  uint32_t line = 0;
+  uint32_t column = 0;
+};
+
+struct DisassemblySymbol {
+  std::string name;
+  uint64_t start_address = 0;
+};
+
+// Instructions with their line entries and symbols, which are stored once and
+// referenced by index.
+struct DisassemblyRange {
+  std::vector<DisassembledInstruction> instructions;
+  std::vector<DisassemblyLineEntry> line_entries;
+  std::vector<DisassemblySymbol> symbols;
+};
+
+// Disassembles up to |count| instructions starting at the load address
+// |address|. Stops early at memory that can't be read or bytes that don't
+// decode, so the result may be empty. Functions, or symbols without debug
+// info, are disassembled as a whole and cached by module UUID, symbol file,
+// load address range and flavor. Code of modules without a UUID isn't cached,
+// and only the requested instructions are decoded. A cached range is checked
+// against memory once per stop, so code patched at runtime is disassembled
+// again. Later stops of the process prefetch with |flavor|.
+DisassemblyRange DisassembleRange(lldb::SBTarget target, uint64_t address,
+                                  uint32_t count, const std::string& flavor);
+
+// Disassembles and caches the code of the top frames of the selected thread on
+// the thread pool, if the debugger of |process| has disassembled code before.
+// Results are dropped if the process resumes in the meantime.
+void PrefetchDisassembly(lldb::SBProcess process);
+
+// Drops all cached ranges. Called when modules are unloaded or symbols are
+// loaded, since either can change the functions and line entries of an address.
+void ClearDisassembly();
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,171 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma managed(on)
+
+#include "FlatTypeLayout.h"
+
+#include <msclr/lock.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the layout registry. <mutex> is not available when compiling with
+// /clr.
+private
+ref class FlatTypeLayoutLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// Layouts by canonical type name and byte size. The size tells apart most
+// types that have the same name in different modules.
+std::unordered_map<std::string, std::shared_ptr<const FlatTypeLayout>>
+    g_layouts;
+
+std::string ToString(const char* str) { return str ? str : ""; }
+
+// Assigns consecutive ids to distinct strings.
+class StringTable {
+ public:
+  explicit StringTable(std::vector<std::string>* strings)
+      : strings_(strings) {}
+
+  uint32_t GetId(const std::string& str) {
+    auto it = ids_.find(str);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings_->size());
+    strings_->push_back(str);
+    ids_.emplace(str, id);
+    return id;
+  }
+
+ private:
+  std::vector<std::string>* strings_;
+  std::unordered_map<std::string, uint32_t> ids_;
+};
+
+bool IsAnonymousRecord(lldb::SBTypeMember member) {
+  if (member.GetName() && *member.GetName()) {
+    return false;
+  }
+  lldb::TypeClass type_class =
+      member.GetType().GetCanonicalType().GetTypeClass();
+  return type_class == lldb::eTypeClassStruct ||
+         type_class == lldb::eTypeClassUnion ||
+         type_class == lldb::eTypeClassClass;
+}
+
+void AppendFields(lldb::SBType type, uint64_t base_bit_offset,
+                  StringTable* names, StringTable* type_names,
+                  std::vector<FlatTypeLayoutField>* fields,
+                  bool* has_virtual_bases) {
+  type = type.GetCanonicalType();
+  // The direct bases include the virtual ones. Their offset is that of the
+  // complete object of |type|, which is wrong when |type| is itself a base,
+  // so they are skipped. The virtual bases are told apart by type.
+  std::unordered_set<std::string> virtual_bases;
+  uint32_t num_virtual_bases = type.GetNumberOfVirtualBaseClasses();
+  for (uint32_t i = 0; i < num_virtual_bases; ++i) {
+    virtual_bases.insert(ToString(type.GetVirtualBaseClassAtIndex(i)
+                                      .GetType()
+                                      .GetCanonicalType()
+                                      .GetName()));
+  }
+  if (num_virtual_bases > 0) {
+    *has_virtual_bases = true;
+  }
+  uint32_t num_bases = type.GetNumberOfDirectBaseClasses();
+  for (uint32_t i = 0; i < num_bases; ++i) {
+    lldb::SBTypeMember base = type.GetDirectBaseClassAtIndex(i);
+    lldb::SBType base_type = base.GetType().GetCanonicalType();
+    if (virtual_bases.count(ToString(base_type.GetName())) > 0) {
+      continue;
+    }
+    AppendFields(base_type, base_bit_offset + base.GetOffsetInBits(), names,
+                 type_names, fields, has_virtual_bases);
+  }
+  uint32_t num_fields = type.GetNumberOfFields();
+  for (uint32_t i = 0; i < num_fields; ++i) {
+    lldb::SBTypeMember member = type.GetFieldAtIndex(i);
+    uint64_t bit_offset = base_bit_offset + member.GetOffsetInBits();
+    if (IsAnonymousRecord(member)) {
+      AppendFields(member.GetType(), bit_offset, names, type_names, fields,
+                   has_virtual_bases);
+      continue;
+    }
+    lldb::SBType member_type = member.GetType();
+    FlatTypeLayoutField field = {};
+    field.name_id = names->GetId(ToString(member.GetName()));
+    field.type_id = type_names->GetId(ToString(member_type.GetName()));
+    field.offset = bit_offset / 8;
+    field.size = member_type.GetByteSize();
+    if (member.IsBitfield()) {
+      field.bitfield_bit_offset = static_cast<uint32_t>(bit_offset % 8);
+      field.bitfield_bit_size = member.GetBitfieldSizeInBits();
+    }
+    fields->push_back(field);
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<FlatTypeLayout> FlatTypeLayout::Build(lldb::SBType type) {
+  auto layout = std::make_unique<FlatTypeLayout>();
+  layout->byte_size_ = type.GetByteSize();
+  StringTable names(&layout->names_);
+  StringTable type_names(&layout->type_names_);
+  AppendFields(type, 0, &names, &type_names, &layout->fields_,
+               &layout->has_virtual_bases_);
+  return layout;
+}
+
+std::shared_ptr<const FlatTypeLayout> GetTypeLayout(lldb::SBType type) {
+  lldb::SBType canonical_type = type.GetCanonicalType();
+  std::string name = ToString(canonical_type.GetName());
+  // Unnamed types don't identify a definition.
+  if (name.empty() || name.find("(anonymous") != std::string::npos ||
+      name.find("(unnamed") != std::string::npos) {
+    return nullptr;
+  }
+  std::string key = name + '\0' + std::to_string(canonical_type.GetByteSize());
+  {
+    msclr::lock lock(FlatTypeLayoutLock::instance);
+    auto it = g_layouts.find(key);
+    if (it != g_layouts.end()) {
+      return it->second;
+    }
+  }
+  // Built outside of the lock. If two threads build the same layout, the
+  // first one is kept.
+  std::shared_ptr<const FlatTypeLayout> layout =
+      FlatTypeLayout::Build(canonical_type);
+  msclr::lock lock(FlatTypeLayoutLock::instance);
+  return g_layouts.emplace(key, std::move(layout)).first->second;
+}
+
+void ClearTypeLayouts() {
+  msclr::lock lock(FlatTypeLayoutLock::instance);
+  g_layouts.clear();
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
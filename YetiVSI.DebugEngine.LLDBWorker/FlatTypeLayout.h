@@ -0,0 +1,78 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBType.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+struct FlatTypeLayoutField {
+  // Index into FlatTypeLayout::GetNames().
+  uint32_t name_id;
+  // Index into FlatTypeLayout::GetTypeNames().
+  uint32_t type_id;
+  // Byte offset from the start of the outermost type.
+  uint64_t offset;
+  uint64_t size;
+  // Position of a bitfield within the byte at |offset|. Both are 0 for fields
+  // that aren't bitfields.
+  uint32_t bitfield_bit_offset;
+  uint32_t bitfield_bit_size;
+};
+
+// The data members of a type and of all its non-virtual base classes, with
+// their offsets in the type. Base class members come before the members of
+// the derived class, in declaration order, and members of anonymous structs
+// and unions are flattened into their parent. Members of virtual base
+// classes are not included, their offset is only known at runtime.
+class FlatTypeLayout {
+ public:
+  static std::unique_ptr<FlatTypeLayout> Build(lldb::SBType type);
+
+  uint64_t GetByteSize() const { return byte_size_; }
+  // True if the type or one of its bases has virtual bases, whose members are
+  // missing from the fields.
+  bool HasVirtualBases() const { return has_virtual_bases_; }
+  const std::vector<FlatTypeLayoutField>& GetFields() const { return fields_; }
+  const std::vector<std::string>& GetNames() const { return names_; }
+  const std::vector<std::string>& GetTypeNames() const { return type_names_; }
+
+ private:
+  uint64_t byte_size_ = 0;
+  bool has_virtual_bases_ = false;
+  std::vector<FlatTypeLayoutField> fields_;
+  std::vector<std::string> names_;
+  std::vector<std::string> type_names_;
+};
+
+// Returns the layout of |type|, which is built on first use. Layouts are
+// shared by all types with the same canonical name and size. Returns nullptr
+// for types without name.
+std::shared_ptr<const FlatTypeLayout> GetTypeLayout(lldb::SBType type);
+
+// Drops all layouts. Called when modules are unloaded or symbols are loaded,
+// since either can change the definition a type name resolves to.
+void ClearTypeLayouts();
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
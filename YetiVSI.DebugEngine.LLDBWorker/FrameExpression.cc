@@ -0,0 +1,180 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "FrameExpression.h"
+
+#include <cctype>
+#include <set>
+
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
+#include "lldb/API/SBThread.h"
+#include "lldb/API/SBType.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+namespace {
+
+// Returns the identifiers used in |expression|. Only these can refer to frame
+// variables, so they are the only ones passed to lldb-eval as context.
+std::set<std::string> GetIdentifiers(const std::string& expression) {
+  std::set<std::string> identifiers;
+  size_t i = 0;
+  while (i < expression.size()) {
+    unsigned char c = expression[i];
+    if (std::isdigit(c)) {
+      // Skip numeric literals including suffixes, e.g. 10ull or 0x1f.
+      while (i < expression.size() &&
+             (std::isalnum(static_cast<unsigned char>(expression[i])) ||
+              expression[i] == '_' || expression[i] == '.')) {
+        ++i;
+      }
+    } else if (std::isalpha(c) || c == '_') {
+      size_t start = i;
+      while (i < expression.size() &&
+             (std::isalnum(static_cast<unsigned char>(expression[i])) ||
+              expression[i] == '_')) {
+        ++i;
+      }
+      identifiers.insert(expression.substr(start, i - start));
+    } else {
+      ++i;
+    }
+  }
+  return identifiers;
+}
+
+// Returns a key that changes when the module containing |location| is
+// reloaded or rebuilt.
+std::string GetModuleKey(lldb::SBBreakpointLocation location) {
+  lldb::SBModule module = location.GetAddress().GetModule();
+  const char* uuid = module.IsValid() ? module.GetUUIDString() : nullptr;
+  return std::string(uuid ? uuid : "") + "@" +
+         std::to_string(location.GetLoadAddress());
+}
+
+}  // namespace
+
+FrameExpression::FrameExpression(std::string expression)
+    : expression_(std::move(expression)) {}
+
+lldb::SBValue FrameExpression::Evaluate(lldb::SBFrame frame,
+                                        lldb::SBBreakpointLocation location,
+                                        lldb::SBError& error) {
+  std::string module_key = GetModuleKey(location);
+  if (module_key != module_key_) {
+    module_key_ = module_key;
+    compiled_.reset();
+    compile_failed_ = false;
+    compiled_verified_ = false;
+  }
+  if (!compiled_ && !compile_failed_) {
+    Compile(frame);
+  }
+
+  lldb::SBValue result;
+  if (compiled_) {
+    result = EvaluateCompiled(frame, error);
+    if (error.Fail() && !compiled_verified_) {
+      // The error is either a legit runtime error (e.g. dereferencing null) or
+      // caused by a compiled form that doesn't match the frame. Only the latter
+      // is fixed by evaluating from source, in which case the compiled form is
+      // dropped for good. This is checked once: if the source fails as well,
+      // later errors of the compiled form are taken as runtime errors.
+      lldb::SBError source_error;
+      lldb::SBValue source_result = lldb_eval::EvaluateExpression(
+          frame, expression_.c_str(), source_error);
+      if (source_error.Success()) {
+        compiled_.reset();
+        compile_failed_ = true;
+        result = source_result;
+        error = source_error;
+      } else {
+        compiled_verified_ = true;
+      }
+    }
+  } else {
+    result = lldb_eval::EvaluateExpression(frame, expression_.c_str(), error);
+  }
+  return result;
+}
+
+void FrameExpression::Compile(lldb::SBFrame frame) {
+  compiled_.reset();
+  compile_failed_ = true;
+  compiled_verified_ = false;
+  arg_names_.clear();
+  has_this_ = false;
+
+  lldb::SBType scope;
+  lldb::SBValue this_value = frame.FindVariable("this");
+  if (this_value.IsValid() && this_value.GetType().IsPointerType()) {
+    scope = this_value.GetType().GetPointeeType();
+    has_this_ = true;
+  }
+
+  std::vector<lldb::SBType> arg_types;
+  for (const std::string& name : GetIdentifiers(expression_)) {
+    if (name == "this") {
+      continue;
+    }
+    lldb::SBValue variable = frame.FindVariable(name.c_str());
+    if (variable.IsValid()) {
+      arg_names_.push_back(name);
+      arg_types.push_back(variable.GetType());
+    }
+  }
+  std::vector<lldb_eval::ContextArgument> args;
+  args.reserve(arg_names_.size());
+  for (size_t i = 0; i < arg_names_.size(); ++i) {
+    args.push_back({arg_names_[i].c_str(), arg_types[i]});
+  }
+
+  lldb_eval::Options opts;
+  opts.context_args = {args.data(), args.size()};
+
+  lldb::SBError error;
+  lldb::SBTarget target = frame.GetThread().GetProcess().GetTarget();
+  compiled_ = lldb_eval::CompileExpression(target, scope, expression_.c_str(),
+                                           opts, error);
+  if (error.Fail()) {
+    compiled_.reset();
+  }
+  compile_failed_ = compiled_ == nullptr;
+}
+
+lldb::SBValue FrameExpression::EvaluateCompiled(lldb::SBFrame frame,
+                                                lldb::SBError& error) {
+  std::vector<lldb_eval::ContextVariable> vars;
+  vars.reserve(arg_names_.size());
+  for (const std::string& name : arg_names_) {
+    vars.push_back({name.c_str(), frame.FindVariable(name.c_str())});
+  }
+
+  lldb::SBValue scope;
+  if (has_this_) {
+    scope = frame.FindVariable("this").Dereference();
+  }
+
+  lldb_eval::Options opts;
+  opts.context_vars = {vars.data(), vars.size()};
+  return lldb_eval::EvaluateExpression(scope, compiled_, opts, error);
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lldb-eval/api.h"
+#include "lldb/API/SBBreakpointLocation.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBFrame.h"
+#include "lldb/API/SBValue.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Expression that is evaluated every time a breakpoint location is hit.
+//
+// The expression is compiled with lldb-eval on the first hit, using the
+// variables visible in the stopped frame as context arguments, and later hits
+// only evaluate the compiled expression. All hits of a location stop at the
+// same pc, so the set of visible variables and their types doesn't change. The
+// compiled expression is dropped when the module of the location changes.
+// Expressions that fail to compile are evaluated from source on every hit.
+class FrameExpression {
+ public:
+  explicit FrameExpression(std::string expression);
+
+  // Evaluates the expression in |frame|, which is stopped at |location|.
+  lldb::SBValue Evaluate(lldb::SBFrame frame,
+                         lldb::SBBreakpointLocation location,
+                         lldb::SBError& error);
+
+ private:
+  void Compile(lldb::SBFrame frame);
+  lldb::SBValue EvaluateCompiled(lldb::SBFrame frame, lldb::SBError& error);
+
+  std::string expression_;
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled_;
+  // Set when compilation failed for the current module, in which case the
+  // expression is evaluated from source.
+  bool compile_failed_ = false;
+  // Set once an error of the compiled expression was confirmed by evaluating
+  // the expression from source, see Evaluate.
+  bool compiled_verified_ = false;
+  // Identifies the module the expression was compiled for.
+  std::string module_key_;
+  // Whether the expression was compiled in the scope of `this`.
+  bool has_this_ = false;
+  // Names of the frame variables passed as context arguments.
+  std::vector<std::string> arg_names_;
+};
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
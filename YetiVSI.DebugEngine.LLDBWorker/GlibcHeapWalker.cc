@@ -0,0 +1,764 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "GlibcHeapWalker.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "AddressRangeUtil.h"
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBCommandInterpreter.h"
+#include "lldb/API/SBCommandReturnObject.h"
+#include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBMemoryRegionInfo.h"
+#include "lldb/API/SBMemoryRegionInfoList.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBSection.h"
+#include "lldb/API/SBSymbol.h"
+#include "lldb/API/SBSymbolContext.h"
+#include "lldb/API/SBSymbolContextList.h"
+#include "lldb/API/SBTarget.h"
+#include "lldb/API/SBThread.h"
+#include "lldb/API/SBType.h"
+#include "lldb/API/SBValue.h"
+#include "lldb/API/SBValueList.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+namespace {
+
+// Constants of the glibc malloc implementation on x86-64.
+constexpr uint64_t kSizeSz = 8;
+constexpr uint64_t kChunkHeaderSize = 2 * kSizeSz;
+constexpr uint64_t kMallocAlignment = 16;
+constexpr uint64_t kMinChunkSize = 32;
+constexpr uint64_t kPrevInUse = 0x1;
+constexpr uint64_t kIsMmapped = 0x2;
+constexpr uint64_t kSizeBits = 0x7;
+constexpr uint64_t kHeapMaxSize = 64 * 1024 * 1024;
+constexpr uint64_t kHeapInfoSize = 32;
+constexpr uint64_t kPageSize = 4096;
+constexpr int kNumFastBins = 10;
+constexpr int kNumTcacheBins = 64;
+// Sizes of the chunk that holds a tcache_perthread_struct. glibc 2.30 widened
+// its counts from char to uint16_t.
+constexpr uint64_t kTcacheChunkSize = 0x290;
+constexpr uint64_t kTcacheChunkSizeBefore230 = 0x250;
+
+// Bounds that keep the walk finite on a corrupted heap.
+constexpr size_t kMaxArenas = 1024;
+constexpr size_t kMaxHeapsPerArena = 1 << 16;
+constexpr size_t kMaxFreeListLength = 1 << 20;
+
+constexpr uint64_t kReadBlockSize = 4 * 1024 * 1024;
+
+// Offsets into struct malloc_state. The defaults match glibc 2.27 and later and
+// are used if libc has no debug info.
+struct ArenaLayout {
+  uint64_t fastbins_offset = 16;
+  uint64_t top_offset = 96;
+  uint64_t next_offset = 2160;
+  uint64_t size = 2200;
+};
+
+// A run of consecutive chunks, [start, end).
+struct HeapSegment {
+  uint64_t start;
+  uint64_t end;
+};
+
+struct Chunk {
+  uint64_t address;  // User address
+  uint64_t size;     // Usable size
+  uint64_t first_word;
+};
+
+struct Usage {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+
+  void Add(uint64_t count, uint64_t bytes) {
+    this->count += count;
+    this->bytes += bytes;
+  }
+};
+
+// Statistics of the chunks in one or more segments.
+struct WalkResult {
+  Usage live;
+  Usage free;
+  std::array<Usage, 64> size_classes;
+  // Live chunks keyed by their first word, used for type attribution.
+  std::unordered_map<uint64_t, Usage> first_words;
+  // Min-heap of the largest live chunks.
+  std::vector<Chunk> largest;
+};
+
+bool CompareSizeDescending(const Chunk& lhs, const Chunk& rhs) {
+  return lhs.size > rhs.size;
+}
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+int Log2(uint64_t value) {
+  int result = 0;
+  while (value >>= 1) {
+    ++result;
+  }
+  return result;
+}
+
+bool ReadU64(lldb::SBProcess process, uint64_t address, uint64_t* value) {
+  lldb::SBError error;
+  return process.ReadMemory(address, value, sizeof(*value), error) ==
+         sizeof(*value);
+}
+
+// Returns true if |address| is inside one of the sorted, disjoint |ranges|.
+bool Contains(const std::vector<AddressRange>& ranges, uint64_t address) {
+  auto it = std::upper_bound(
+      ranges.begin(), ranges.end(), address,
+      [](uint64_t a, const AddressRange& r) { return a < r.End(); });
+  return it != ranges.end() && it->base <= address;
+}
+
+// Returns true if [base, end) intersects one of the sorted, disjoint |ranges|.
+bool Overlaps(const std::vector<AddressRange>& ranges, uint64_t base,
+              uint64_t end) {
+  auto it = std::upper_bound(
+      ranges.begin(), ranges.end(), base,
+      [](uint64_t a, const AddressRange& r) { return a < r.End(); });
+  return it != ranges.end() && it->base < end;
+}
+
+// Reads memory in large blocks, so that walking consecutive chunk headers
+// doesn't cost a remote read per chunk. Never reads at or past |limit|.
+class BlockReader {
+ public:
+  BlockReader(lldb::SBProcess process, uint64_t limit)
+      : process_(process), limit_(limit), buffer_(kReadBlockSize) {}
+
+  bool ReadU64(uint64_t address, uint64_t* value) {
+    if (address < base_ || address + sizeof(*value) > base_ + size_) {
+      if (address + sizeof(*value) > limit_) {
+        return false;
+      }
+      // A read that skips a whole block ahead lands behind a chunk that is
+      // larger than a block. Only the header of the next chunk is needed, and
+      // the chunk after that is probably small again, so read a single page.
+      // This keeps large chunks from costing a full block read each.
+      uint64_t read_size = buffer_.size();
+      if (size_ > 0 && address >= base_ + size_ + buffer_.size()) {
+        read_size = kPageSize - address % kPageSize;
+      }
+      lldb::SBError error;
+      base_ = address;
+      size_ = process_.ReadMemory(
+          address, buffer_.data(),
+          std::min<uint64_t>(read_size, limit_ - address), error);
+      if (size_ < sizeof(*value)) {
+        return false;
+      }
+    }
+    memcpy(value, buffer_.data() + (address - base_), sizeof(*value));
+    return true;
+  }
+
+ private:
+  lldb::SBProcess process_;
+  uint64_t limit_;
+  std::vector<uint8_t> buffer_;
+  uint64_t base_ = 0;
+  size_t size_ = 0;
+};
+
+void AddLargest(const Chunk& chunk, size_t top_count, WalkResult* result) {
+  if (result->largest.size() < top_count) {
+    result->largest.push_back(chunk);
+    std::push_heap(result->largest.begin(), result->largest.end(),
+                   CompareSizeDescending);
+  } else if (top_count > 0 && chunk.size > result->largest.front().size) {
+    std::pop_heap(result->largest.begin(), result->largest.end(),
+                  CompareSizeDescending);
+    result->largest.back() = chunk;
+    std::push_heap(result->largest.begin(), result->largest.end(),
+                   CompareSizeDescending);
+  }
+}
+
+void AddChunk(const Chunk& chunk, bool in_use, size_t top_count,
+              WalkResult* result) {
+  if (!in_use) {
+    result->free.Add(1, chunk.size);
+    return;
+  }
+  result->live.Add(1, chunk.size);
+  result->size_classes[Log2(chunk.size)].Add(1, chunk.size);
+  result->first_words[chunk.first_word].Add(1, chunk.size);
+  AddLargest(chunk, top_count, result);
+}
+
+uint64_t FindGlobalAddress(lldb::SBTarget target, const char* name) {
+  lldb::SBValue variable = target.FindFirstGlobalVariable(name);
+  if (variable.IsValid()) {
+    return variable.GetLoadAddress();
+  }
+  // libc usually only has a symbol table, in which main_arena is a local
+  // symbol.
+  lldb::SBSymbolContextList contexts = target.FindSymbols(name);
+  for (uint32_t i = 0; i < contexts.GetSize(); ++i) {
+    lldb::SBSymbol symbol = contexts.GetContextAtIndex(i).GetSymbol();
+    uint64_t address = symbol.GetStartAddress().GetLoadAddress(target);
+    if (address != LLDB_INVALID_ADDRESS) {
+      return address;
+    }
+  }
+  return LLDB_INVALID_ADDRESS;
+}
+
+ArenaLayout GetArenaLayout(lldb::SBTarget target) {
+  ArenaLayout layout;
+  lldb::SBType type = target.FindFirstType("malloc_state");
+  if (!type.IsValid() || type.GetByteSize() == 0) {
+    return layout;
+  }
+  for (uint32_t i = 0; i < type.GetNumberOfFields(); ++i) {
+    lldb::SBTypeMember field = type.GetFieldAtIndex(i);
+    const char* name = field.GetName();
+    if (name == nullptr) {
+      continue;
+    }
+    if (strcmp(name, "fastbinsY") == 0) {
+      layout.fastbins_offset = field.GetOffsetInBytes();
+    } else if (strcmp(name, "top") == 0) {
+      layout.top_offset = field.GetOffsetInBytes();
+    } else if (strcmp(name, "next") == 0) {
+      layout.next_offset = field.GetOffsetInBytes();
+    }
+  }
+  layout.size = type.GetByteSize();
+  return layout;
+}
+
+// Collects the arenas reachable from |main_arena| and their chunk segments.
+// |heap_ranges| receives the memory occupied by the heaps, including the parts
+// of non-main heaps that are reserved but not used yet.
+lldb::SBError CollectSegments(lldb::SBProcess process, uint64_t main_arena,
+                              const ArenaLayout& layout,
+                              std::vector<uint64_t>* arenas,
+                              std::vector<HeapSegment>* segments,
+                              std::vector<AddressRange>* heap_ranges) {
+  lldb::SBError error;
+  lldb::SBTarget target = process.GetTarget();
+  uint64_t arena = main_arena;
+  for (size_t i = 0; i < kMaxArenas; ++i) {
+    uint64_t top;
+    uint64_t top_size;
+    if (!ReadU64(process, arena + layout.top_offset, &top) ||
+        !ReadU64(process, top + kSizeSz, &top_size)) {
+      error.SetErrorStringWithFormat("Unable to read the arena at 0x%llx",
+                                     arena);
+      return error;
+    }
+    arenas->push_back(arena);
+    uint64_t top_end = top + (top_size & ~kSizeBits);
+
+    if (arena == main_arena) {
+      // The main heap starts at the initial program break.
+      uint64_t start = target.FindFirstGlobalVariable("mp_")
+                           .GetChildMemberWithName("sbrk_base")
+                           .GetValueAsUnsigned(0);
+      if (start == 0) {
+        lldb::SBMemoryRegionInfo region;
+        if (process.GetMemoryRegionInfo(top, region).Fail()) {
+          error.SetErrorString("Unable to find the start of the main heap");
+          return error;
+        }
+        start = region.GetRegionBase();
+      }
+      if (start > top_end) {
+        error.SetErrorString("The main heap is corrupted");
+        return error;
+      }
+      segments->push_back({start, top_end});
+      heap_ranges->push_back({start, top_end - start});
+    } else {
+      // Non-main arenas consist of a list of heaps, aligned to their maximum
+      // size. The arena itself is stored in the oldest heap.
+      uint64_t heap = top & ~(kHeapMaxSize - 1);
+      for (size_t j = 0; heap != 0 && j < kMaxHeapsPerArena; ++j) {
+        uint64_t prev;
+        uint64_t size;
+        if (!ReadU64(process, heap + kSizeSz, &prev) ||
+            !ReadU64(process, heap + 2 * kSizeSz, &size)) {
+          break;
+        }
+        uint64_t start = heap + kHeapInfoSize == arena
+                             ? AlignUp(arena + layout.size, kMallocAlignment)
+                             : heap + kHeapInfoSize;
+        uint64_t end = j == 0 ? top_end : heap + size;
+        segments->push_back({start, end});
+        heap_ranges->push_back({heap, kHeapMaxSize});
+        heap = prev;
+      }
+    }
+
+    uint64_t next;
+    if (!ReadU64(process, arena + layout.next_offset, &next) || next == 0 ||
+        next == main_arena) {
+      break;
+    }
+    arena = next;
+  }
+  *heap_ranges = CoalesceRanges(*heap_ranges);
+  return error;
+}
+
+// Returns true if |address| can be the start of a chunk in the heaps.
+bool IsChunkAddress(const std::vector<AddressRange>& heap_ranges,
+                    uint64_t address) {
+  return address % kMallocAlignment == 0 && Contains(heap_ranges, address);
+}
+
+// Adds the chunk addresses in the fastbins of |arenas| to |chunks|. Unlike
+// chunks in the other bins, these are still marked as in use.
+void CollectFastbinChunks(lldb::SBProcess process,
+                          const std::vector<uint64_t>& arenas,
+                          const ArenaLayout& layout,
+                          const std::vector<AddressRange>& heap_ranges,
+                          std::unordered_set<uint64_t>* chunks) {
+  auto is_chunk = [&](uint64_t address) {
+    return IsChunkAddress(heap_ranges, address);
+  };
+
+  for (uint64_t arena : arenas) {
+    for (int i = 0; i < kNumFastBins; ++i) {
+      uint64_t chunk;
+      if (!ReadU64(process, arena + layout.fastbins_offset + i * kSizeSz,
+                   &chunk)) {
+        continue;
+      }
+      for (size_t n = 0; is_chunk(chunk) && n < kMaxFreeListLength; ++n) {
+        if (!chunks->insert(chunk).second) {
+          break;
+        }
+        uint64_t fd;
+        if (!ReadU64(process, chunk + kChunkHeaderSize, &fd)) {
+          break;
+        }
+        // Since glibc 2.32, list pointers are mangled with the address they
+        // are stored at.
+        uint64_t demangled = ((chunk + kChunkHeaderSize) >> 12) ^ fd;
+        chunk = is_chunk(fd) ? fd : demangled;
+      }
+    }
+  }
+}
+
+// Returns the addresses of the tcache_perthread_structs of |process|. With
+// libc debug info, they are read from the "tcache" thread-local variable of
+// every thread. The first chunk of every heap segment is a candidate as well,
+// because the first malloc() of a thread allocates its tcache from the arena
+// it uses. Without debug info, the tcaches of threads that share an arena
+// they didn't create are missed.
+std::vector<uint64_t> FindTcacheCandidates(
+    lldb::SBProcess process, const std::vector<HeapSegment>& segments) {
+  std::vector<uint64_t> tcaches;
+  lldb::SBTarget target = process.GetTarget();
+  if (target.FindGlobalVariables("tcache", 1).GetSize() > 0) {
+    // Thread-local variables are read in the context of the selected thread.
+    lldb::SBThread selected_thread = process.GetSelectedThread();
+    for (uint32_t i = 0; i < process.GetNumThreads(); ++i) {
+      process.SetSelectedThread(process.GetThreadAtIndex(i));
+      lldb::SBValueList values = target.FindGlobalVariables("tcache", 1);
+      uint64_t tcache = values.GetSize() > 0
+                            ? values.GetValueAtIndex(0).GetValueAsUnsigned(0)
+                            : 0;
+      if (tcache != 0) {
+        tcaches.push_back(tcache);
+      }
+    }
+    if (selected_thread.IsValid()) {
+      process.SetSelectedThread(selected_thread);
+    }
+  }
+  for (const HeapSegment& segment : segments) {
+    tcaches.push_back(segment.start + kChunkHeaderSize);
+  }
+  std::sort(tcaches.begin(), tcaches.end());
+  tcaches.erase(std::unique(tcaches.begin(), tcaches.end()), tcaches.end());
+  return tcaches;
+}
+
+// Adds the chunk addresses in the tcache_perthread_struct at |tcache| to
+// |chunks|. Like fastbin chunks, these are still marked as in use. Memory that
+// doesn't look like a tcache_perthread_struct is ignored.
+void CollectTcacheChunks(lldb::SBProcess process, uint64_t tcache,
+                         const std::vector<AddressRange>& heap_ranges,
+                         std::unordered_set<uint64_t>* chunks) {
+  // tcache entries point to the user memory of the chunks.
+  auto is_entry = [&](uint64_t address) {
+    return IsChunkAddress(heap_ranges, address - kChunkHeaderSize);
+  };
+
+  uint64_t size_field;
+  if (!is_entry(tcache) || !ReadU64(process, tcache - kSizeSz, &size_field)) {
+    return;
+  }
+  size_t count_size;
+  switch (size_field & ~kSizeBits) {
+    case kTcacheChunkSize:
+      count_size = sizeof(uint16_t);
+      break;
+    case kTcacheChunkSizeBefore230:
+      count_size = sizeof(uint8_t);
+      break;
+    default:
+      return;
+  }
+  std::vector<uint8_t> data(kNumTcacheBins * (count_size + kSizeSz));
+  lldb::SBError error;
+  if (process.ReadMemory(tcache, data.data(), data.size(), error) !=
+      data.size()) {
+    return;
+  }
+
+  std::array<uint64_t, kNumTcacheBins> counts;
+  std::array<uint64_t, kNumTcacheBins> entries;
+  for (int i = 0; i < kNumTcacheBins; ++i) {
+    uint16_t count = 0;
+    memcpy(&count, data.data() + i * count_size, count_size);
+    counts[i] = count;
+    memcpy(&entries[i],
+           data.data() + kNumTcacheBins * count_size + i * kSizeSz, kSizeSz);
+    // A bin has entries exactly if its count isn't 0.
+    if ((counts[i] == 0) != (entries[i] == 0) ||
+        (entries[i] != 0 && !is_entry(entries[i]))) {
+      return;
+    }
+  }
+
+  for (int i = 0; i < kNumTcacheBins; ++i) {
+    uint64_t entry = entries[i];
+    for (uint64_t n = 0; n < counts[i] && n < kMaxFreeListLength &&
+                         entry != 0 && is_entry(entry);
+         ++n) {
+      if (!chunks->insert(entry - kChunkHeaderSize).second) {
+        break;
+      }
+      uint64_t next;
+      if (!ReadU64(process, entry, &next)) {
+        break;
+      }
+      // Since glibc 2.32, list pointers are mangled with the address they
+      // are stored at.
+      uint64_t demangled = (entry >> 12) ^ next;
+      entry = next == 0 || is_entry(next) ? next : demangled;
+    }
+  }
+}
+
+// |cached_chunks| are the free chunks in fastbins and tcaches, which are still
+// marked as in use.
+void WalkSegment(lldb::SBProcess process, const HeapSegment& segment,
+                 const std::unordered_set<uint64_t>& cached_chunks,
+                 size_t top_count, WalkResult* result) {
+  BlockReader reader(process, segment.end);
+  // Whether a chunk is in use is stored in the header of the next chunk, so a
+  // chunk is recorded once the next header has been read.
+  Chunk pending = {};
+  bool has_pending = false;
+  uint64_t address = segment.start;
+  while (address + kChunkHeaderSize <= segment.end) {
+    uint64_t size_field;
+    if (!reader.ReadU64(address + kSizeSz, &size_field)) {
+      break;
+    }
+    if (has_pending) {
+      bool in_use =
+          (size_field & kPrevInUse) != 0 &&
+          cached_chunks.count(pending.address - kChunkHeaderSize) == 0;
+      AddChunk(pending, in_use, top_count, result);
+      has_pending = false;
+    }
+    // The fenceposts at the end of a non-main heap are smaller than any chunk.
+    uint64_t size = size_field & ~kSizeBits;
+    if (size < kMinChunkSize || address + size > segment.end) {
+      break;
+    }
+    pending.address = address + kChunkHeaderSize;
+    pending.size = size - kSizeSz;
+    pending.first_word = 0;
+    reader.ReadU64(pending.address, &pending.first_word);
+    has_pending = true;
+    address += size;
+  }
+  // The last chunk of a segment is the top chunk, which is free.
+  if (has_pending) {
+    AddChunk(pending, false, top_count, result);
+  }
+}
+
+// Large allocations are served by mmap() and live outside of the arenas. They
+// are found by looking for mmap()ed chunk headers in anonymous, writable
+// regions.
+//
+// malloc puts an mmap()ed chunk at the start of its own mapping, so its
+// prev_size is 0, only IS_MMAPPED is set in its size field, and its size is a
+// multiple of the page size. Adjacent mappings may have been merged into one
+// region, but then the chunks have to cover the region exactly. Regions that
+// don't satisfy all of this are not counted, which skips the chunks moved by
+// memalign() but avoids mistaking arbitrary data for allocations.
+void WalkMmappedChunks(lldb::SBProcess process,
+                       const std::vector<AddressRange>& heap_ranges,
+                       size_t top_count, WalkResult* result) {
+  lldb::SBMemoryRegionInfoList regions = process.GetMemoryRegions();
+  std::vector<Chunk> chunks;
+  for (uint32_t i = 0; i < regions.GetSize(); ++i) {
+    lldb::SBMemoryRegionInfo region;
+    if (!regions.GetMemoryRegionAtIndex(i, region) || !region.IsMapped() ||
+        !region.IsReadable() || !region.IsWritable()) {
+      continue;
+    }
+    // File mappings, the stack and the brk heap all have a name.
+    const char* name = region.GetName();
+    if (name != nullptr && *name != '\0') {
+      continue;
+    }
+    uint64_t end = region.GetRegionEnd();
+    uint64_t address = region.GetRegionBase();
+    if (Overlaps(heap_ranges, address, end)) {
+      continue;
+    }
+    chunks.clear();
+    while (address + kChunkHeaderSize <= end) {
+      uint64_t header[3] = {};  // prev_size, size, first word
+      lldb::SBError error;
+      if (process.ReadMemory(address, header, sizeof(header), error) <
+          kChunkHeaderSize) {
+        break;
+      }
+      uint64_t size = header[1] & ~kSizeBits;
+      if (header[0] != 0 || (header[1] & kSizeBits) != kIsMmapped ||
+          size == 0 || size % kPageSize != 0 || address + size > end) {
+        break;
+      }
+      chunks.push_back(
+          {address + kChunkHeaderSize, size - kChunkHeaderSize, header[2]});
+      address += size;
+    }
+    if (address != end) {
+      continue;
+    }
+    for (const Chunk& chunk : chunks) {
+      AddChunk(chunk, true, top_count, result);
+    }
+  }
+}
+
+std::vector<AddressRange> GetModuleRanges(lldb::SBTarget target) {
+  std::vector<AddressRange> ranges;
+  for (uint32_t i = 0; i < target.GetNumModules(); ++i) {
+    lldb::SBModule module = target.GetModuleAtIndex(i);
+    for (size_t j = 0; j < module.GetNumSections(); ++j) {
+      lldb::SBSection section = module.GetSectionAtIndex(j);
+      uint64_t address = section.GetLoadAddress(target);
+      if (address != LLDB_INVALID_ADDRESS) {
+        ranges.push_back({address, section.GetByteSize()});
+      }
+    }
+  }
+  return CoalesceRanges(std::move(ranges));
+}
+
+// Returns T if |address| points into the "vtable for T" symbol, or an empty
+// string otherwise.
+std::string GetVtableTypeName(lldb::SBTarget target, uint64_t address) {
+  constexpr char kVtablePrefix[] = "vtable for ";
+  constexpr size_t kVtablePrefixLength = sizeof(kVtablePrefix) - 1;
+  lldb::SBSymbol symbol = target.ResolveLoadAddress(address).GetSymbol();
+  const char* name = symbol.IsValid() ? symbol.GetName() : nullptr;
+  if (name == nullptr || strncmp(name, kVtablePrefix, kVtablePrefixLength)) {
+    return {};
+  }
+  return name + kVtablePrefixLength;
+}
+
+constexpr size_t kDefaultTopCount = 20;
+
+// "heap [<count>]" prints the summary of AnalyzeGlibcHeap for the selected
+// process, with the |count| largest allocations.
+class HeapCommand : public lldb::SBCommandPluginInterface {
+ public:
+  bool DoExecute(lldb::SBDebugger debugger, char** command,
+                 lldb::SBCommandReturnObject& result) override {
+    size_t top_count = kDefaultTopCount;
+    if (command != nullptr && command[0] != nullptr) {
+      char* end = nullptr;
+      unsigned long long value = strtoull(command[0], &end, 10);
+      if (end == command[0] || *end != '\0' || command[1] != nullptr) {
+        result.SetError("Usage: heap [<count>]");
+        return false;
+      }
+      top_count = static_cast<size_t>(value);
+    }
+
+    lldb::SBProcess process = debugger.GetSelectedTarget().GetProcess();
+    if (!process.IsValid()) {
+      result.SetError("No process to analyze");
+      return false;
+    }
+    HeapReport report;
+    lldb::SBError error = AnalyzeGlibcHeap(process, top_count, &report);
+    if (error.Fail()) {
+      result.SetError(error);
+      return false;
+    }
+
+    result.Printf("Live: %llu allocations, %llu bytes\n", report.live_count,
+                  report.live_bytes);
+    result.Printf("Free: %llu chunks, %llu bytes\n", report.free_count,
+                  report.free_bytes);
+    result.Printf("\nUsable size        Count          Bytes\n");
+    for (const HeapSizeClass& size_class : report.size_classes) {
+      result.Printf(">= %-12llu %10llu %14llu\n", size_class.min_size,
+                    size_class.count, size_class.bytes);
+    }
+    if (!report.largest.empty()) {
+      result.Printf("\nLargest allocations:\n");
+      for (const HeapAllocation& allocation : report.largest) {
+        result.Printf("0x%016llx %14llu %s\n", allocation.address,
+                      allocation.size, allocation.type_name.c_str());
+      }
+    }
+    if (!report.types.empty()) {
+      result.Printf("\nAllocations by vtable type:\n");
+      for (const HeapTypeSummary& type : report.types) {
+        result.Printf("%10llu %14llu %s\n", type.count, type.bytes,
+                      type.type_name.c_str());
+      }
+    }
+    result.SetStatus(lldb::eReturnStatusSuccessFinishResult);
+    return true;
+  }
+};
+
+}  // namespace
+
+lldb::SBError AnalyzeGlibcHeap(lldb::SBProcess process, size_t top_count,
+                               HeapReport* report) {
+  lldb::SBError error;
+  lldb::SBTarget target = process.GetTarget();
+  uint64_t main_arena = FindGlobalAddress(target, "main_arena");
+  if (main_arena == LLDB_INVALID_ADDRESS) {
+    error.SetErrorString(
+        "Unable to find main_arena, symbols for libc are required");
+    return error;
+  }
+
+  ArenaLayout layout = GetArenaLayout(target);
+  std::vector<uint64_t> arenas;
+  std::vector<HeapSegment> segments;
+  std::vector<AddressRange> heap_ranges;
+  error = CollectSegments(process, main_arena, layout, &arenas, &segments,
+                          &heap_ranges);
+  if (error.Fail()) {
+    return error;
+  }
+  std::unordered_set<uint64_t> cached_chunks;
+  CollectFastbinChunks(process, arenas, layout, heap_ranges, &cached_chunks);
+  for (uint64_t tcache : FindTcacheCandidates(process, segments)) {
+    CollectTcacheChunks(process, tcache, heap_ranges, &cached_chunks);
+  }
+
+  // Segments are walked one after another. SBProcess::ReadMemory holds the
+  // target's API mutex, so walking them on several threads wouldn't overlap
+  // the reads.
+  WalkResult total;
+  for (const HeapSegment& segment : segments) {
+    WalkSegment(process, segment, cached_chunks, top_count, &total);
+  }
+  WalkMmappedChunks(process, heap_ranges, top_count, &total);
+
+  report->live_count = total.live.count;
+  report->live_bytes = total.live.bytes;
+  report->free_count = total.free.count;
+  report->free_bytes = total.free.bytes;
+  for (size_t i = 0; i < total.size_classes.size(); ++i) {
+    if (total.size_classes[i].count > 0) {
+      report->size_classes.push_back({uint64_t(1) << i,
+                                      total.size_classes[i].count,
+                                      total.size_classes[i].bytes});
+    }
+  }
+
+  // Only values that point into a loaded module can be vtable pointers, which
+  // avoids symbol lookups for most of the first words.
+  std::vector<AddressRange> module_ranges = GetModuleRanges(target);
+  std::unordered_map<uint64_t, std::string> type_names;
+  auto get_type_name = [&](uint64_t first_word) -> const std::string& {
+    auto it = type_names.find(first_word);
+    if (it == type_names.end()) {
+      std::string name;
+      if (first_word % kSizeSz == 0 && Contains(module_ranges, first_word)) {
+        name = GetVtableTypeName(target, first_word);
+      }
+      it = type_names.emplace(first_word, std::move(name)).first;
+    }
+    return it->second;
+  };
+
+  std::unordered_map<std::string, Usage> types;
+  for (const auto& entry : total.first_words) {
+    const std::string& name = get_type_name(entry.first);
+    if (!name.empty()) {
+      types[name].Add(entry.second.count, entry.second.bytes);
+    }
+  }
+  for (const auto& entry : types) {
+    report->types.push_back(
+        {entry.first, entry.second.count, entry.second.bytes});
+  }
+  std::sort(report->types.begin(), report->types.end(),
+            [](const HeapTypeSummary& lhs, const HeapTypeSummary& rhs) {
+              return lhs.bytes > rhs.bytes;
+            });
+
+  std::sort(total.largest.begin(), total.largest.end(), CompareSizeDescending);
+  for (const Chunk& chunk : total.largest) {
+    report->largest.push_back(
+        {chunk.address, chunk.size, get_type_name(chunk.first_word)});
+  }
+  return error;
+}
+
+void RegisterHeapCommand(lldb::SBDebugger debugger) {
+  // The interpreter takes ownership of the command.
+  debugger.GetCommandInterpreter().AddCommand(
+      "heap", new HeapCommand(),
+      "Summarize the glibc malloc heaps of the current process.",
+      "heap [<count>]");
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
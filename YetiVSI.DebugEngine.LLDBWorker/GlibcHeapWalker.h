@@ -0,0 +1,79 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBProcess.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Allocations with a usable size in [min_size, 2 * min_size).
+struct HeapSizeClass {
+  uint64_t min_size;
+  uint64_t count;
+  uint64_t bytes;
+};
+
+struct HeapAllocation {
+  uint64_t address;  // Address returned by malloc()
+  uint64_t size;     // Usable size
+  std::string type_name;  // Empty if the type is unknown
+};
+
+struct HeapTypeSummary {
+  std::string type_name;
+  uint64_t count;
+  uint64_t bytes;
+};
+
+struct HeapReport {
+  uint64_t live_count = 0;
+  uint64_t live_bytes = 0;
+  uint64_t free_count = 0;
+  uint64_t free_bytes = 0;
+  std::vector<HeapSizeClass> size_classes;  // Ascending by size
+  std::vector<HeapAllocation> largest;      // Descending by size
+  std::vector<HeapTypeSummary> types;       // Descending by bytes
+};
+
+// Enumerates the live allocations of the glibc malloc heaps in |process|, which
+// may be a live process or a core dump that contains the heap memory.
+//
+// The arenas are found through the main_arena symbol, so libc symbols have to
+// be loaded. Chunks are walked with large sequential reads, one heap segment
+// after another. Chunks in fastbins, tcaches and regular bins are counted as
+// free. Without libc debug info, only the tcaches at the start of a heap
+// segment are found, which misses the tcaches of threads that share an arena
+// they didn't create. Allocations whose first word points into a
+// "vtable for T" symbol are attributed to T.
+lldb::SBError AnalyzeGlibcHeap(lldb::SBProcess process, size_t top_count,
+                               HeapReport* report);
+
+// Adds the "heap [<count>]" command to the interpreter of |debugger|. It prints
+// the report of AnalyzeGlibcHeap for the selected process, so the LLDB Shell
+// window can show it.
+void RegisterHeapCommand(lldb::SBDebugger debugger);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
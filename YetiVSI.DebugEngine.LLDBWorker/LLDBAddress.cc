@@ -16,10 +16,12 @@
 
 #include "LLDBAddress.h"
 
+#include "AddressLineTable.h"
 #include "LLDBFunction.h"
 #include "LLDBLineEntry.h"
 #include "LLDBSymbol.h"
 #include "LLDBTarget.h"
+#include "lldb/API/SBFileSpec.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
@@ -31,12 +33,33 @@ LLDBAddress::LLDBAddress(lldb::SBAddress address) {
 int64_t LLDBAddress::GetId() { throw gcnew System::NotImplementedException(); }
 
 SbLineEntry ^ LLDBAddress::GetLineEntry() {
-  lldb::SBLineEntry lineEntry = address_->GetLineEntry();
-  if (lineEntry.IsValid()) {
-    return gcnew LLDBLineEntry(address_->GetLineEntry());
-  } else {
+  // The flat table of the module is much faster than LLDB's search of the
+  // line tables, which matters for the thousands of addresses resolved by
+  // the disassembly view.
+  lldb::SBModule module = address_->GetModule();
+  std::shared_ptr<const AddressLineTable> table = GetAddressLineTable(module);
+  if (table == nullptr) {
+    lldb::SBLineEntry lineEntry = address_->GetLineEntry();
+    if (lineEntry.IsValid()) {
+      return gcnew LLDBLineEntry(lineEntry);
+    } else {
+      return nullptr;
+    }
+  }
+
+  ResolvedLineEntry entry;
+  if (!table->Lookup(address_->GetFileAddress(), &entry)) {
     return nullptr;
   }
+  lldb::SBFileSpec file_spec;
+  file_spec.SetFilename(entry.file_name.c_str());
+  file_spec.SetDirectory(entry.directory.c_str());
+  lldb::SBLineEntry line_entry;
+  line_entry.SetFileSpec(file_spec);
+  line_entry.SetLine(entry.line);
+  line_entry.SetColumn(entry.column);
+  return gcnew LLDBLineEntry(
+      line_entry, module.ResolveFileAddress(entry.start_file_address));
 }
 
 uint64_t LLDBAddress::GetLoadAddress(SbTarget ^ target) {
@@ -16,12 +16,18 @@
 
 #include <msclr\marshal_cppstd.h>
 
+#include <vector>
+
 #include "LLDBBreakpointLocation.h"
+#include "LLDBError.h"
+#include "Tracepoint.h"
 #include "lldb/API/SBStringList.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
 
+using System::Collections::Generic::List;
+
 LLDBBreakpoint::LLDBBreakpoint(lldb::SBBreakpoint breakpoint) {
   breakpoint_ = MakeUniquePtr<lldb::SBBreakpoint>(breakpoint);
 }
@@ -81,5 +87,83 @@ void LLDBBreakpoint::SetCommandLineCommands(
   breakpoint_->SetCommandLineCommands(sbCommands);
 }
 
+void LLDBBreakpoint::SetTracepoint(List<LldbApi::TraceItem> ^ items,
+                                   uint32_t capacity) {
+  std::vector<TraceItem> native_items;
+  native_items.reserve(items->Count);
+  for each (LldbApi::TraceItem item in items) {
+    TraceItemKind kind = TraceItemKind::kExpression;
+    switch (item.Kind) {
+      case LldbApi::TraceItemKind::Register:
+        kind = TraceItemKind::kRegister;
+        break;
+      case LldbApi::TraceItemKind::Memory:
+        kind = TraceItemKind::kMemory;
+        break;
+    }
+    std::string expression =
+        item.Expression == nullptr
+            ? std::string()
+            : msclr::interop::marshal_as<std::string>(item.Expression);
+    native_items.push_back({kind, expression, item.Size});
+  }
+  YetiVSI::DebugEngine::SetTracepoint(*(*breakpoint_), std::move(native_items),
+                                      capacity);
+}
+
+void LLDBBreakpoint::ClearTracepoint() {
+  YetiVSI::DebugEngine::ClearTracepoint(*(*breakpoint_));
+}
+
+List<LldbApi::TraceRecord ^> ^ LLDBBreakpoint::DrainTrace(
+    uint32_t maxRecords,
+    [System::Runtime::InteropServices::Out] uint64_t % droppedCount) {
+  std::vector<TraceRecord> records;
+  uint64_t dropped = 0;
+  DrainTracepoint(*(*breakpoint_), maxRecords, &records, &dropped);
+  droppedCount = dropped;
+
+  auto result =
+      gcnew List<LldbApi::TraceRecord ^>(static_cast<int>(records.size()));
+  for (const auto& record : records) {
+    auto managed_record = gcnew LldbApi::TraceRecord();
+    managed_record->Sequence = record.sequence;
+    managed_record->TimestampNanoseconds = record.timestamp_ns;
+    managed_record->ThreadId = record.thread_id;
+    managed_record->Pc = record.pc;
+    managed_record->LocationId = record.location_id;
+    managed_record->Values = gcnew List<array<unsigned char> ^>(
+        static_cast<int>(record.values.size()));
+    for (const TraceValue& value : record.values) {
+      array<unsigned char> ^ data = nullptr;
+      if (value.valid) {
+        data = gcnew array<unsigned char>(static_cast<int>(value.data.size()));
+        if (data->Length > 0) {
+          System::Runtime::InteropServices::Marshal::Copy(
+              System::IntPtr(const_cast<uint8_t*>(value.data.data())), data,
+              0, data->Length);
+        }
+      }
+      managed_record->Values->Add(data);
+    }
+    result->Add(managed_record);
+  }
+  return result;
+}
+
+SbError ^ LLDBBreakpoint::ExportTrace(System::String ^ path) {
+  std::vector<TraceRecord> records;
+  uint64_t dropped = 0;
+  lldb::SBError error;
+  if (!DrainTracepoint(*(*breakpoint_), 0, &records, &dropped)) {
+    error.SetErrorStringWithFormat("Breakpoint %d is not a tracepoint",
+                                   breakpoint_->GetID());
+    return gcnew LLDBError(error);
+  }
+  error = WriteTraceFile(msclr::interop::marshal_as<std::string>(path),
+                         breakpoint_->GetID(), records);
+  return gcnew LLDBError(error);
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
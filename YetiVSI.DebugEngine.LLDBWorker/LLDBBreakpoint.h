@@ -41,6 +41,15 @@ ref class LLDBBreakpoint : SbBreakpoint {
   virtual void SetCondition(System::String ^ condition);
   virtual void SetCommandLineCommands(
       System::Collections::Generic::List<System::String ^> ^ commands);
+  virtual void SetTracepoint(
+      System::Collections::Generic::List<LldbApi::TraceItem> ^ items,
+      uint32_t capacity);
+  virtual void ClearTracepoint();
+  virtual System::Collections::Generic::List<LldbApi::TraceRecord ^> ^
+      DrainTrace(uint32_t maxRecords,
+                 [System::Runtime::InteropServices::Out] uint64_t %
+                     droppedCount);
+  virtual SbError ^ ExportTrace(System::String ^ path);
 
  private:
   ManagedUniquePtr<lldb::SBBreakpoint> ^ breakpoint_;
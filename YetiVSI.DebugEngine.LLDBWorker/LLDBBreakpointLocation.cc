@@ -22,7 +22,6 @@
 #include "LLDBAddress.h"
 #include "LLDBBreakpoint.h"
 #include "lldb/API/SBAddress.h"
-#include "lldb-eval/api.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
@@ -59,27 +58,9 @@ SbAddress ^ LLDBBreakpointLocation::GetAddress() {
   }
 }
 
-bool LldbEvalCallback(void* baton, lldb::SBProcess& process,
-                      lldb::SBThread& thread,
-                      lldb::SBBreakpointLocation& location) {
-  const std::string* condition = static_cast<std::string*>(baton);
-  lldb::SBError error;
-  auto result = lldb_eval::EvaluateExpression(thread.GetSelectedFrame(),
-                                              condition->c_str(), error);
-
-  // We return true when an error occurs in the evaluation in order to match the behavior
-  // of Visual Studio. A conditional breakpoint should only be skipped when the condition
-  // is successfully evaluated and the result of the evaluation is false.
-  if (error.Fail()) {
-    return true;
-  }
-  return result.GetValueAsUnsigned(1);
-}
-
 void LLDBBreakpointLocation::SetCondition(System::String^ condition) {
   auto conditionStr = msclr::interop::marshal_as<std::string>(condition);
-  callbackBaton_ = MakeUniquePtr<std::string>(conditionStr);
-  breakpointLocation_->SetCallback(LldbEvalCallback, (*callbackBaton_).Get());
+  SetBreakpointCondition(*(*breakpointLocation_), conditionStr);
 }
 
 void LLDBBreakpointLocation::SetIgnoreCount(unsigned int ignoreCount) {
@@ -90,5 +71,16 @@ uint32_t LLDBBreakpointLocation::GetHitCount() {
   return breakpointLocation_->GetHitCount();
 }
 
+BreakpointConditionStats LLDBBreakpointLocation::GetConditionStats() {
+  BreakpointConditionStats stats;
+  ConditionStats native_stats =
+      GetBreakpointConditionStats(*(*breakpointLocation_));
+  stats.HitCount = native_stats.hit_count;
+  stats.TrueCount = native_stats.true_count;
+  stats.TotalEvaluationNanoseconds = native_stats.total_eval_ns;
+  stats.MaxEvaluationNanoseconds = native_stats.max_eval_ns;
+  return stats;
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
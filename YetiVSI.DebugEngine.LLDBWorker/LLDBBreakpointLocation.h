@@ -18,8 +18,8 @@
 
 #include "lldb/API/SBBreakpointLocation.h"
 
+#include "BreakpointCondition.h"
 #include "ManagedUniquePtr.h"
-#include <string>
 
 namespace YetiVSI {
 namespace DebugEngine {
@@ -39,10 +39,10 @@ ref class LLDBBreakpointLocation : SbBreakpointLocation {
   virtual void SetCondition(System::String ^ condition);
   virtual void SetIgnoreCount(unsigned int ignoreCount);
   virtual uint32_t GetHitCount();
+  virtual BreakpointConditionStats GetConditionStats();
 
  private:
   ManagedUniquePtr<lldb::SBBreakpointLocation> ^ breakpointLocation_;
-  ManagedUniquePtr<std::string> ^ callbackBaton_;
 };
 
 }  // namespace DebugEngine
@@ -20,6 +20,7 @@
 
 #include <mutex>
 
+#include "GlibcHeapWalker.h"
 #include "LLDBCommandInterpreter.h"
 #include "LLDBPlatform.h"
 #include "LLDBTarget.h"
@@ -62,6 +63,7 @@ LLDBDebugger::LLDBDebugger(bool sourceInitFiles) {
   // a new object on the heap from a copy of the object on the stack.
   debugger_ = MakeUniquePtr<lldb::SBDebugger>(
       lldb::SBDebugger::Create(sourceInitFiles, LoggingCallback, nullptr));
+  RegisterHeapCommand(*debugger_.Get());
 }
 
 void LLDBDebugger::SetAsync(bool async) { debugger_->SetAsync(async); }
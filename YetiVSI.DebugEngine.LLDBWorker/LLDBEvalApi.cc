@@ -18,6 +18,7 @@
 
 #include <msclr/marshal_cppstd.h>
 
+#include "CompiledExpressionCache.h"
 #include "LLDBError.h"
 #include "LLDBStackFrame.h"
 #include "LLDBTarget.h"
@@ -33,6 +34,24 @@ namespace DebugEngine {
 
 using System::Collections::Generic::IDictionary;
 
+namespace {
+
+// Converts |contextVars| to lldb-eval context variables. The names are owned
+// by |context|.
+std::vector<lldb_eval::ContextVariable> ToContextVariables(
+    IDictionary<System::String ^, SbValue ^> ^ contextVars,
+    msclr::interop::marshal_context % context) {
+  std::vector<lldb_eval::ContextVariable> vars;
+  for each (auto var in contextVars) {
+    const char* name = context.marshal_as<const char*>(var.Key);
+    lldb::SBValue value = safe_cast<LLDBValue ^>(var.Value)->GetNativeObject();
+    vars.push_back({name, value});
+  }
+  return vars;
+}
+
+}  // namespace
+
 SbValue ^
     LldbEval::EvaluateExpression(SbFrame ^ frame, System::String ^ expression) {
   std::string expr = msclr::interop::marshal_as<std::string>(expression);
@@ -63,25 +82,31 @@ SbValue ^
   std::string expr = msclr::interop::marshal_as<std::string>(expression);
   lldb::SBValue sbValue = safe_cast<LLDBValue ^>(value)->GetNativeObject();
 
-  // Convert `IDictionary` to `std::vector`.
   msclr::interop::marshal_context context;
-  std::vector<lldb_eval::ContextVariable> vars;
-  for each (auto var in contextVars) {
-    const char* name = context.marshal_as<const char*>(var.Key);
-    lldb::SBValue value = safe_cast<LLDBValue ^>(var.Value)->GetNativeObject();
-    vars.push_back({name, value});
+  std::vector<lldb_eval::ContextVariable> vars =
+      ToContextVariables(contextVars, context);
+
+  // "Value" expression evaluations are coming from NatVis engine, which
+  // evaluates the same expressions for every object of a type. The compiled
+  // expressions are cached, so they are only parsed once per type. NatVis
+  // expressions are supposed to be idempotent, so side effects to the target
+  // process are not allowed.
+  std::vector<lldb_eval::ContextArgument> args;
+  args.reserve(vars.size());
+  for (lldb_eval::ContextVariable& var : vars) {
+    args.push_back({var.name, var.value.GetType()});
   }
 
-  // "Value" expression evaluations are coming from NatVis engine. These
-  // expressions are defined in NatVis scripts and supposed to be idempotent.
-  // Thus side effects to the target process are not allowed.
-  lldb_eval::Options opts;
-  opts.allow_side_effects = false;
-  opts.context_vars = {vars.data(), vars.size()};
-
   lldb::SBError error;
-  lldb::SBValue result =
-      lldb_eval::EvaluateExpression(sbValue, expr.c_str(), opts, error);
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled = FindOrCompileExpression(
+      sbValue.GetTarget(), sbValue.GetType(), expr, args, error);
+  lldb::SBValue result;
+  if (compiled != nullptr) {
+    lldb_eval::Options opts;
+    opts.allow_side_effects = false;
+    opts.context_vars = {vars.data(), vars.size()};
+    result = lldb_eval::EvaluateExpression(sbValue, compiled, opts, error);
+  }
 
   // Try converting the result to dynamic type. That way the VSI extension will
   // be able to pick up the correct Natvis visualization.
@@ -92,7 +117,8 @@ SbValue ^
 
 System::Tuple<SbType ^, SbError ^> ^ LldbEval::CompileExpression(
     SbTarget ^ target, SbType ^ scope, System::String ^ expression,
-    IDictionary<System::String ^, SbType ^> ^ contextArgs) {
+    IDictionary<System::String ^, SbType ^> ^ contextArgs,
+    [System::Runtime::InteropServices::Out] int64_t % handle) {
   std::string expr = msclr::interop::marshal_as<std::string>(expression);
   lldb::SBTarget sbTarget = safe_cast<LLDBTarget ^>(target)->GetNativeObject();
   lldb::SBType sbType = safe_cast<LLDBType ^>(scope)->GetNativeObject();
@@ -106,18 +132,16 @@ System::Tuple<SbType ^, SbError ^> ^ LldbEval::CompileExpression(
     args.push_back({name, type});
   }
 
-  // Calls to this method are coming from NatVis engine and supposed to be
-  // idempotent. Thus side effects to the target process are not allowed.
-  lldb_eval::Options opts;
-  opts.allow_side_effects = false;
-  opts.context_args = {args.data(), args.size()};
-
+  // Calls to this method are coming from NatVis engine, which checks the
+  // expressions of a visualizer before using it. Later evaluations of the
+  // expressions for objects of the type reuse the compiled expressions.
   lldb::SBError error;
+  int64_t compiledHandle = 0;
   std::shared_ptr<lldb_eval::CompiledExpr> compiledExpr =
-      lldb_eval::CompileExpression(sbTarget, sbType, expr.c_str(), opts, error);
+      CompileExpressionHandle(sbTarget, sbType, expr, args, &compiledHandle,
+                              error);
+  handle = compiledHandle;
 
-  // TODO: In the future we should return the entire compiled
-  // expression, but right now the information about resulting type is enough.
   lldb::SBType resultType =
       compiledExpr != nullptr ? compiledExpr->result_type : lldb::SBType();
   SbType ^ lldbType = gcnew LLDBType(resultType);
@@ -125,5 +149,40 @@ System::Tuple<SbType ^, SbError ^> ^ LldbEval::CompileExpression(
   return gcnew System::Tuple<SbType ^, SbError ^>(lldbType, lldbError);
 }
 
+SbValue ^ LldbEval::EvaluateCompiledExpression(
+              SbValue ^ value, int64_t handle,
+              IDictionary<System::String ^, SbValue ^> ^ contextVars) {
+  lldb::SBValue sbValue = safe_cast<LLDBValue ^>(value)->GetNativeObject();
+  lldb::SBError error;
+  CompiledExpressionState state;
+  std::shared_ptr<lldb_eval::CompiledExpr> compiled =
+      GetCompiledExpression(handle, &state);
+  if (state == CompiledExpressionState::kReleased) {
+    error.SetErrorString("The compiled expression was released.");
+    return gcnew LLDBValue(lldb::SBValue(), error);
+  }
+  if (state == CompiledExpressionState::kStale) {
+    error.SetErrorString(
+        "The compiled expression is stale: modules whose types it uses were "
+        "unloaded or loaded symbols, or its process exited. Compile it "
+        "again.");
+    return gcnew LLDBValue(lldb::SBValue(), error);
+  }
+
+  msclr::interop::marshal_context context;
+  std::vector<lldb_eval::ContextVariable> vars =
+      ToContextVariables(contextVars, context);
+  lldb_eval::Options opts;
+  opts.allow_side_effects = false;
+  opts.context_vars = {vars.data(), vars.size()};
+  lldb::SBValue result =
+      lldb_eval::EvaluateExpression(sbValue, compiled, opts, error);
+  return gcnew LLDBValue(ConvertToDynamicValue(result), error);
+}
+
+void LldbEval::ReleaseCompiledExpression(int64_t handle) {
+  YetiVSI::DebugEngine::ReleaseCompiledExpression(handle);
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
@@ -34,9 +34,25 @@ ref class LldbEval abstract sealed {
       EvaluateExpression(SbValue ^ value, System::String ^ expression,
                          IDictionary<System::String ^, SbValue ^> ^ contextVars);
 
+  // Compiles |expression| and returns the result type. |handle| receives a
+  // handle to the compiled expression, or 0 if compilation failed. Handles are
+  // reference counted, so every handle returned must be released. They stay
+  // valid until their last reference is released. A handle becomes stale if
+  // modules that define its types are unloaded or load symbols, or its process
+  // exits.
   static System::Tuple<SbType ^, SbError ^> ^
       CompileExpression(SbTarget ^ target, SbType ^ scope, System::String ^ expression,
-                        IDictionary<System::String ^, SbType ^> ^ contextArgs);
+                        IDictionary<System::String ^, SbType ^> ^ contextArgs,
+                        [System::Runtime::InteropServices::Out] int64_t % handle);
+
+  // Evaluates the expression of |handle| in the scope of |value|. The context
+  // variables must have the types of the context arguments it was compiled
+  // with. Released and stale handles fail with different errors.
+  static SbValue ^
+      EvaluateCompiledExpression(SbValue ^ value, int64_t handle,
+                                 IDictionary<System::String ^, SbValue ^> ^ contextVars);
+
+  static void ReleaseCompiledExpression(int64_t handle);
 };
 
 }  // namespace DebugEngine
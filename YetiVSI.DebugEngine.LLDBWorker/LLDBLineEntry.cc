@@ -28,6 +28,12 @@ LLDBLineEntry::LLDBLineEntry(lldb::SBLineEntry line_entry) {
   line_entry_ = MakeUniquePtr<lldb::SBLineEntry>(line_entry);
 }
 
+LLDBLineEntry::LLDBLineEntry(lldb::SBLineEntry line_entry,
+                             lldb::SBAddress start_address) {
+  line_entry_ = MakeUniquePtr<lldb::SBLineEntry>(line_entry);
+  start_address_ = MakeUniquePtr<lldb::SBAddress>(start_address);
+}
+
 System::String ^ LLDBLineEntry::GetFileName() {
   return gcnew System::String(line_entry_->GetFileSpec().GetFilename());
 }
@@ -41,7 +47,8 @@ uint32_t LLDBLineEntry::GetLine() { return line_entry_->GetLine(); }
 uint32_t LLDBLineEntry::GetColumn() { return line_entry_->GetColumn(); }
 
 SbAddress ^ LLDBLineEntry::GetStartAddress() {
-  auto address = line_entry_->GetStartAddress();
+  auto address = start_address_ != nullptr ? *(*start_address_)
+                                           : line_entry_->GetStartAddress();
   if (!address.IsValid()) {
     return nullptr;
   }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "lldb/API/SBAddress.h"
 #include "lldb/API/SBLineEntry.h"
 
 #include "ManagedUniquePtr.h"
@@ -29,6 +30,9 @@ private
 ref class LLDBLineEntry sealed : SbLineEntry {
  public:
   LLDBLineEntry(lldb::SBLineEntry);
+  // For line entries that are not from an LLDB line table, which can't store
+  // their start address.
+  LLDBLineEntry(lldb::SBLineEntry, lldb::SBAddress start_address);
   virtual ~LLDBLineEntry(){};
   virtual System::String ^ GetFileName();
   virtual System::String ^ GetDirectory();
@@ -39,6 +43,7 @@ ref class LLDBLineEntry sealed : SbLineEntry {
 
  private:
   ManagedUniquePtr<lldb::SBLineEntry> ^ line_entry_;
+  ManagedUniquePtr<lldb::SBAddress> ^ start_address_;
 };
 
 }  // namespace DebugEngine
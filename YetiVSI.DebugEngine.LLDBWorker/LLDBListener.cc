@@ -14,12 +14,40 @@
 
 #include "LLDBListener.h"
 
+#include <vector>
+
+#include "AddressLineTable.h"
+#include "CompiledExpressionCache.h"
+#include "DisassemblyCache.h"
 #include "LLDBEvent.h"
 #include "LLDBObject.h"
+#include "ModuleMetadata.h"
+#include "PageWatchpoint.h"
+#include "SourceLineIndex.h"
+#include "SymbolSearchIndex.h"
+#include "FlatTypeLayout.h"
+#include "SplitDwarfLoader.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
 
+namespace {
+
+std::vector<lldb::SBModule> GetModulesFromEvent(const lldb::SBEvent& event) {
+  std::vector<lldb::SBModule> modules(
+      lldb::SBTarget::GetNumModulesFromEvent(event));
+  for (size_t i = 0; i < modules.size(); ++i) {
+    modules[i] = lldb::SBTarget::GetModuleAtIndexFromEvent(
+        static_cast<uint32_t>(i), event);
+  }
+  return modules;
+}
+
+}  // namespace
+
 LLDBListener::LLDBListener(lldb::SBListener listener) {
   listener_ = MakeUniquePtr<lldb::SBListener>(listener);
 }
@@ -31,6 +59,47 @@ bool LLDBListener::WaitForEvent(
     [System::Runtime::InteropServices::Out] SbEvent ^ % out_event) {
   lldb::SBEvent sbEvent;
   if (listener_->WaitForEvent(num_seconds, sbEvent)) {
+    // Start disassembling the stopped code while the event is handled, so the
+    // Disassembly window doesn't have to wait for it.
+    if (lldb::SBProcess::EventIsProcessEvent(sbEvent) &&
+        lldb::SBProcess::GetStateFromEvent(sbEvent) == lldb::eStateStopped &&
+        !lldb::SBProcess::GetRestartedFromEvent(sbEvent)) {
+      PrefetchDisassembly(lldb::SBProcess::GetProcessFromEvent(sbEvent));
+    }
+    // The page watchpoints of a process that is gone can't be restored, and
+    // its compiled expressions can't be evaluated anymore.
+    if (lldb::SBProcess::EventIsProcessEvent(sbEvent) &&
+        lldb::SBProcess::GetStateFromEvent(sbEvent) == lldb::eStateExited) {
+      RemovePageWatchpoints(lldb::SBProcess::GetProcessFromEvent(sbEvent),
+                            false);
+      ForgetCompiledExpressions(lldb::SBProcess::GetProcessFromEvent(sbEvent));
+    }
+    // Index the symbols and source lines of loaded modules and load their
+    // split DWARF, so function searches, file and line breakpoints and the
+    // first expression don't have to wait for it.
+    if (lldb::SBTarget::EventIsTargetEvent(sbEvent) &&
+        (sbEvent.GetType() & (lldb::SBTarget::eBroadcastBitModulesLoaded |
+                              lldb::SBTarget::eBroadcastBitSymbolsLoaded))) {
+      std::vector<lldb::SBModule> modules = GetModulesFromEvent(sbEvent);
+      LoadSplitDwarfInBackground(modules);
+      BuildSourceLineIndexesInBackground(modules);
+      BuildSymbolTrigramIndexesInBackground(std::move(modules));
+    }
+    if (lldb::SBTarget::EventIsTargetEvent(sbEvent) &&
+        (sbEvent.GetType() & lldb::SBTarget::eBroadcastBitModulesUnloaded)) {
+      std::vector<lldb::SBModule> modules = GetModulesFromEvent(sbEvent);
+      ForgetModuleMetadata(modules);
+    }
+    if (lldb::SBTarget::EventIsTargetEvent(sbEvent) &&
+        (sbEvent.GetType() & (lldb::SBTarget::eBroadcastBitModulesUnloaded |
+                              lldb::SBTarget::eBroadcastBitSymbolsLoaded))) {
+      std::vector<lldb::SBModule> modules = GetModulesFromEvent(sbEvent);
+      EvictCompiledExpressions(lldb::SBTarget::GetTargetFromEvent(sbEvent),
+                               modules);
+      ClearTypeLayouts();
+      ClearDisassembly();
+      ClearAddressLineTables();
+    }
     out_event = gcnew LLDBEvent(sbEvent);
     return true;
   } else {
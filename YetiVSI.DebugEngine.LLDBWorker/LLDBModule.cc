@@ -24,63 +24,16 @@
 #include "LLDBFileSpec.h"
 #include "LLDBObject.h"
 #include "LLDBSection.h"
+#include "ModuleMetadata.h"
 
 #using < system.dll>
 
 namespace YetiVSI {
 namespace DebugEngine {
 
-namespace {
-
-void Log(System::String ^ message) {
-  System::String ^ tagged_message =
-      System::String::Format("LLDBModule: {0}", message);
-  System::Diagnostics::Debug::WriteLine(tagged_message);
-}
-
-bool FindFirstCodeSection(lldb::SBSection section, lldb::SBSection* out) {
-  if (section.GetSectionType() == lldb::eSectionTypeCode) {
-    *out = section;
-    return true;
-  }
-  size_t num_sub_sections = section.GetNumSubSections();
-  for (size_t i = 0; i < num_sub_sections; i++) {
-    if (FindFirstCodeSection(section.GetSubSectionAtIndex(i), out)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-}  // namespace
-
 LLDBModule::LLDBModule(lldb::SBModule module, lldb::SBTarget target) {
   module_ = MakeUniquePtr<lldb::SBModule>(module);
   target_ = MakeUniquePtr<lldb::SBTarget>(target);
-
-  // Find the target's architecture, the first item in the triple
-  try {
-    architecture_ = (gcnew System::String(module.GetTriple()))->Split('-')[0];
-  } catch (System::IndexOutOfRangeException ^) {
-    Log("Could not determine architecture of " +
-        gcnew System::String(module.GetPlatformFileSpec().GetFilename()));
-  }
-
-  // Find the code section (name should be .text, __TEXT, etc)
-  lldb::SBSection section;
-  size_t num_sections = module.GetNumSections();
-  for (size_t i = 0; i < num_sections; ++i) {
-    if (FindFirstCodeSection(module.GetSectionAtIndex(i), &section)) {
-      code_section_ = MakeUniquePtr<lldb::SBSection>(section);
-      break;
-    }
-  }
-
-  if (code_section_ == nullptr) {
-    Log("Module " +
-        gcnew System::String(module.GetPlatformFileSpec().GetFilename()) +
-        " does not have a code section");
-  }
 }
 
 SbFileSpec ^ LLDBModule::GetFileSpec() {
@@ -113,10 +66,11 @@ SbFileSpec ^ LLDBModule::GetSymbolFileSpec() {
 }
 
 uint64_t LLDBModule::GetCodeLoadAddress() {
-  if (code_section_ == nullptr) {
+  const ModuleMetadata& metadata = GetMetadata();
+  if (!metadata.code_section.IsValid()) {
     return 0;
   }
-  return code_section_->GetLoadAddress(*(*target_));
+  return metadata.code_section.GetLoadAddress(*(*target_));
 }
 
 SbAddress^ LLDBModule::GetObjectFileHeaderAddress() {
@@ -129,13 +83,14 @@ SbAddress^ LLDBModule::GetObjectFileHeaderAddress() {
 }
 
 uint64_t LLDBModule::GetCodeSize() {
-  if (code_section_ == nullptr) {
+  const ModuleMetadata& metadata = GetMetadata();
+  if (!metadata.code_section.IsValid()) {
     return 0;
   }
-  return code_section_->GetByteSize();
+  return metadata.code_section.GetByteSize();
 }
 
-bool LLDBModule::Is64Bit() { return architecture_->Equals("x86_64"); }
+bool LLDBModule::Is64Bit() { return GetMetadata().architecture == "x86_64"; }
 
 bool LLDBModule::HasSymbols() { return module_->GetNumSymbols() != 0; }
 
@@ -175,5 +130,13 @@ bool LLDBModule::EqualTo(SbModule ^ otherModule) {
 
 lldb::SBModule LLDBModule::GetNativeObject() { return *(*module_).Get(); }
 
+const ModuleMetadata& LLDBModule::GetMetadata() {
+  if (metadata_ == nullptr) {
+    metadata_ = MakeUniquePtr<ModuleMetadata>(
+        YetiVSI::DebugEngine::GetModuleMetadata(*(*module_)));
+  }
+  return *(*metadata_);
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
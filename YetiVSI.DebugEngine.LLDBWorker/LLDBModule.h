@@ -20,6 +20,7 @@
 #include "lldb/API/SBStream.h"
 
 #include "ManagedUniquePtr.h"
+#include "ModuleMetadata.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
@@ -53,10 +54,12 @@ ref class LLDBModule sealed : SbModule {
   lldb::SBModule GetNativeObject();
 
  private:
+  // Looked up on first use, since most wrappers never need it.
+  const ModuleMetadata& GetMetadata();
+
   ManagedUniquePtr<lldb::SBModule> ^ module_;
   ManagedUniquePtr<lldb::SBTarget> ^ target_;
-  ManagedUniquePtr<lldb::SBSection> ^ code_section_;
-  System::String ^ architecture_;
+  ManagedUniquePtr<ModuleMetadata> ^ metadata_;
 };
 
 }  // namespace DebugEngine
@@ -0,0 +1,61 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "LLDBPageWatchpoint.h"
+
+#include <msclr\marshal_cppstd.h>
+
+#include "PageWatchpoint.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+LLDBPageWatchpoint::LLDBPageWatchpoint(int32_t id) : id_(id) {}
+
+int LLDBPageWatchpoint::GetId() { return id_; }
+
+unsigned int LLDBPageWatchpoint::GetHitCount() {
+  PageWatchpointStats stats;
+  GetPageWatchpointStats(id_, &stats);
+  return stats.hit_count;
+}
+
+void LLDBPageWatchpoint::SetEnabled(bool enabled) {
+  SetPageWatchpointEnabled(id_, enabled);
+}
+
+void LLDBPageWatchpoint::SetCondition(System::String ^ condition) {
+  SetPageWatchpointCondition(
+      id_, condition == nullptr
+               ? std::string()
+               : msclr::interop::marshal_as<std::string>(condition));
+}
+
+void LLDBPageWatchpoint::SetIgnoreCount(unsigned int ignoreCount) {
+  SetPageWatchpointIgnoreCount(id_, ignoreCount);
+}
+
+WatchpointStats LLDBPageWatchpoint::GetStats() {
+  PageWatchpointStats native_stats;
+  GetPageWatchpointStats(id_, &native_stats);
+  WatchpointStats stats;
+  stats.HitCount = native_stats.hit_count;
+  stats.FaultCount = native_stats.fault_count;
+  stats.FilteredFaultCount = native_stats.filtered_count;
+  stats.TotalHandlingNanoseconds = native_stats.total_handling_ns;
+  return stats;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+using namespace LldbApi;
+
+// A watchpoint implemented with page protection, see PageWatchpoint.h. Used
+// for ranges that are too large for the debug registers.
+private
+ref class LLDBPageWatchpoint sealed : SbWatchpoint {
+ public:
+  LLDBPageWatchpoint(int32_t id);
+  virtual ~LLDBPageWatchpoint(){};
+
+  virtual int GetId();
+  virtual unsigned int GetHitCount();
+  virtual void SetEnabled(bool enabled);
+  virtual void SetCondition(System::String ^ condition);
+  virtual void SetIgnoreCount(unsigned int ignoreCount);
+  virtual WatchpointStats GetStats();
+
+ private:
+  int32_t id_;
+};
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -18,8 +18,10 @@
 
 #include <msclr/marshal_cppstd.h>
 
+#include <algorithm>
 #include <vector>
 
+#include "AddressRangeUtil.h"
 #include "LLDBBreakpoint.h"
 #include "LLDBError.h"
 #include "LLDBMemoryRegionInfo.h"
@@ -27,6 +29,8 @@
 #include "LLDBTarget.h"
 #include "LLDBThread.h"
 #include "LLDBUnixSignals.h"
+#include "MinidumpMemoryWriter.h"
+#include "PageWatchpoint.h"
 #include "lldb/API/SBError.h"
 #include "lldb/API/SBEvent.h"
 #include "lldb/API/SBMemoryRegionInfoList.h"
@@ -100,6 +104,14 @@ bool LLDBProcess::Continue() {
 }
 
 bool LLDBProcess::Detach(bool keepStopped) {
+  // The pages protected for page watchpoints would keep faulting without a
+  // debugger. Restoring them needs the process to be stopped.
+  if (HasPageWatchpoints(*(*process_))) {
+    if (process_->GetState() != lldb::eStateStopped) {
+      process_->Stop();
+    }
+    RemovePageWatchpoints(*(*process_), true);
+  }
   lldb::SBError error = process_->Detach(keepStopped);
   if (error.Fail()) {
     Log("Failed to detach process: " +
@@ -116,6 +128,7 @@ bool LLDBProcess::Kill() {
     Log("Failed to kill process: " + gcnew System::String(error.GetCString()));
     return false;
   }
+  RemovePageWatchpoints(*(*process_), false);
   Log("Killed process");
   return true;
 }
@@ -164,6 +177,72 @@ size_t LLDBProcess::WriteMemory(
   return bytesWrote;
 }
 
+System::Collections::Generic::List<SbError ^> ^ LLDBProcess::WriteMemory(
+    System::Collections::Generic::List<MemoryWrite> ^ writes) {
+  std::vector<AddressRange> write_ranges;
+  write_ranges.reserve(writes->Count);
+  for each (MemoryWrite write in writes) {
+    uint64_t size = write.Buffer == nullptr ? 0 : write.Buffer->Length;
+    write_ranges.push_back({write.Address, size});
+  }
+
+  // Adjacent and overlapping writes are merged into a single buffer, which is
+  // written with one call. Writes are copied into the buffers in order, so later
+  // writes take precedence over earlier ones.
+  std::vector<AddressRange> merged = CoalesceRanges(write_ranges);
+  std::vector<std::vector<uint8_t>> buffers(merged.size());
+  for (size_t i = 0; i < merged.size(); ++i) {
+    buffers[i].resize(merged[i].size);
+  }
+  std::vector<size_t> merged_index(write_ranges.size());
+  for (int i = 0; i < writes->Count; ++i) {
+    const AddressRange& range = write_ranges[i];
+    if (range.size == 0) {
+      continue;
+    }
+    auto it = std::upper_bound(
+        merged.begin(), merged.end(), range.base,
+        [](uint64_t address, const AddressRange& r) { return address < r.base; });
+    size_t index = std::distance(merged.begin(), it) - 1;
+    merged_index[i] = index;
+    System::Runtime::InteropServices::Marshal::Copy(
+        writes[i].Buffer, 0,
+        System::IntPtr(buffers[index].data() + (range.base - merged[index].base)),
+        static_cast<int>(range.size));
+  }
+
+  // Process::WriteMemory only flushes the written range from the memory cache.
+  std::vector<lldb::SBError> merged_errors(merged.size());
+  std::vector<size_t> bytes_written(merged.size());
+  for (size_t i = 0; i < merged.size(); ++i) {
+    bytes_written[i] = process_->WriteMemory(
+        merged[i].base, buffers[i].data(), merged[i].size, merged_errors[i]);
+  }
+
+  auto errors = gcnew System::Collections::Generic::List<SbError ^>(writes->Count);
+  for (int i = 0; i < writes->Count; ++i) {
+    lldb::SBError error;
+    const AddressRange& range = write_ranges[i];
+    if (range.size > 0) {
+      size_t index = merged_index[i];
+      uint64_t written_end = merged[index].base + bytes_written[index];
+      if (written_end < range.End()) {
+        if (merged_errors[index].Fail()) {
+          error = merged_errors[index];
+        } else {
+          uint64_t written =
+              written_end > range.base ? written_end - range.base : 0;
+          error.SetErrorStringWithFormat(
+              "Wrote %llu out of %llu bytes at 0x%llx", written, range.size,
+              range.base);
+        }
+      }
+    }
+    errors->Add(gcnew LLDBError(error));
+  }
+  return errors;
+}
+
 SbError ^ LLDBProcess::GetMemoryRegionInfo(
               uint64_t address,
               [System::Runtime::InteropServices::Out] SbMemoryRegionInfo ^
@@ -175,12 +254,55 @@ SbError ^ LLDBProcess::GetMemoryRegionInfo(
   return gcnew LLDBError(error);
 }
 
-SbError ^ LLDBProcess::SaveCore(System::String ^ dumpPath) {
+SbError ^ LLDBProcess::SaveCore(
+    System::String ^ dumpPath, SaveCoreStyle style,
+    System::Collections::Generic::List<MemoryRange> ^ customRanges) {
   std::string file_name = msclr::interop::marshal_as<std::string>(dumpPath);
+  // LLDB's minidump writer only supports stack-only dumps, so the remaining
+  // memory is appended to the dump it creates.
   lldb::SBError error = process_->SaveCore(
       file_name.c_str(), "minidump", lldb::SaveCoreStyle::eSaveCoreStackOnly);
+  if (error.Fail() || style == SaveCoreStyle::StackOnly) {
+    return gcnew LLDBError(error);
+  }
+
+  std::vector<AddressRange> ranges;
+  switch (style) {
+    case SaveCoreStyle::ModifiedPages:
+      ranges = CollectCoreRanges(*(*process_), true);
+      break;
+    case SaveCoreStyle::Full:
+      ranges = CollectCoreRanges(*(*process_), false);
+      break;
+    case SaveCoreStyle::Custom:
+      if (customRanges != nullptr) {
+        ranges.reserve(customRanges->Count);
+        for each (MemoryRange range in customRanges) {
+          ranges.push_back({range.Address, range.Size});
+        }
+      }
+      break;
+  }
+  error = AppendMemoryToMinidump(*(*process_), file_name, ranges);
   return gcnew LLDBError(error);
 }
 
+PageWatchpointStopResult LLDBProcess::HandlePageWatchpointStop(
+    [System::Runtime::InteropServices::Out] int % watchpointId) {
+  int32_t id = 0;
+  PageWatchpointStop result =
+      YetiVSI::DebugEngine::HandlePageWatchpointStop(*(*process_), &id);
+  watchpointId = id;
+  switch (result) {
+    case PageWatchpointStop::kResumed:
+      Log("Handled a page watchpoint fault");
+      return PageWatchpointStopResult::Resumed;
+    case PageWatchpointStop::kHit:
+      return PageWatchpointStopResult::Hit;
+    default:
+      return PageWatchpointStopResult::NotHandled;
+  }
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
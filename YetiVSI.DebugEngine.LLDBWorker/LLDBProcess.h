@@ -54,9 +54,14 @@ ref class LLDBProcess sealed : SbProcess {
   virtual size_t WriteMemory(uint64_t address,
     array<unsigned char> ^ buffer, size_t size,
     [System::Runtime::InteropServices::Out] SbError ^ % out_error);
+  virtual System::Collections::Generic::List<SbError ^> ^ WriteMemory(
+    System::Collections::Generic::List<MemoryWrite> ^ writes);
   virtual SbError ^ GetMemoryRegionInfo(uint64_t address,
     [System::Runtime::InteropServices::Out] SbMemoryRegionInfo ^ % memory_region);
-  virtual SbError ^ SaveCore(System::String ^ dumpPath);
+  virtual SbError ^ SaveCore(System::String ^ dumpPath, SaveCoreStyle style,
+    System::Collections::Generic::List<MemoryRange> ^ customRanges);
+  virtual PageWatchpointStopResult HandlePageWatchpointStop(
+    [System::Runtime::InteropServices::Out] int % watchpointId);
 private:
   ManagedUniquePtr<lldb::SBProcess> ^ process_;
 };
@@ -16,8 +16,16 @@
 
 #include <msclr/marshal_cppstd.h>
 
+#include <map>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBFileSpec.h"
 #include "lldb/API/SBProcess.h"
 
+#include "AddressLineTable.h"
+#include "BreakpointCondition.h"
+#include "DisassemblyCache.h"
 #include "LLDBAddress.h"
 #include "LLDBBreakpoint.h"
 #include "LLDBBroadcaster.h"
@@ -26,12 +34,33 @@
 #include "LLDBListener.h"
 #include "LLDBModule.h"
 #include "LLDBObject.h"
+#include "LLDBPageWatchpoint.h"
 #include "LLDBProcess.h"
 #include "LLDBWatchpoint.h"
+#include "ModuleMetadata.h"
+#include "PageWatchpoint.h"
+#include "ParallelUtil.h"
+#include "SourceLineIndex.h"
+#include "SymbolSearchIndex.h"
 
 namespace YetiVSI {
 namespace DebugEngine {
 
+namespace {
+
+// Parses the symbol tables of all modules of |target| on the thread pool.
+// LLDB would otherwise parse them one at a time on first use.
+void PreloadSymbolTables(lldb::SBTarget target) {
+  std::vector<lldb::SBModule> modules(target.GetNumModules());
+  for (size_t i = 0; i < modules.size(); ++i) {
+    modules[i] = target.GetModuleAtIndex(static_cast<uint32_t>(i));
+  }
+  ParallelFor(static_cast<int32_t>(modules.size()),
+              [&](int32_t i) { modules[i].GetNumSymbols(); });
+}
+
+}  // namespace
+
 LLDBTarget::LLDBTarget(lldb::SBTarget target) {
   target_ = MakeUniquePtr<lldb::SBTarget>(target);
 }
@@ -55,13 +84,48 @@ SbBreakpoint ^ LLDBTarget::BreakpointCreateByLocation(System::String ^ file,
                                                       uint32_t line) {
   auto name = msclr::interop::marshal_as<std::string>(file);
   lldb::SBBreakpoint breakpoint =
-      target_->BreakpointCreateByLocation(name.c_str(), line);
+      BreakpointCreateFromSourceLineIndex(*(*target_), name, line);
+  if (!breakpoint.IsValid()) {
+    breakpoint = target_->BreakpointCreateByLocation(name.c_str(), line);
+  }
   if (!breakpoint.IsValid()) {
     return nullptr;
   }
   return gcnew LLDBBreakpoint(breakpoint);
 }
 
+System::Collections::Generic::List<SbBreakpoint ^> ^
+    LLDBTarget::BreakpointCreateByLocations(
+        System::Collections::Generic::List<SourceLine> ^ locations) {
+  // Locations are resolved through the source line indexes that are ready,
+  // which are built with a single pass over each compile unit's line table.
+  // This doesn't wait for missing indexes: while a module with line tables
+  // isn't indexed yet, locations fall back to LLDB's search. Locations are
+  // grouped by file, so that each file spec is only created once.
+  std::map<std::string, std::vector<int>> indices_by_file;
+  for (int i = 0; i < locations->Count; ++i) {
+    indices_by_file[msclr::interop::marshal_as<std::string>(locations[i].File)]
+        .push_back(i);
+  }
+
+  auto breakpoints = gcnew array<SbBreakpoint ^>(locations->Count);
+  for (const auto& entry : indices_by_file) {
+    lldb::SBFileSpec file_spec(entry.first.c_str(), false);
+    for (int index : entry.second) {
+      uint32_t line = locations[index].Line;
+      lldb::SBBreakpoint breakpoint =
+          BreakpointCreateFromSourceLineIndex(*(*target_), entry.first, line);
+      if (!breakpoint.IsValid()) {
+        breakpoint = target_->BreakpointCreateByLocation(file_spec, line);
+      }
+      if (breakpoint.IsValid()) {
+        breakpoints[index] = gcnew LLDBBreakpoint(breakpoint);
+      }
+    }
+  }
+  return gcnew System::Collections::Generic::List<SbBreakpoint ^>(breakpoints);
+}
+
 SbBreakpoint ^ LLDBTarget::BreakpointCreateByName(System::String ^ symbolName) {
   auto name = msclr::interop::marshal_as<std::string>(symbolName);
   lldb::SBBreakpoint breakpoint = target_->BreakpointCreateByName(name.c_str());
@@ -71,6 +135,32 @@ SbBreakpoint ^ LLDBTarget::BreakpointCreateByName(System::String ^ symbolName) {
   return gcnew LLDBBreakpoint(breakpoint);
 }
 
+System::Collections::Generic::List<FunctionMatch> ^
+    LLDBTarget::FindFunctionsMatching(System::String ^ pattern,
+                                      uint32_t maxMatches) {
+  std::vector<SymbolMatch> symbol_matches;
+  if (!YetiVSI::DebugEngine::FindFunctionsMatching(
+          *(*target_), msclr::interop::marshal_as<std::string>(pattern),
+          maxMatches, &symbol_matches)) {
+    return nullptr;
+  }
+  auto matches = gcnew System::Collections::Generic::List<FunctionMatch>(
+      static_cast<int>(symbol_matches.size()));
+  for (SymbolMatch& symbol_match : symbol_matches) {
+    FunctionMatch match;
+    match.Name = gcnew System::String(symbol_match.name.c_str());
+    const char* module_name =
+        symbol_match.module.GetPlatformFileSpec().GetFilename();
+    match.ModuleName = gcnew System::String(module_name ? module_name : "");
+    match.FileAddress = symbol_match.file_address;
+    match.LoadAddress =
+        symbol_match.module.ResolveFileAddress(symbol_match.file_address)
+            .GetLoadAddress(*(*target_));
+    matches->Add(match);
+  }
+  return matches;
+}
+
 SbBreakpoint ^ LLDBTarget::BreakpointCreateByAddress(uint64_t address) {
   lldb::SBBreakpoint breakpoint = target_->BreakpointCreateByAddress(address);
   if (!breakpoint.IsValid()) {
@@ -88,6 +178,7 @@ SbBreakpoint ^ LLDBTarget::FindBreakpointById(int32_t id) {
 }
 
 bool LLDBTarget::BreakpointDelete(int32_t id) {
+  ClearBreakpointConditions(id);
   return target_->BreakpointDelete(id);
 }
 
@@ -105,6 +196,29 @@ SbModule ^ LLDBTarget::GetModuleAtIndex(int32_t index) {
   return module.IsValid() ? gcnew LLDBModule(module, *(*target_)) : nullptr;
 }
 
+System::Collections::Generic::List<ModuleSnapshot> ^
+    LLDBTarget::GetModuleSnapshot() {
+  std::vector<ModuleInfo> infos = GetModuleInfos(*(*target_));
+  auto snapshots = gcnew System::Collections::Generic::List<ModuleSnapshot>(
+      static_cast<int>(infos.size()));
+  for (const ModuleInfo& info : infos) {
+    ModuleSnapshot snapshot;
+    if (info.module.IsValid()) {
+      snapshot.Module = gcnew LLDBModule(info.module, *(*target_));
+    }
+    snapshot.PlatformPath = gcnew System::String(info.platform_path.c_str());
+    snapshot.SymbolPath = gcnew System::String(info.symbol_path.c_str());
+    snapshot.Uuid = gcnew System::String(info.uuid.c_str());
+    snapshot.Triple = gcnew System::String(info.triple.c_str());
+    snapshot.CodeLoadAddress = info.code_load_address;
+    snapshot.CodeSize = info.code_size;
+    snapshot.HasSymbols = info.has_symbols;
+    snapshot.HasCompileUnits = info.has_compile_units;
+    snapshots->Add(snapshot);
+  }
+  return snapshots;
+}
+
 int64_t LLDBTarget::GetId() {
   return GetSPAddress<lldb::SBTarget>(GetNativeObject());
 }
@@ -116,6 +230,19 @@ SbWatchpoint ^
                              bool write,
                              [System::Runtime::InteropServices::Out] SbError ^
                                  % out_error) {
+  // The debug registers watch at most 8 aligned bytes each, larger ranges use
+  // page protection.
+  if (size > kMaxHardwareWatchSize ||
+      (address & (kMaxHardwareWatchSize - 1)) + size > kMaxHardwareWatchSize) {
+    int32_t id;
+    lldb::SBError error =
+        CreatePageWatchpoint(*(*target_), address, size, read, write, &id);
+    out_error = gcnew LLDBError(error);
+    if (error.Fail()) {
+      return nullptr;
+    }
+    return gcnew LLDBPageWatchpoint(id);
+  }
   lldb::SBError error;
   lldb::SBWatchpoint watchpoint =
       target_->WatchAddress(address, size, read, write, error);
@@ -127,6 +254,9 @@ SbWatchpoint ^
 }
 
 bool LLDBTarget::DeleteWatchpoint(int32_t watchId) {
+  if (IsPageWatchpointId(watchId)) {
+    return DeletePageWatchpoint(watchId);
+  }
   return target_->DeleteWatchpoint(watchId);
 }
 
@@ -169,12 +299,82 @@ LLDBTarget::GetInstructionsWithFlavor(SbAddress^ baseAddress,
   return list;
 }
 
+DisassemblyRecords ^ LLDBTarget::DisassembleRange(uint64_t address,
+                                                  uint32_t count,
+                                                  System::String ^ flavor) {
+  DisassemblyRange range = YetiVSI::DebugEngine::DisassembleRange(
+      *(*target_), address, count,
+      msclr::interop::marshal_as<std::string>(flavor));
+
+  using System::Collections::Generic::List;
+  auto records = gcnew DisassemblyRecords();
+  records->Instructions = gcnew List<InstructionRecord>(
+      static_cast<int>(range.instructions.size()));
+  for (const DisassembledInstruction& instruction : range.instructions) {
+    InstructionRecord record;
+    record.Address = instruction.address;
+    record.Size = instruction.size;
+    record.Bytes =
+        gcnew array<unsigned char>(static_cast<int>(instruction.bytes.size()));
+    if (record.Bytes->Length > 0) {
+      System::Runtime::InteropServices::Marshal::Copy(
+          System::IntPtr(const_cast<uint8_t*>(instruction.bytes.data())),
+          record.Bytes, 0, record.Bytes->Length);
+    }
+    record.Mnemonic = gcnew System::String(instruction.mnemonic.c_str());
+    record.Operands = gcnew System::String(instruction.operands.c_str());
+    record.Comment = gcnew System::String(instruction.comment.c_str());
+    record.LineEntryIndex = instruction.line_entry_index;
+    record.SymbolIndex = instruction.symbol_index;
+    records->Instructions->Add(record);
+  }
+  records->LineEntries = gcnew List<LineEntryRecord>(
+      static_cast<int>(range.line_entries.size()));
+  for (const DisassemblyLineEntry& line_entry : range.line_entries) {
+    LineEntryRecord record;
+    record.FileName = gcnew System::String(line_entry.file_name.c_str());
+    record.Directory = gcnew System::String(line_entry.directory.c_str());
+    record.Line = line_entry.line;
+    record.Column = line_entry.column;
+    records->LineEntries->Add(record);
+  }
+  records->Symbols =
+      gcnew List<SymbolRecord>(static_cast<int>(range.symbols.size()));
+  for (const DisassemblySymbol& symbol : range.symbols) {
+    SymbolRecord record;
+    record.Name = gcnew System::String(symbol.name.c_str());
+    record.StartAddress = symbol.start_address;
+    records->Symbols->Add(record);
+  }
+  return records;
+}
+
+System::Collections::Generic::List<LineEntryRecord> ^
+    LLDBTarget::ResolveLineEntries(
+        System::Collections::Generic::List<uint64_t> ^ loadAddresses) {
+  auto records = gcnew System::Collections::Generic::List<LineEntryRecord>(
+      loadAddresses->Count);
+  for each (uint64_t address in loadAddresses) {
+    LineEntryRecord record;
+    ResolvedLineEntry entry;
+    if (ResolveLineEntry(target_->ResolveLoadAddress(address), &entry)) {
+      record.FileName = gcnew System::String(entry.file_name.c_str());
+      record.Directory = gcnew System::String(entry.directory.c_str());
+      record.Line = entry.line;
+      record.Column = entry.column;
+    }
+    records->Add(record);
+  }
+  return records;
+}
+
 SbProcess^ LLDBTarget::LoadCore(System::String^ corePath) {
   auto process = target_->LoadCore(
       msclr::interop::marshal_as<std::string>(corePath).c_str());
   if (!process.IsValid()) {
     return nullptr;
   }
+  PreloadSymbolTables(*(*target_));
   return gcnew LLDBProcess(process);
 }
 
@@ -186,7 +386,14 @@ LldbApi::SbModule ^ LLDBTarget::AddModule(System::String ^ path,
   auto tripleCStr = context.marshal_as<const char*>(triple);
   auto uuidCStr = context.marshal_as<const char*>(uuid);
   auto module = target_->AddModule(pathCStr, tripleCStr, uuidCStr);
-  return module.IsValid() ? gcnew LLDBModule(module, *(*target_)) : nullptr;
+  if (!module.IsValid()) {
+    return nullptr;
+  }
+  // Parse the symbol table now. Binaries of a core dump are added from
+  // concurrent RPCs, so they are parsed in parallel instead of one by one on
+  // first use.
+  module.GetNumSymbols();
+  return gcnew LLDBModule(module, *(*target_));
 }
 
 bool LLDBTarget::RemoveModule(SbModule ^ module) {
@@ -202,6 +409,19 @@ SbError ^ LLDBTarget::SetModuleLoadAddress(SbModule ^ module,
   return gcnew LLDBError(error);
 }
 
+SbError ^ LLDBTarget::AddSymbolFile(SbModule ^ module,
+                                    System::String ^ symbolFilePath) {
+  auto lldbModule = safe_cast<LLDBModule ^>(module);
+  msclr::interop::marshal_context context;
+  lldb::SBFileSpec symbolFile(context.marshal_as<const char*>(symbolFilePath));
+  // Symbol loading RPCs for different modules run concurrently. The symbol
+  // file is parsed and indexed without the target's API mutex (patch 0052),
+  // so they don't wait for each other.
+  lldb::SBModule nativeModule = lldbModule->GetNativeObject();
+  auto error = target_->AddSymbolFile(nativeModule, symbolFile);
+  return gcnew LLDBError(error);
+}
+
 SbProcess ^ LLDBTarget::GetProcess() {
   auto process = target_->GetProcess();
   if (!process.IsValid()) {
@@ -37,12 +37,19 @@ ref class LLDBTarget sealed : SbTarget {
                                 % out_error);
   virtual SbBreakpoint ^
       BreakpointCreateByLocation(System::String ^ file, uint32_t line);
+  virtual System::Collections::Generic::List<SbBreakpoint ^> ^
+      BreakpointCreateByLocations(
+          System::Collections::Generic::List<SourceLine> ^ locations);
   virtual SbBreakpoint ^ BreakpointCreateByName(System::String ^ symbolName);
+  virtual System::Collections::Generic::List<FunctionMatch> ^
+      FindFunctionsMatching(System::String ^ pattern, uint32_t maxMatches);
   virtual SbBreakpoint ^ BreakpointCreateByAddress(uint64_t address);
   virtual SbBreakpoint ^ FindBreakpointById(int32_t id);
   virtual bool BreakpointDelete(int32_t id);
   virtual int32_t GetNumModules();
   virtual SbModule ^ GetModuleAtIndex(int32_t index);
+  virtual System::Collections::Generic::List<ModuleSnapshot> ^
+      GetModuleSnapshot();
   virtual bool operator==(SbTarget ^ target);
   virtual int64_t GetId();
   virtual SbWatchpoint ^
@@ -59,12 +66,20 @@ ref class LLDBTarget sealed : SbTarget {
                                 array<unsigned char>^ buffer,
                                 unsigned long long size,
                                 System::String^ flavor);
+  virtual DisassemblyRecords ^ DisassembleRange(uint64_t address,
+                                                uint32_t count,
+                                                System::String ^ flavor);
+  virtual System::Collections::Generic::List<LineEntryRecord> ^
+      ResolveLineEntries(
+          System::Collections::Generic::List<uint64_t> ^ loadAddresses);
   virtual SbProcess ^ LoadCore(System::String ^ corePath);
   virtual SbModule ^ AddModule(System::String ^ path, System::String ^ triple,
     System::String ^ uuid);
   virtual bool RemoveModule(SbModule ^ module);
   virtual SbError ^
       SetModuleLoadAddress(SbModule ^ module, int64_t sectionsOffset);
+  virtual SbError ^
+      AddSymbolFile(SbModule ^ module, System::String ^ symbolFilePath);
   virtual SbProcess ^ GetProcess();
   virtual SbBroadcaster ^ LLDBTarget::GetBroadcaster();
 
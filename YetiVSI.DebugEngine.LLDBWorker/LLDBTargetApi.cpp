@@ -14,7 +14,11 @@
 
 #include "LLDBTargetApi.h"
 
+#include <msclr/marshal_cppstd.h>
+
 #include "LLDBEvent.h"
+#include "SourceLineIndex.h"
+#include "SymbolSearchIndex.h"
 #include "lldb/API/SbTarget.h"
 
 namespace YetiVSI {
@@ -26,5 +30,15 @@ bool LLDBTargetApi::EventIsTargetEvent(SbEvent ^ sbEvent) {
   return lldb::SBTarget::EventIsTargetEvent(native_event);
 }
 
+void LLDBTargetApi::SetSourceLineIndexCacheDirectory(System::String ^ path) {
+  YetiVSI::DebugEngine::SetSourceLineIndexCacheDirectory(
+      msclr::interop::marshal_as<std::string>(path));
+}
+
+void LLDBTargetApi::SetSymbolSearchIndexCacheDirectory(System::String ^ path) {
+  YetiVSI::DebugEngine::SetSymbolSearchIndexCacheDirectory(
+      msclr::interop::marshal_as<std::string>(path));
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
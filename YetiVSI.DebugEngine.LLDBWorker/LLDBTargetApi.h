@@ -27,6 +27,12 @@ ref class LLDBTargetApi sealed {
   LLDBTargetApi() {}
   virtual ~LLDBTargetApi() {}
   bool EventIsTargetEvent(SbEvent ^ sbEvent);
+  // Sets the directory the source line indexes used to create file:line
+  // breakpoints are persisted in.
+  void SetSourceLineIndexCacheDirectory(System::String ^ path);
+  // Sets the directory the symbol indexes used to search functions by pattern
+  // are persisted in.
+  void SetSymbolSearchIndexCacheDirectory(System::String ^ path);
 };
 
 }  // namespace DebugEngine
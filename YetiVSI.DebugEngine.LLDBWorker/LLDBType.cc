@@ -18,6 +18,7 @@
 
 #include "LLDBTypeList.h"
 #include "LLDBTypeMember.h"
+#include "FlatTypeLayout.h"
 
 #include "lldb/API/SBType.h"
 
@@ -76,6 +77,42 @@ uint64_t LLDBType::GetByteSize() {
   return type_->GetByteSize();
 }
 
+TypeLayout ^ LLDBType::GetLayout() {
+  std::shared_ptr<const FlatTypeLayout> layout = GetTypeLayout(*(*type_));
+  if (!layout) {
+    return nullptr;
+  }
+  auto result = gcnew TypeLayout();
+  result->ByteSize = layout->GetByteSize();
+  result->HasVirtualBases = layout->HasVirtualBases();
+  const auto& names = layout->GetNames();
+  result->Names = gcnew System::Collections::Generic::List<System::String ^>(
+      static_cast<int>(names.size()));
+  for (const std::string& name : names) {
+    result->Names->Add(gcnew System::String(name.c_str()));
+  }
+  const auto& type_names = layout->GetTypeNames();
+  result->TypeNames =
+      gcnew System::Collections::Generic::List<System::String ^>(
+          static_cast<int>(type_names.size()));
+  for (const std::string& name : type_names) {
+    result->TypeNames->Add(gcnew System::String(name.c_str()));
+  }
+  result->Fields = gcnew System::Collections::Generic::List<TypeLayoutField>(
+      static_cast<int>(layout->GetFields().size()));
+  for (const FlatTypeLayoutField& field : layout->GetFields()) {
+    TypeLayoutField managed_field;
+    managed_field.NameId = field.name_id;
+    managed_field.TypeId = field.type_id;
+    managed_field.Offset = field.offset;
+    managed_field.Size = field.size;
+    managed_field.BitfieldBitOffset = field.bitfield_bit_offset;
+    managed_field.BitfieldBitSize = field.bitfield_bit_size;
+    result->Fields->Add(managed_field);
+  }
+  return result;
+}
+
 lldb::SBType LLDBType::GetNativeObject() { return *(*type_).Get(); }
 
 }  // namespace DebugEngine
@@ -39,6 +39,7 @@ ref class LLDBType sealed : SbType {
   virtual SbType ^ GetPointeeType();
   virtual SbTypeList ^ GetFunctionArgumentTypes();
   virtual uint64_t GetByteSize();
+  virtual TypeLayout ^ GetLayout();
 
   lldb::SBType GetNativeObject();
 
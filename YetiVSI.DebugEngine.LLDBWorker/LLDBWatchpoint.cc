@@ -41,5 +41,13 @@ void LLDBWatchpoint::SetCondition(System::String ^ condition) {
 void LLDBWatchpoint::SetIgnoreCount(unsigned int ignoreCount) {
   watchpoint_->SetIgnoreCount(ignoreCount);
 }
+
+WatchpointStats LLDBWatchpoint::GetStats() {
+  // Hardware watchpoints don't fault, only hits are counted.
+  WatchpointStats stats;
+  stats.HitCount = watchpoint_->GetHitCount();
+  return stats;
+}
+
 }  // namespace DebugEngine
 }  // namespace YetiVSI
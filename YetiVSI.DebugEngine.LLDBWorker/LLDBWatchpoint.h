@@ -36,6 +36,7 @@ ref class LLDBWatchpoint sealed : SbWatchpoint {
   virtual void SetEnabled(bool enabled);
   virtual void SetCondition(System::String ^ condition);
   virtual void SetIgnoreCount(unsigned int ignoreCount);
+  virtual WatchpointStats GetStats();
 
  private:
   ManagedUniquePtr<lldb::SBWatchpoint> ^ watchpoint_;
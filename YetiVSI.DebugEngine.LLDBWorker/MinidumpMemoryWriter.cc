@@ -0,0 +1,234 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "MinidumpMemoryWriter.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "ParallelUtil.h"
+#include "lldb/API/SBMemoryRegionInfo.h"
+#include "lldb/API/SBMemoryRegionInfoList.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+namespace {
+
+constexpr uint32_t kMinidumpSignature = 0x504d444d;  // "MDMP"
+constexpr uint32_t kMemory64ListStreamType = 9;
+
+// Memory is read in chunks of |kChunkSize| bytes. This bounds the memory used
+// by the writer to two chunks, one being read and one being written.
+constexpr uint64_t kChunkSize = 1024 * 1024;
+
+#pragma pack(push, 1)
+struct MinidumpHeader {
+  uint32_t signature;
+  uint32_t version;
+  uint32_t number_of_streams;
+  uint32_t stream_directory_rva;
+  uint32_t checksum;
+  uint32_t time_date_stamp;
+  uint64_t flags;
+};
+
+struct MinidumpDirectory {
+  uint32_t stream_type;
+  uint32_t data_size;
+  uint32_t rva;
+};
+
+struct Memory64ListHeader {
+  uint64_t number_of_memory_ranges;
+  uint64_t base_rva;
+};
+
+struct MemoryDescriptor64 {
+  uint64_t start_of_memory_range;
+  uint64_t data_size;
+};
+#pragma pack(pop)
+
+template <typename T>
+bool Read(std::fstream& file, T* data, size_t count = 1) {
+  return static_cast<bool>(
+      file.read(reinterpret_cast<char*>(data), sizeof(T) * count));
+}
+
+template <typename T>
+bool Write(std::fstream& file, const T* data, size_t count = 1) {
+  return static_cast<bool>(
+      file.write(reinterpret_cast<const char*>(data), sizeof(T) * count));
+}
+
+uint64_t AlignTo8(uint64_t value) { return (value + 7) & ~uint64_t(7); }
+
+}  // namespace
+
+std::vector<AddressRange> CollectCoreRanges(lldb::SBProcess process,
+                                            bool writable_only) {
+  std::vector<AddressRange> ranges;
+  lldb::SBMemoryRegionInfoList regions = process.GetMemoryRegions();
+  for (uint32_t i = 0; i < regions.GetSize(); ++i) {
+    lldb::SBMemoryRegionInfo region;
+    if (!regions.GetMemoryRegionAtIndex(i, region) || !region.IsMapped() ||
+        !region.IsReadable()) {
+      continue;
+    }
+    if (writable_only) {
+      if (!region.IsWritable()) {
+        continue;
+      }
+      // lldb-server doesn't report dirty pages on Linux, in which case the
+      // whole writable region is saved.
+      uint32_t num_dirty_pages = region.GetNumDirtyPages();
+      if (num_dirty_pages > 0) {
+        uint64_t page_size = region.GetPageSize();
+        for (uint32_t j = 0; j < num_dirty_pages; ++j) {
+          ranges.push_back({region.GetDirtyPageAddressAtIndex(j), page_size});
+        }
+        continue;
+      }
+    }
+    ranges.push_back(
+        {region.GetRegionBase(), region.GetRegionEnd() - region.GetRegionBase()});
+  }
+  return ranges;
+}
+
+lldb::SBError AppendMemoryToMinidump(lldb::SBProcess process,
+                                     const std::string& path,
+                                     const std::vector<AddressRange>& ranges) {
+  lldb::SBError error;
+  std::fstream file(path,
+                    std::ios::in | std::ios::out | std::ios::binary);
+  if (!file) {
+    error.SetErrorStringWithFormat("Unable to open %s", path.c_str());
+    return error;
+  }
+
+  MinidumpHeader header;
+  if (!Read(file, &header) || header.signature != kMinidumpSignature) {
+    error.SetErrorStringWithFormat("%s is not a minidump", path.c_str());
+    return error;
+  }
+  std::vector<MinidumpDirectory> directory(header.number_of_streams);
+  file.seekg(header.stream_directory_rva);
+  if (!Read(file, directory.data(), directory.size())) {
+    error.SetErrorString("Unable to read the minidump stream directory");
+    return error;
+  }
+  for (const MinidumpDirectory& entry : directory) {
+    if (entry.stream_type == kMemory64ListStreamType) {
+      error.SetErrorString("The minidump already contains a memory list");
+      return error;
+    }
+  }
+
+  std::vector<AddressRange> chunks;
+  for (const AddressRange& range : CoalesceRanges(ranges)) {
+    for (uint64_t offset = 0; offset < range.size; offset += kChunkSize) {
+      chunks.push_back(
+          {range.base + offset, std::min(kChunkSize, range.size - offset)});
+    }
+  }
+  if (chunks.empty()) {
+    return error;
+  }
+
+  // The appended data consists of the Memory64List stream, with room for one
+  // descriptor per chunk, followed by the new stream directory and the memory
+  // itself. The stream and the directory are referenced by 32-bit RVAs, the
+  // memory by a 64-bit one, so only the memory may go beyond 4 GiB.
+  file.seekp(0, std::ios::end);
+  uint64_t stream_rva = AlignTo8(static_cast<uint64_t>(file.tellp()));
+  uint64_t directory_rva = stream_rva + sizeof(Memory64ListHeader) +
+                           chunks.size() * sizeof(MemoryDescriptor64);
+  uint64_t base_rva =
+      directory_rva + (directory.size() + 1) * sizeof(MinidumpDirectory);
+  if (base_rva > UINT32_MAX) {
+    error.SetErrorString("Too many memory ranges for a minidump");
+    return error;
+  }
+
+  file.seekp(base_rva);
+  std::vector<MemoryDescriptor64> descriptors;
+  // Chunks are read one at a time. SBProcess::ReadMemory holds the target's
+  // API mutex and the gdb-remote connection carries one read at a time, so
+  // concurrent reads wouldn't overlap. Instead, writing a chunk to the file
+  // overlaps with reading the next one.
+  std::vector<uint8_t> buffers[2] = {std::vector<uint8_t>(kChunkSize),
+                                     std::vector<uint8_t>(kChunkSize)};
+  size_t pending_size = 0;
+  for (size_t i = 0; i <= chunks.size(); ++i) {
+    std::vector<uint8_t>& read_buffer = buffers[i % 2];
+    const std::vector<uint8_t>& write_buffer = buffers[(i + 1) % 2];
+    size_t bytes_read = 0;
+    bool write_failed = false;
+    ParallelFor(2, [&](int32_t task) {
+      if (task == 0 && i < chunks.size()) {
+        lldb::SBError read_error;
+        bytes_read = process.ReadMemory(chunks[i].base, read_buffer.data(),
+                                        chunks[i].size, read_error);
+      } else if (task == 1 && pending_size > 0) {
+        write_failed = !Write(file, write_buffer.data(), pending_size);
+      }
+    });
+    if (write_failed) {
+      error.SetErrorStringWithFormat("Unable to write to %s", path.c_str());
+      return error;
+    }
+
+    pending_size = bytes_read;
+    if (bytes_read == 0) {
+      continue;
+    }
+    // Memory is stored contiguously, so a chunk that directly follows the
+    // previous one in the address space extends its descriptor.
+    if (!descriptors.empty() &&
+        descriptors.back().start_of_memory_range +
+                descriptors.back().data_size ==
+            chunks[i].base) {
+      descriptors.back().data_size += bytes_read;
+    } else {
+      descriptors.push_back({chunks[i].base, bytes_read});
+    }
+  }
+
+  Memory64ListHeader list_header = {descriptors.size(), base_rva};
+  directory.push_back(
+      {kMemory64ListStreamType,
+       static_cast<uint32_t>(sizeof(Memory64ListHeader) +
+                             descriptors.size() * sizeof(MemoryDescriptor64)),
+       static_cast<uint32_t>(stream_rva)});
+  header.number_of_streams = static_cast<uint32_t>(directory.size());
+  header.stream_directory_rva = static_cast<uint32_t>(directory_rva);
+
+  file.seekp(stream_rva);
+  bool success = Write(file, &list_header) &&
+                 Write(file, descriptors.data(), descriptors.size());
+  file.seekp(directory_rva);
+  success = success && Write(file, directory.data(), directory.size());
+  file.seekp(0);
+  success = success && Write(file, &header);
+  if (!success) {
+    error.SetErrorStringWithFormat("Unable to write to %s", path.c_str());
+  }
+  return error;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "AddressRangeUtil.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBProcess.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Returns the readable regions of |process| that should be saved for a dump of
+// the given kind. With |writable_only| set, only writable regions are returned
+// and regions that report dirty pages are reduced to those pages.
+std::vector<AddressRange> CollectCoreRanges(lldb::SBProcess process,
+                                            bool writable_only);
+
+// Extends the minidump at |path| with a Memory64List stream that holds the
+// contents of |ranges|. The minidump must have been written by LLDB, i.e. it
+// must not already contain a Memory64List stream.
+//
+// Memory is read in fixed-size chunks that are streamed to the file in order,
+// so the amount of memory buffered at any time is bounded by the chunk size
+// rather than by the size of the dump. Reads are serial, but each chunk is
+// written while the next one is read. Chunks that cannot be read are left out
+// of the dump.
+lldb::SBError AppendMemoryToMinidump(lldb::SBProcess process,
+                                     const std::string& path,
+                                     const std::vector<AddressRange>& ranges);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
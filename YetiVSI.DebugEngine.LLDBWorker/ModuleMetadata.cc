@@ -0,0 +1,169 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "ModuleMetadata.h"
+
+#include <msclr/lock.h>
+
+#include <map>
+#include <utility>
+
+#include "lldb/API/SBFileSpec.h"
+
+#include "LLDBObject.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the metadata cache, which is used from concurrent RPC threads.
+// <mutex> is not available when compiling with /clr.
+private
+ref class ModuleMetadataLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// The cache is dropped as a whole when it grows past this many modules.
+constexpr size_t kMaxCachedModules = 4096;
+
+void Log(System::String ^ message) {
+  System::String ^ tagged_message =
+      System::String::Format("ModuleMetadata: {0}", message);
+  System::Diagnostics::Debug::WriteLine(tagged_message);
+}
+
+// Metadata by native module address. The module is kept alive by the entry,
+// so its address can't be reused by another module. Entries of unloaded
+// modules are dropped by ForgetModuleMetadata.
+std::map<int64_t, std::pair<lldb::SBModule, ModuleMetadata>> g_metadata;
+
+std::string ToString(const char* str) { return str ? str : ""; }
+
+// Joins the directory and file name like the Modules window does, with a
+// backslash for Windows directories, e.g. of a local core dump's modules.
+std::string GetPath(lldb::SBFileSpec file_spec) {
+  if (!file_spec.IsValid()) {
+    return "";
+  }
+  std::string directory = ToString(file_spec.GetDirectory());
+  std::string file_name = ToString(file_spec.GetFilename());
+  if (directory.empty()) {
+    return file_name;
+  }
+  char separator = directory.find('\\') != std::string::npos ? '\\' : '/';
+  return directory + separator + file_name;
+}
+
+bool FindFirstCodeSection(lldb::SBSection section, lldb::SBSection* out) {
+  if (section.GetSectionType() == lldb::eSectionTypeCode) {
+    *out = section;
+    return true;
+  }
+  size_t num_sub_sections = section.GetNumSubSections();
+  for (size_t i = 0; i < num_sub_sections; i++) {
+    if (FindFirstCodeSection(section.GetSubSectionAtIndex(i), out)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ModuleMetadata ComputeMetadata(lldb::SBModule module) {
+  ModuleMetadata metadata;
+  // The architecture is the first item in the triple.
+  std::string triple = ToString(module.GetTriple());
+  metadata.architecture = triple.substr(0, triple.find('-'));
+  if (metadata.architecture.empty()) {
+    Log("Could not determine architecture of " +
+        gcnew System::String(module.GetPlatformFileSpec().GetFilename()));
+  }
+
+  // Find the code section (name should be .text, __TEXT, etc)
+  size_t num_sections = module.GetNumSections();
+  for (size_t i = 0; i < num_sections; ++i) {
+    if (FindFirstCodeSection(module.GetSectionAtIndex(i),
+                             &metadata.code_section)) {
+      break;
+    }
+  }
+  if (!metadata.code_section.IsValid()) {
+    Log("Module " +
+        gcnew System::String(module.GetPlatformFileSpec().GetFilename()) +
+        " does not have a code section");
+  }
+  return metadata;
+}
+
+}  // namespace
+
+ModuleMetadata GetModuleMetadata(lldb::SBModule module) {
+  int64_t key = GetSPAddress<lldb::SBModule>(module);
+  {
+    msclr::lock lock(ModuleMetadataLock::instance);
+    auto it = g_metadata.find(key);
+    if (it != g_metadata.end()) {
+      return it->second.second;
+    }
+  }
+
+  ModuleMetadata metadata = ComputeMetadata(module);
+  msclr::lock lock(ModuleMetadataLock::instance);
+  if (g_metadata.size() >= kMaxCachedModules) {
+    g_metadata.clear();
+  }
+  g_metadata.emplace(key, std::make_pair(module, metadata));
+  return metadata;
+}
+
+void ForgetModuleMetadata(const std::vector<lldb::SBModule>& modules) {
+  msclr::lock lock(ModuleMetadataLock::instance);
+  for (lldb::SBModule module : modules) {
+    g_metadata.erase(GetSPAddress<lldb::SBModule>(module));
+  }
+}
+
+std::vector<ModuleInfo> GetModuleInfos(lldb::SBTarget target) {
+  std::vector<ModuleInfo> infos;
+  uint32_t num_modules = target.GetNumModules();
+  infos.reserve(num_modules);
+  for (uint32_t i = 0; i < num_modules; ++i) {
+    lldb::SBModule module = target.GetModuleAtIndex(i);
+    ModuleInfo info;
+    if (module.IsValid()) {
+      ModuleMetadata metadata = GetModuleMetadata(module);
+      info.module = module;
+      info.platform_path = GetPath(module.GetPlatformFileSpec());
+      info.symbol_path = GetPath(module.GetSymbolFileSpec());
+      info.uuid = ToString(module.GetUUIDString());
+      info.triple = ToString(module.GetTriple());
+      if (metadata.code_section.IsValid()) {
+        info.code_load_address =
+            metadata.code_section.GetLoadAddress(target);
+        info.code_size = metadata.code_section.GetByteSize();
+      }
+      info.has_symbols = module.GetNumSymbols() != 0;
+      info.has_compile_units = module.GetNumCompileUnits() != 0;
+    }
+    infos.push_back(std::move(info));
+  }
+  return infos;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBSection.h"
+#include "lldb/API/SBTarget.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+struct ModuleMetadata {
+  // First component of the triple, e.g. "x86_64". Empty if unknown.
+  std::string architecture;
+  // First code section (.text, __TEXT, etc). Invalid if there is none.
+  lldb::SBSection code_section;
+};
+
+// Everything the Modules window shows about a module.
+struct ModuleInfo {
+  lldb::SBModule module;
+  std::string platform_path;
+  std::string symbol_path;
+  std::string uuid;
+  std::string triple;
+  uint64_t code_load_address = 0;
+  uint64_t code_size = 0;
+  bool has_symbols = false;
+  bool has_compile_units = false;
+};
+
+// Returns the metadata of |module|. It is computed once per native module, so
+// wrappers of the same module share it.
+ModuleMetadata GetModuleMetadata(lldb::SBModule module);
+
+// Drops the metadata of |modules|, which were unloaded. The cache keeps a
+// module alive, so entries must not outlive the target's use of it.
+void ForgetModuleMetadata(const std::vector<lldb::SBModule>& modules);
+
+// Returns the info of every module of |target|, in module index order.
+std::vector<ModuleInfo> GetModuleInfos(lldb::SBTarget target);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,790 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma managed(on)
+
+#include "PageWatchpoint.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBExpressionOptions.h"
+#include "lldb/API/SBFrame.h"
+#include "lldb/API/SBInstruction.h"
+#include "lldb/API/SBInstructionList.h"
+#include "lldb/API/SBMemoryRegionInfo.h"
+#include "lldb/API/SBSymbol.h"
+#include "lldb/API/SBSymbolContext.h"
+#include "lldb/API/SBSymbolContextList.h"
+#include "lldb/API/SBThread.h"
+#include "lldb/API/SBUnixSignals.h"
+#include "lldb/API/SBValue.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the page watchpoint registry. Watchpoints are changed from RPC
+// threads, and <mutex> is not available when compiling with /clr.
+private
+ref class PageWatchpointLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+// x86-64 Linux values, the inferior always runs on x86-64 Linux.
+constexpr uint64_t kPageSize = 4096;
+constexpr uint32_t kProtRead = 1;
+constexpr uint32_t kProtWrite = 2;
+constexpr uint32_t kProtExec = 4;
+constexpr uint64_t kSysMprotect = 10;
+// Registers that calling mprotect() with a `syscall` instruction changes.
+constexpr const char* kSyscallRegisters[] = {"rip", "rax", "rdi", "rsi",
+                                             "rdx", "rcx", "r11"};
+constexpr size_t kNumSyscallRegisters =
+    sizeof(kSyscallRegisters) / sizeof(kSyscallRegisters[0]);
+
+struct PageWatchpoint {
+  lldb::SBTarget target;
+  uint32_t process_id;
+  uint64_t address;
+  uint64_t size;
+  bool read;
+  bool write;
+  bool enabled = true;
+  std::string condition;
+  uint32_t ignore_count = 0;
+  PageWatchpointStats stats;
+
+  uint64_t FirstPage() const { return address & ~(kPageSize - 1); }
+  uint64_t EndPage() const {
+    return (address + size + kPageSize - 1) & ~(kPageSize - 1);
+  }
+};
+
+// Adjacent pages that get the same protection with a single mprotect().
+struct ProtectionRun {
+  uint64_t address;
+  uint64_t size;
+  uint32_t protection;
+};
+
+// A single step of one thread while the faults of a stop are handled. The
+// other threads stay stopped. The step resumes the process, and the stop that
+// ends it is passed to HandlePageWatchpointStop like any other stop.
+struct FaultStep {
+  enum class Kind {
+    // Steps the `syscall` instruction to call mprotect() for |run|.
+    kMprotect,
+    // Completes the faulting instruction with the original protection.
+    // |watchpoint_id| is the watchpoint whose range was accessed, or 0.
+    kFault,
+    // Protects the pages again. Replaced by kMprotect steps when reached.
+    kProtect,
+  };
+
+  Kind kind;
+  uint64_t thread_id;
+  ProtectionRun run;
+  int32_t watchpoint_id;
+};
+
+// State of the faults of one stop, while their steps are in progress.
+struct FaultHandling {
+  // The first step is in progress.
+  std::deque<FaultStep> steps;
+  // Values of kSyscallRegisters before the mprotect() in progress.
+  uint64_t saved_registers[kNumSyscallRegisters] = {};
+  std::chrono::steady_clock::time_point start;
+  bool suppressed_sigsegv = false;
+  std::vector<int32_t> faulted_ids;
+  uint64_t hit_thread_id = LLDB_INVALID_THREAD_ID;
+  int32_t hit_id = 0;
+  // A thread that stopped for a different reason, which is reported once the
+  // faults are handled.
+  uint64_t other_stop_thread_id = LLDB_INVALID_THREAD_ID;
+};
+
+struct ProcessPages {
+  // Protection of every watched page before it was first watched, and the
+  // protection it currently has in the inferior.
+  std::map<uint64_t, uint32_t> original;
+  std::map<uint64_t, uint32_t> current;
+
+  // Address of a `syscall` instruction in the inferior, used to call
+  // mprotect() on faults. Zero until it is looked up, LLDB_INVALID_ADDRESS if
+  // there is none.
+  uint64_t syscall_address = 0;
+
+  // Set while faults are being handled.
+  std::unique_ptr<FaultHandling> handling;
+};
+
+// A thread that stopped because it accessed a protected page.
+struct Fault {
+  lldb::SBThread thread;
+  uint64_t address;
+};
+
+int32_t g_next_id = kPageWatchpointIdBase;
+std::map<int32_t, PageWatchpoint> g_watchpoints;
+// By process unique ID.
+std::map<uint32_t, ProcessPages> g_processes;
+
+// Calls mprotect() in the inferior with an expression. The expression only runs
+// the selected thread so no other thread can touch the pages while they change.
+// Used outside of faults, where JIT-compiling the call doesn't matter, and on
+// faults if libc's mprotect() has no `syscall` instruction.
+bool MprotectWithExpression(lldb::SBProcess process, uint64_t address,
+                            uint64_t size, uint32_t protection) {
+  char expression[128];
+  snprintf(expression, sizeof(expression),
+           "(int)mprotect((void *)0x%llx, 0x%llx, %u)", address, size,
+           protection);
+  lldb::SBExpressionOptions options;
+  options.SetIgnoreBreakpoints(true);
+  options.SetUnwindOnError(true);
+  options.SetTryAllThreads(false);
+  options.SetLanguage(lldb::eLanguageTypeC);
+  lldb::SBValue result =
+      process.GetTarget().EvaluateExpression(expression, options);
+  return result.GetError().Success() && result.GetValueAsSigned(-1) == 0;
+}
+
+// Starts stepping one instruction of |thread| while the other threads stay
+// stopped. The debugger is asynchronous, so this returns once the process is
+// running. The stop that ends the step is handled by ContinueFaultHandling.
+bool StartStep(lldb::SBThread thread) {
+  lldb::SBError error;
+  thread.StepInstruction(false, error);
+  return error.Success();
+}
+
+// Returns true if |thread| stopped because its step completed, rather than
+// e.g. because of a signal.
+bool StepCompleted(lldb::SBThread thread) {
+  lldb::StopReason reason = thread.GetStopReason();
+  return reason == lldb::eStopReasonPlanComplete ||
+         reason == lldb::eStopReasonTrace;
+}
+
+// Looks for a `syscall` instruction in the code of libc's mprotect(). The code
+// is disassembled, so that bytes inside of other instructions don't match.
+uint64_t FindSyscallInstruction(lldb::SBProcess process) {
+  constexpr uint32_t kMaxInstructions = 32;
+  lldb::SBTarget target = process.GetTarget();
+  lldb::SBSymbolContextList contexts =
+      target.FindFunctions("mprotect", lldb::eFunctionNameTypeFull);
+  for (uint32_t i = 0; i < contexts.GetSize(); ++i) {
+    lldb::SBSymbol symbol = contexts.GetContextAtIndex(i).GetSymbol();
+    uint64_t end = symbol.GetEndAddress().GetLoadAddress(target);
+    lldb::SBInstructionList instructions =
+        target.ReadInstructions(symbol.GetStartAddress(), kMaxInstructions);
+    for (size_t j = 0; j < instructions.GetSize(); ++j) {
+      lldb::SBInstruction instruction = instructions.GetInstructionAtIndex(j);
+      uint64_t address = instruction.GetAddress().GetLoadAddress(target);
+      if (address == LLDB_INVALID_ADDRESS || address >= end) {
+        break;
+      }
+      const char* mnemonic = instruction.GetMnemonic(target);
+      if (mnemonic != nullptr && strcmp(mnemonic, "syscall") == 0) {
+        return address;
+      }
+    }
+  }
+  return LLDB_INVALID_ADDRESS;
+}
+
+bool WriteRegister(lldb::SBThread thread, const char* name, uint64_t value) {
+  char text[32];
+  snprintf(text, sizeof(text), "0x%llx", value);
+  lldb::SBError error;
+  return thread.GetFrameAtIndex(0).FindRegister(name).SetValueFromCString(
+             text, error) &&
+         error.Success();
+}
+
+bool RestoreSyscallRegisters(lldb::SBThread thread, const uint64_t* saved) {
+  bool success = true;
+  for (size_t i = 0; i < kNumSyscallRegisters; ++i) {
+    success &= WriteRegister(thread, kSyscallRegisters[i], saved[i]);
+  }
+  return success;
+}
+
+// Starts calling mprotect() on |thread|, which is stopped at a fault, by
+// stepping a `syscall` instruction with the arguments in registers. Unlike an
+// expression, this doesn't JIT-compile anything. The registers the call
+// changes are saved to |saved| and restored by FinishMprotectSyscall.
+bool StartMprotectSyscall(lldb::SBThread thread, uint64_t syscall_address,
+                          const ProtectionRun& run, uint64_t* saved) {
+  for (size_t i = 0; i < kNumSyscallRegisters; ++i) {
+    lldb::SBError error;
+    saved[i] = thread.GetFrameAtIndex(0)
+                   .FindRegister(kSyscallRegisters[i])
+                   .GetValueAsUnsigned(error, 0);
+    if (error.Fail()) {
+      return false;
+    }
+  }
+  if (WriteRegister(thread, "rax", kSysMprotect) &&
+      WriteRegister(thread, "rdi", run.address) &&
+      WriteRegister(thread, "rsi", run.size) &&
+      WriteRegister(thread, "rdx", run.protection) &&
+      WriteRegister(thread, "rip", syscall_address) && StartStep(thread)) {
+    return true;
+  }
+  RestoreSyscallRegisters(thread, saved);
+  return false;
+}
+
+// Reads the result of the mprotect() call and restores the registers of
+// |thread|. Returns true if the call succeeded.
+bool FinishMprotectSyscall(lldb::SBThread thread, const uint64_t* saved) {
+  bool success =
+      StepCompleted(thread) &&
+      thread.GetFrameAtIndex(0).FindRegister("rax").GetValueAsSigned(-1) == 0;
+  return RestoreSyscallRegisters(thread, saved) && success;
+}
+
+uint32_t GetOriginalProtection(lldb::SBProcess process, uint64_t page) {
+  lldb::SBMemoryRegionInfo region;
+  if (process.GetMemoryRegionInfo(page, region).Fail()) {
+    return kProtRead | kProtWrite;
+  }
+  return (region.IsReadable() ? kProtRead : 0) |
+         (region.IsWritable() ? kProtWrite : 0) |
+         (region.IsExecutable() ? kProtExec : 0);
+}
+
+// The protection |page| needs for the enabled watchpoints of |process_id|.
+uint32_t GetWatchedProtection(uint32_t process_id, uint64_t page,
+                              uint32_t original) {
+  uint32_t protection = original;
+  for (const auto& entry : g_watchpoints) {
+    const PageWatchpoint& watchpoint = entry.second;
+    if (watchpoint.process_id != process_id || !watchpoint.enabled ||
+        page < watchpoint.FirstPage() || page >= watchpoint.EndPage()) {
+      continue;
+    }
+    if (watchpoint.read) {
+      return 0;
+    }
+    if (watchpoint.write) {
+      protection &= ~kProtWrite;
+    }
+  }
+  return protection;
+}
+
+// Returns the pages of |pages| whose protection differs from the one
+// |get_protection| returns for them. Runs of adjacent pages with the same
+// protection are merged, so they take a single mprotect().
+template <typename GetProtection>
+std::vector<ProtectionRun> GetProtectionChanges(const ProcessPages& pages,
+                                                GetProtection get_protection) {
+  std::vector<ProtectionRun> runs;
+  for (const auto& entry : pages.original) {
+    uint64_t page = entry.first;
+    uint32_t protection = get_protection(page, entry.second);
+    if (pages.current.at(page) == protection) {
+      continue;
+    }
+    if (!runs.empty() && runs.back().address + runs.back().size == page &&
+        runs.back().protection == protection) {
+      runs.back().size += kPageSize;
+    } else {
+      runs.push_back({page, kPageSize, protection});
+    }
+  }
+  return runs;
+}
+
+std::vector<ProtectionRun> GetWatchedProtectionChanges(
+    uint32_t process_id, const ProcessPages& pages) {
+  return GetProtectionChanges(
+      pages, [process_id](uint64_t page, uint32_t original) {
+        return GetWatchedProtection(process_id, page, original);
+      });
+}
+
+std::vector<ProtectionRun> GetOriginalProtectionChanges(
+    const ProcessPages& pages) {
+  return GetProtectionChanges(
+      pages, [](uint64_t, uint32_t original) { return original; });
+}
+
+void SetCurrentProtection(ProcessPages* pages, const ProtectionRun& run) {
+  for (uint64_t page = run.address; page < run.address + run.size;
+       page += kPageSize) {
+    pages->current[page] = run.protection;
+  }
+}
+
+// Applies |runs| with expressions. Used while the process is stopped, outside
+// of faults.
+bool ApplyProtection(lldb::SBProcess process, ProcessPages* pages,
+                     const std::vector<ProtectionRun>& runs) {
+  bool success = true;
+  for (const ProtectionRun& run : runs) {
+    if (MprotectWithExpression(process, run.address, run.size,
+                               run.protection)) {
+      SetCurrentProtection(pages, run);
+    } else {
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool ProtectPages(lldb::SBProcess process, ProcessPages* pages) {
+  return ApplyProtection(
+      process, pages,
+      GetWatchedProtectionChanges(process.GetUniqueID(), *pages));
+}
+
+bool UnprotectPages(lldb::SBProcess process, ProcessPages* pages) {
+  return ApplyProtection(process, pages, GetOriginalProtectionChanges(*pages));
+}
+
+// Reads the fault address of a SIGSEGV from the siginfo of |thread|.
+bool GetFaultAddress(lldb::SBThread thread, uint64_t* address) {
+  lldb::SBValue si_addr = thread.GetSiginfo().GetValueForExpressionPath(
+      "._sifields._sigfault.si_addr");
+  lldb::SBError error;
+  *address = si_addr.GetValueAsUnsigned(error, 0);
+  return si_addr.IsValid() && error.Success();
+}
+
+// Returns true if |page| is watched and currently protected.
+bool IsProtectedPage(const ProcessPages& pages, uint64_t page) {
+  auto current = pages.current.find(page);
+  return current != pages.current.end() &&
+         current->second != pages.original.at(page);
+}
+
+// Returns true if [first_page, end_page) overlaps the stack of a thread of
+// |process|. Protecting a stack would make the thread fault on its own pushes,
+// and the kernel couldn't deliver the SIGSEGV.
+bool OverlapsThreadStack(lldb::SBProcess process, uint64_t first_page,
+                         uint64_t end_page) {
+  for (uint32_t i = 0; i < process.GetNumThreads(); ++i) {
+    uint64_t sp = process.GetThreadAtIndex(i).GetFrameAtIndex(0).GetSP();
+    lldb::SBMemoryRegionInfo region;
+    if (sp != LLDB_INVALID_ADDRESS &&
+        process.GetMemoryRegionInfo(sp, region).Success() &&
+        region.GetRegionBase() < end_page &&
+        first_page < region.GetRegionEnd()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ShouldReportHit(PageWatchpoint* watchpoint, lldb::SBThread thread) {
+  if (watchpoint->ignore_count > 0) {
+    watchpoint->ignore_count--;
+    return false;
+  }
+  if (watchpoint->condition.empty()) {
+    return true;
+  }
+  lldb::SBValue result =
+      thread.GetFrameAtIndex(0).EvaluateExpression(
+          watchpoint->condition.c_str());
+  // Like LLDB, stop if the condition can't be evaluated.
+  return result.GetError().Fail() || result.GetValueAsUnsigned() != 0;
+}
+
+}  // namespace
+
+bool IsPageWatchpointId(int32_t id) { return id >= kPageWatchpointIdBase; }
+
+lldb::SBError CreatePageWatchpoint(lldb::SBTarget target, uint64_t address,
+                                   uint64_t size, bool read, bool write,
+                                   int32_t* id) {
+  lldb::SBError error;
+  lldb::SBProcess process = target.GetProcess();
+  if (!process.IsValid() || process.GetState() != lldb::eStateStopped) {
+    error.SetErrorString("The process must be stopped to set a watchpoint");
+    return error;
+  }
+  if (size == 0 || address + size < address || (!read && !write)) {
+    error.SetErrorString("Invalid watchpoint range");
+    return error;
+  }
+  uint64_t first_page = address & ~(kPageSize - 1);
+  uint64_t end_page = (address + size + kPageSize - 1) & ~(kPageSize - 1);
+  if (OverlapsThreadStack(process, first_page, end_page)) {
+    error.SetErrorString("Stack memory can't be watched with page protection");
+    return error;
+  }
+
+  msclr::lock lock(PageWatchpointLock::instance);
+  PageWatchpoint watchpoint;
+  watchpoint.target = target;
+  watchpoint.process_id = process.GetUniqueID();
+  watchpoint.address = address;
+  watchpoint.size = size;
+  watchpoint.read = read;
+  watchpoint.write = write;
+
+  ProcessPages& pages = g_processes[watchpoint.process_id];
+  for (uint64_t page = watchpoint.FirstPage(); page < watchpoint.EndPage();
+       page += kPageSize) {
+    if (pages.original.count(page) == 0) {
+      uint32_t protection = GetOriginalProtection(process, page);
+      pages.original[page] = protection;
+      pages.current[page] = protection;
+    }
+  }
+  *id = g_next_id++;
+  g_watchpoints[*id] = watchpoint;
+  if (!ProtectPages(process, &pages)) {
+    g_watchpoints.erase(*id);
+    ProtectPages(process, &pages);
+    error.SetErrorStringWithFormat(
+        "Failed to protect the pages of 0x%llx-0x%llx", address,
+        address + size);
+  }
+  return error;
+}
+
+bool DeletePageWatchpoint(int32_t id) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  auto it = g_watchpoints.find(id);
+  if (it == g_watchpoints.end()) {
+    return false;
+  }
+  lldb::SBProcess process = it->second.target.GetProcess();
+  uint32_t process_id = it->second.process_id;
+  uint64_t first_page = it->second.FirstPage();
+  uint64_t end_page = it->second.EndPage();
+  g_watchpoints.erase(it);
+
+  ProcessPages& pages = g_processes[process_id];
+  if (process.IsValid() && process.GetUniqueID() == process_id) {
+    ProtectPages(process, &pages);
+  }
+  // Forget pages no other watchpoint covers.
+  for (uint64_t page = first_page; page < end_page; page += kPageSize) {
+    bool watched = false;
+    for (const auto& entry : g_watchpoints) {
+      watched |= entry.second.process_id == process_id &&
+                 page >= entry.second.FirstPage() &&
+                 page < entry.second.EndPage();
+    }
+    if (!watched) {
+      pages.original.erase(page);
+      pages.current.erase(page);
+    }
+  }
+  // While faults are handled, the stops that end their steps still need the
+  // entry.
+  if (pages.original.empty() && !pages.handling) {
+    g_processes.erase(process_id);
+  }
+  return true;
+}
+
+bool HasPageWatchpoints(lldb::SBProcess process) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  return g_processes.count(process.GetUniqueID()) > 0;
+}
+
+void RemovePageWatchpoints(lldb::SBProcess process, bool restore_protection) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  uint32_t process_id = process.GetUniqueID();
+  auto process_it = g_processes.find(process_id);
+  if (process_it == g_processes.end()) {
+    return;
+  }
+  if (restore_protection) {
+    UnprotectPages(process, &process_it->second);
+  }
+  if (process_it->second.handling) {
+    lldb::SBUnixSignals signals = process.GetUnixSignals();
+    signals.SetShouldSuppress(signals.GetSignalNumberFromName("SIGSEGV"),
+                              process_it->second.handling->suppressed_sigsegv);
+  }
+  g_processes.erase(process_it);
+  for (auto it = g_watchpoints.begin(); it != g_watchpoints.end();) {
+    if (it->second.process_id == process_id) {
+      it = g_watchpoints.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SetPageWatchpointEnabled(int32_t id, bool enabled) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  auto it = g_watchpoints.find(id);
+  if (it == g_watchpoints.end() || it->second.enabled == enabled) {
+    return;
+  }
+  it->second.enabled = enabled;
+  ProtectPages(it->second.target.GetProcess(),
+               &g_processes[it->second.process_id]);
+}
+
+void SetPageWatchpointCondition(int32_t id, std::string condition) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  auto it = g_watchpoints.find(id);
+  if (it != g_watchpoints.end()) {
+    it->second.condition = std::move(condition);
+  }
+}
+
+void SetPageWatchpointIgnoreCount(int32_t id, uint32_t ignore_count) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  auto it = g_watchpoints.find(id);
+  if (it != g_watchpoints.end()) {
+    it->second.ignore_count = ignore_count;
+  }
+}
+
+bool GetPageWatchpointStats(int32_t id, PageWatchpointStats* stats) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  auto it = g_watchpoints.find(id);
+  if (it == g_watchpoints.end()) {
+    return false;
+  }
+  *stats = it->second.stats;
+  return true;
+}
+
+namespace {
+
+// Reports the result of the faults of a stop once all their steps are done.
+PageWatchpointStop FinishFaultHandling(lldb::SBProcess process,
+                                       ProcessPages* pages, int32_t* id) {
+  std::unique_ptr<FaultHandling> handling = std::move(pages->handling);
+  lldb::SBUnixSignals signals = process.GetUnixSignals();
+  signals.SetShouldSuppress(signals.GetSignalNumberFromName("SIGSEGV"),
+                            handling->suppressed_sigsegv);
+
+  uint64_t elapsed_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - handling->start)
+          .count());
+  std::vector<int32_t>& faulted_ids = handling->faulted_ids;
+  std::sort(faulted_ids.begin(), faulted_ids.end());
+  faulted_ids.erase(std::unique(faulted_ids.begin(), faulted_ids.end()),
+                    faulted_ids.end());
+  for (int32_t faulted_id : faulted_ids) {
+    auto it = g_watchpoints.find(faulted_id);
+    if (it != g_watchpoints.end()) {
+      it->second.stats.total_handling_ns += elapsed_ns;
+    }
+  }
+
+  if (handling->hit_thread_id != LLDB_INVALID_THREAD_ID) {
+    process.SetSelectedThreadByID(handling->hit_thread_id);
+    *id = handling->hit_id;
+    return PageWatchpointStop::kHit;
+  }
+  if (handling->other_stop_thread_id != LLDB_INVALID_THREAD_ID) {
+    process.SetSelectedThreadByID(handling->other_stop_thread_id);
+    return PageWatchpointStop::kNotHandled;
+  }
+  process.Continue();
+  return PageWatchpointStop::kResumed;
+}
+
+// Starts the next step of the faults being handled, or reports their result if
+// there are no steps left.
+PageWatchpointStop RunFaultSteps(lldb::SBProcess process, ProcessPages* pages,
+                                 int32_t* id) {
+  FaultHandling& handling = *pages->handling;
+  while (!handling.steps.empty()) {
+    FaultStep& step = handling.steps.front();
+    if (step.kind == FaultStep::Kind::kProtect) {
+      uint64_t thread_id = step.thread_id;
+      handling.steps.pop_front();
+      std::vector<ProtectionRun> runs =
+          GetWatchedProtectionChanges(process.GetUniqueID(), *pages);
+      for (auto run = runs.rbegin(); run != runs.rend(); ++run) {
+        handling.steps.push_front(
+            {FaultStep::Kind::kMprotect, thread_id, *run, 0});
+      }
+      continue;
+    }
+
+    lldb::SBThread thread = process.GetThreadByID(step.thread_id);
+    bool started = false;
+    if (step.kind == FaultStep::Kind::kMprotect) {
+      if (pages->syscall_address == 0) {
+        pages->syscall_address = FindSyscallInstruction(process);
+      }
+      if (pages->syscall_address == LLDB_INVALID_ADDRESS) {
+        if (MprotectWithExpression(process, step.run.address, step.run.size,
+                                   step.run.protection)) {
+          SetCurrentProtection(pages, step.run);
+        }
+        handling.steps.pop_front();
+        continue;
+      }
+      started = StartMprotectSyscall(thread, pages->syscall_address, step.run,
+                                     handling.saved_registers);
+    } else {
+      started = StartStep(thread);
+    }
+    if (started) {
+      return PageWatchpointStop::kResumed;
+    }
+    if (step.kind == FaultStep::Kind::kFault &&
+        handling.other_stop_thread_id == LLDB_INVALID_THREAD_ID) {
+      handling.other_stop_thread_id = step.thread_id;
+    }
+    handling.steps.pop_front();
+  }
+  return FinishFaultHandling(process, pages, id);
+}
+
+// Handles the stop that ends the step in progress, then starts the next one.
+PageWatchpointStop ContinueFaultHandling(lldb::SBProcess process,
+                                         ProcessPages* pages, int32_t* id) {
+  FaultHandling& handling = *pages->handling;
+  FaultStep step = handling.steps.front();
+  handling.steps.pop_front();
+  lldb::SBThread thread = process.GetThreadByID(step.thread_id);
+  bool completed = StepCompleted(thread);
+  if (step.kind == FaultStep::Kind::kMprotect) {
+    if (FinishMprotectSyscall(thread, handling.saved_registers)) {
+      SetCurrentProtection(pages, step.run);
+    }
+  } else if (completed && step.watchpoint_id != 0 &&
+             handling.hit_thread_id == LLDB_INVALID_THREAD_ID) {
+    // Conditions are evaluated before the pages are protected again, so they
+    // can read the watched range.
+    auto it = g_watchpoints.find(step.watchpoint_id);
+    if (it != g_watchpoints.end() && ShouldReportHit(&it->second, thread)) {
+      handling.hit_thread_id = step.thread_id;
+      handling.hit_id = step.watchpoint_id;
+    }
+  }
+  if (!completed && handling.other_stop_thread_id == LLDB_INVALID_THREAD_ID) {
+    // The step was interrupted, e.g. by a signal. That stop is reported as is.
+    handling.other_stop_thread_id = step.thread_id;
+  }
+  return RunFaultSteps(process, pages, id);
+}
+
+}  // namespace
+
+PageWatchpointStop HandlePageWatchpointStop(lldb::SBProcess process,
+                                            int32_t* id) {
+  msclr::lock lock(PageWatchpointLock::instance);
+  uint32_t process_id = process.GetUniqueID();
+  auto process_it = g_processes.find(process_id);
+  if (process_it == g_processes.end()) {
+    return PageWatchpointStop::kNotHandled;
+  }
+  ProcessPages& pages = process_it->second;
+  if (pages.handling) {
+    PageWatchpointStop result = ContinueFaultHandling(process, &pages, id);
+    // The last watchpoint might have been deleted while the steps ran.
+    if (!pages.handling && pages.original.empty()) {
+      g_processes.erase(process_it);
+    }
+    return result;
+  }
+
+  // Several threads can fault in the same stop, and other threads can stop
+  // for unrelated reasons at the same time.
+  lldb::SBUnixSignals signals = process.GetUnixSignals();
+  int32_t sigsegv = signals.GetSignalNumberFromName("SIGSEGV");
+  std::vector<Fault> faults;
+  lldb::SBThread other_stop;
+  for (uint32_t i = 0; i < process.GetNumThreads(); ++i) {
+    lldb::SBThread thread = process.GetThreadAtIndex(i);
+    lldb::StopReason reason = thread.GetStopReason();
+    uint64_t address;
+    if (reason == lldb::eStopReasonSignal &&
+        thread.GetStopReasonDataAtIndex(0) == static_cast<uint64_t>(sigsegv) &&
+        GetFaultAddress(thread, &address) &&
+        IsProtectedPage(pages, address & ~(kPageSize - 1))) {
+      faults.push_back({thread, address});
+    } else if (reason != lldb::eStopReasonNone &&
+               reason != lldb::eStopReasonInvalid &&
+               (reason != lldb::eStopReasonSignal ||
+                signals.GetShouldStop(static_cast<int32_t>(
+                    thread.GetStopReasonDataAtIndex(0)))) &&
+               !other_stop.IsValid()) {
+      other_stop = thread;
+    }
+  }
+  if (faults.empty()) {
+    return PageWatchpointStop::kNotHandled;
+  }
+
+  // The faulting instructions complete with the original protection, then the
+  // pages are protected again. Every mprotect() and every faulting instruction
+  // is a single step of one thread, while the other threads stay stopped, so
+  // they can't slip through. The SIGSEGVs are not passed to the inferior.
+  pages.handling = std::make_unique<FaultHandling>();
+  FaultHandling& handling = *pages.handling;
+  handling.start = std::chrono::steady_clock::now();
+  handling.suppressed_sigsegv = signals.GetShouldSuppress(sigsegv);
+  signals.SetShouldSuppress(sigsegv, true);
+  if (other_stop.IsValid()) {
+    handling.other_stop_thread_id = other_stop.GetThreadID();
+  }
+
+  uint64_t syscall_thread_id = faults.front().thread.GetThreadID();
+  for (const ProtectionRun& run : GetOriginalProtectionChanges(pages)) {
+    handling.steps.push_back(
+        {FaultStep::Kind::kMprotect, syscall_thread_id, run, 0});
+  }
+  for (const Fault& fault : faults) {
+    uint64_t page = fault.address & ~(kPageSize - 1);
+    int32_t accessed_id = 0;
+    for (auto& entry : g_watchpoints) {
+      PageWatchpoint& watchpoint = entry.second;
+      if (watchpoint.process_id != process_id || !watchpoint.enabled ||
+          page < watchpoint.FirstPage() || page >= watchpoint.EndPage()) {
+        continue;
+      }
+      watchpoint.stats.fault_count++;
+      handling.faulted_ids.push_back(entry.first);
+      if (accessed_id == 0 && fault.address >= watchpoint.address &&
+          fault.address - watchpoint.address < watchpoint.size) {
+        watchpoint.stats.hit_count++;
+        accessed_id = entry.first;
+      } else {
+        watchpoint.stats.filtered_count++;
+      }
+    }
+    handling.steps.push_back({FaultStep::Kind::kFault,
+                              fault.thread.GetThreadID(), {}, accessed_id});
+  }
+  handling.steps.push_back(
+      {FaultStep::Kind::kProtect, syscall_thread_id, {}, 0});
+  return RunFaultSteps(process, &pages, id);
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Software watchpoints for ranges that don't fit in the debug registers. The
+// pages containing the range are mprotect()ed in the inferior. An access to
+// them raises a SIGSEGV, which is filtered against the watched range. The
+// faulting instruction is then single-stepped with the original protection
+// and the pages are protected again. On faults, mprotect() is called by
+// stepping a `syscall` instruction of libc rather than with an expression.
+// Ranges on thread stacks can't be watched.
+//
+// This runs in the LLDB worker. Each of these steps resumes the process like
+// any other step, and the stop that ends it goes through
+// HandlePageWatchpointStop, so the debugger stays asynchronous throughout.
+
+// IDs of page watchpoints start here so they never clash with LLDB's
+// watchpoint IDs.
+constexpr int32_t kPageWatchpointIdBase = 0x40000000;
+
+// Largest aligned range a single x86-64 debug register can watch.
+constexpr uint64_t kMaxHardwareWatchSize = 8;
+
+struct PageWatchpointStats {
+  // Accesses to the watched range.
+  uint32_t hit_count = 0;
+  // SIGSEGVs raised by the protection of the watched pages.
+  uint32_t fault_count = 0;
+  // Faults on the watched pages outside of the watched range.
+  uint32_t filtered_count = 0;
+  // Time between the faults and the pages being protected again, which
+  // includes the single step and the mprotect() calls.
+  uint64_t total_handling_ns = 0;
+};
+
+enum class PageWatchpointStop {
+  // The stop is not caused by a page watchpoint.
+  kNotHandled,
+  // The stop was handled and the process has been resumed.
+  kResumed,
+  // A page watchpoint was hit and the thread that hit it is selected.
+  kHit,
+};
+
+bool IsPageWatchpointId(int32_t id);
+
+// Watches [address, address + size) for reads and/or writes. The process must
+// be stopped.
+lldb::SBError CreatePageWatchpoint(lldb::SBTarget target, uint64_t address,
+                                   uint64_t size, bool read, bool write,
+                                   int32_t* id);
+
+// Deletes the watchpoint and restores the protection of its pages. Returns
+// false if there is no page watchpoint |id|.
+bool DeletePageWatchpoint(int32_t id);
+
+// Returns true if |process| has page watchpoints.
+bool HasPageWatchpoints(lldb::SBProcess process);
+
+// Deletes all page watchpoints of |process|. Before detaching, the original
+// protection of the watched pages must be restored, which needs the process to
+// be stopped. After the process is killed or has exited it must not be.
+void RemovePageWatchpoints(lldb::SBProcess process, bool restore_protection);
+
+void SetPageWatchpointEnabled(int32_t id, bool enabled);
+void SetPageWatchpointCondition(int32_t id, std::string condition);
+void SetPageWatchpointIgnoreCount(int32_t id, uint32_t ignore_count);
+bool GetPageWatchpointStats(int32_t id, PageWatchpointStats* stats);
+
+// Must be called for every stop of |process| while it has page watchpoints,
+// before the stop is reported. Handles the faults of all threads of the stop.
+// Returns kResumed while their steps are in progress, and handles the stops
+// that end them. Once the faults are handled, returns kNotHandled, with the
+// thread selected, if another thread stopped for a different reason at the
+// same time. On kHit, |id| is set to the watchpoint that was hit.
+PageWatchpointStop HandlePageWatchpointStop(lldb::SBProcess process,
+                                            int32_t* id);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,81 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "ParallelUtil.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Adapts a native std::function to the System::Action<int> delegate expected
+// by Parallel::For. The function is owned by the caller of ParallelFor, which
+// outlives the parallel loop.
+private
+ref class ParallelForBody sealed {
+ public:
+  ParallelForBody(const std::function<void(int32_t)>* body) : body_(body) {}
+
+  void Invoke(int32_t index) { (*body_)(index); }
+
+ private:
+  const std::function<void(int32_t)>* body_;
+};
+
+// Owns a native std::function until it has run on the thread pool.
+private
+ref class BackgroundWork sealed {
+ public:
+  BackgroundWork(std::function<void()> work)
+      : work_(new std::function<void()>(std::move(work))) {}
+
+  void Run(System::Object ^) {
+    (*work_)();
+    delete work_;
+    work_ = nullptr;
+  }
+
+ private:
+  std::function<void()>* work_;
+};
+
+void ParallelFor(int32_t count, const std::function<void(int32_t)>& body,
+                 int32_t max_parallelism) {
+  if (count <= 0) {
+    return;
+  }
+  if (count == 1) {
+    body(0);
+    return;
+  }
+  auto options = gcnew System::Threading::Tasks::ParallelOptions();
+  if (max_parallelism > 0) {
+    options->MaxDegreeOfParallelism = max_parallelism;
+  }
+  ParallelForBody ^ functor = gcnew ParallelForBody(&body);
+  System::Threading::Tasks::Parallel::For(
+      0, count, options,
+      gcnew System::Action<int32_t>(functor, &ParallelForBody::Invoke));
+}
+
+void RunInBackground(std::function<void()> work) {
+  BackgroundWork ^ background_work = gcnew BackgroundWork(std::move(work));
+  System::Threading::ThreadPool::QueueUserWorkItem(
+      gcnew System::Threading::WaitCallback(background_work,
+                                            &BackgroundWork::Run));
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
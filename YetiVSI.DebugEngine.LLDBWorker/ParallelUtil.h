@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Runs |body| for every index in [0, count) on the .NET thread pool and blocks
+// until all iterations are done. <thread> is not available when compiling with
+// /clr, so this is how native code in the worker spreads work across cores.
+// |max_parallelism| limits the number of concurrent iterations, 0 means no
+// limit. |body| must not throw.
+void ParallelFor(int32_t count, const std::function<void(int32_t)>& body,
+                 int32_t max_parallelism = 0);
+
+// Runs |work| on the .NET thread pool without waiting for it. |work| must not
+// throw.
+void RunInBackground(std::function<void()> work);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,438 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "SourceLineIndex.h"
+
+#include <msclr/lock.h>
+#include <msclr/marshal_cppstd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+#include "ParallelUtil.h"
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBBlock.h"
+#include "lldb/API/SBCompileUnit.h"
+#include "lldb/API/SBFileSpec.h"
+#include "lldb/API/SBFunction.h"
+#include "lldb/API/SBLineEntry.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the index registry. <mutex> is not available when compiling with
+// /clr.
+private
+ref class SourceLineIndexLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+constexpr char kIndexFileMagic[] = "YLIDX002";
+
+std::string g_cache_directory;
+std::unordered_map<std::string, std::unique_ptr<SourceLineIndex>> g_indexes;
+// UUIDs of the modules whose index is being loaded or built.
+std::unordered_set<std::string> g_pending;
+
+void Log(System::String ^ message) {
+  System::String ^ tagged_message =
+      System::String::Format("SourceLineIndex: {0}", message);
+  System::Diagnostics::Debug::WriteLine(tagged_message);
+}
+
+std::string GetFileName(const std::string& normalized_path) {
+  size_t separator = normalized_path.rfind('/');
+  return separator == std::string::npos
+             ? normalized_path
+             : normalized_path.substr(separator + 1);
+}
+
+// The worker only runs on little-endian hosts.
+template <typename T>
+void Write(std::ofstream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool Read(std::ifstream& in, T* value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char*>(value), sizeof(*value)));
+}
+
+}  // namespace
+
+std::string NormalizeSourcePath(const std::string& path) {
+  std::string lowered(path);
+  for (char& c : lowered) {
+    if (c == '\\') {
+      c = '/';
+    } else {
+      c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+  }
+
+  std::vector<std::string> components;
+  size_t start = 0;
+  while (start <= lowered.size()) {
+    size_t end = lowered.find('/', start);
+    if (end == std::string::npos) {
+      end = lowered.size();
+    }
+    std::string component = lowered.substr(start, end - start);
+    if (component == "..") {
+      if (!components.empty() && components.back() != "..") {
+        components.pop_back();
+      } else {
+        components.push_back(component);
+      }
+    } else if (!component.empty() && component != ".") {
+      components.push_back(component);
+    }
+    start = end + 1;
+  }
+
+  std::string normalized = !lowered.empty() && lowered[0] == '/' ? "/" : "";
+  for (size_t i = 0; i < components.size(); ++i) {
+    if (i > 0) {
+      normalized += '/';
+    }
+    normalized += components[i];
+  }
+  return normalized;
+}
+
+std::unique_ptr<SourceLineIndex> SourceLineIndex::Build(
+    lldb::SBModule module) {
+  uint32_t num_compile_units = module.GetNumCompileUnits();
+  std::vector<std::unordered_map<std::string, LineMap>> partial_indexes(
+      num_compile_units);
+  ParallelFor(num_compile_units, [&](int32_t cu_index) {
+    lldb::SBCompileUnit compile_unit = module.GetCompileUnitAtIndex(cu_index);
+    auto& files = partial_indexes[cu_index];
+    // File specs store their components as pooled strings, so the pointers
+    // identify a file and the path is only normalized once.
+    std::map<std::pair<const char*, const char*>, std::string> paths;
+    uint32_t num_entries = compile_unit.GetNumLineEntries();
+    for (uint32_t i = 0; i < num_entries; ++i) {
+      lldb::SBLineEntry entry = compile_unit.GetLineEntryAtIndex(i);
+      uint32_t line = entry.GetLine();
+      // The breakpoint resolver ignores the rows that end a sequence and the
+      // rows without is_stmt, so they must not become locations here either.
+      if (line == 0 || entry.IsTerminalEntry() ||
+          !entry.IsStartOfStatement()) {
+        continue;
+      }
+      lldb::SBFileSpec file_spec = entry.GetFileSpec();
+      auto key = std::make_pair(file_spec.GetDirectory(),
+                                file_spec.GetFilename());
+      auto path = paths.find(key);
+      if (path == paths.end()) {
+        std::string full_path = key.first ? std::string(key.first) + "/" : "";
+        full_path += key.second ? key.second : "";
+        path = paths.emplace(key, NormalizeSourcePath(full_path)).first;
+      }
+      files[path->second][line].push_back(
+          entry.GetStartAddress().GetFileAddress());
+    }
+  });
+
+  auto index = std::make_unique<SourceLineIndex>();
+  for (auto& files : partial_indexes) {
+    for (auto& file : files) {
+      index->AddFile(file.first, std::move(file.second));
+    }
+  }
+  for (auto& file : index->files_) {
+    for (auto& line : file.second) {
+      std::vector<uint64_t>& addresses = line.second;
+      std::sort(addresses.begin(), addresses.end());
+      addresses.erase(std::unique(addresses.begin(), addresses.end()),
+                      addresses.end());
+    }
+  }
+  return index;
+}
+
+void SourceLineIndex::AddFile(std::string normalized_path, LineMap lines) {
+  file_names_.insert(GetFileName(normalized_path));
+  LineMap& existing = files_[std::move(normalized_path)];
+  if (existing.empty()) {
+    existing = std::move(lines);
+    return;
+  }
+  for (auto& line : lines) {
+    std::vector<uint64_t>& addresses = existing[line.first];
+    addresses.insert(addresses.end(), line.second.begin(), line.second.end());
+  }
+}
+
+std::unique_ptr<SourceLineIndex> SourceLineIndex::Load(
+    const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(kIndexFileMagic) - 1];
+  if (!in || !in.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != kIndexFileMagic) {
+    return nullptr;
+  }
+
+  auto index = std::make_unique<SourceLineIndex>();
+  uint32_t num_files;
+  if (!Read(in, &num_files)) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < num_files; ++i) {
+    uint32_t path_length;
+    if (!Read(in, &path_length)) {
+      return nullptr;
+    }
+    std::string file_path(path_length, '\0');
+    uint32_t num_lines;
+    if (!in.read(&file_path[0], path_length) || !Read(in, &num_lines)) {
+      return nullptr;
+    }
+    LineMap lines;
+    for (uint32_t j = 0; j < num_lines; ++j) {
+      uint32_t line;
+      uint32_t num_addresses;
+      if (!Read(in, &line) || !Read(in, &num_addresses)) {
+        return nullptr;
+      }
+      std::vector<uint64_t>& addresses = lines[line];
+      addresses.resize(num_addresses);
+      if (!in.read(reinterpret_cast<char*>(addresses.data()),
+                   num_addresses * sizeof(uint64_t))) {
+        return nullptr;
+      }
+    }
+    index->AddFile(std::move(file_path), std::move(lines));
+  }
+  return index;
+}
+
+// File layout, all integers little-endian:
+//   "YLIDX002", u32 file count, per file:
+//     u32 path length, path, u32 line count, per line:
+//       u32 line, u32 address count, u64 addresses.
+// The index is written to a temporary file that is then renamed to |path|, so
+// that a crash or another session saving the same index never leaves a
+// truncated file behind.
+bool SourceLineIndex::Save(const std::string& path) const {
+  std::string temp_path =
+      path + "." +
+      msclr::interop::marshal_as<std::string>(
+          System::Guid::NewGuid().ToString("N")) +
+      ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return false;
+    }
+    out.write(kIndexFileMagic, sizeof(kIndexFileMagic) - 1);
+    Write(out, static_cast<uint32_t>(files_.size()));
+    for (const auto& file : files_) {
+      Write(out, static_cast<uint32_t>(file.first.size()));
+      out.write(file.first.data(), file.first.size());
+      Write(out, static_cast<uint32_t>(file.second.size()));
+      for (const auto& line : file.second) {
+        Write(out, line.first);
+        Write(out, static_cast<uint32_t>(line.second.size()));
+        out.write(reinterpret_cast<const char*>(line.second.data()),
+                  line.second.size() * sizeof(uint64_t));
+      }
+    }
+    out.close();
+    if (!out) {
+      std::remove(temp_path.c_str());
+      return false;
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    std::remove(temp_path.c_str());
+    // On Windows rename fails if |path| exists, which means that another
+    // session has saved the same index in the meantime.
+    return std::ifstream(path).good();
+  }
+  return true;
+}
+
+bool SourceLineIndex::ContainsFileName(
+    const std::string& normalized_path) const {
+  return file_names_.count(GetFileName(normalized_path)) > 0;
+}
+
+const std::vector<uint64_t>* SourceLineIndex::Lookup(
+    const std::string& normalized_path, uint32_t line) const {
+  auto file = files_.find(normalized_path);
+  if (file == files_.end()) {
+    return nullptr;
+  }
+  auto addresses = file->second.find(line);
+  return addresses == file->second.end() ? nullptr : &addresses->second;
+}
+
+void SetSourceLineIndexCacheDirectory(const std::string& path) {
+  msclr::lock lock(SourceLineIndexLock::instance);
+  g_cache_directory = path;
+}
+
+namespace {
+
+// Loads the index of |module| from the cache directory, or builds and saves it.
+// Runs without holding the lock, so that breakpoints of other modules can be
+// created meanwhile.
+void LoadOrBuildIndex(lldb::SBModule module, std::string uuid) {
+  std::string cache_directory;
+  {
+    msclr::lock lock(SourceLineIndexLock::instance);
+    cache_directory = g_cache_directory;
+  }
+
+  std::string cache_path;
+  std::unique_ptr<SourceLineIndex> index;
+  if (!cache_directory.empty()) {
+    cache_path = cache_directory + "\\" + uuid + ".lineidx";
+    index = SourceLineIndex::Load(cache_path);
+  }
+  if (index == nullptr) {
+    index = SourceLineIndex::Build(module);
+    if (!cache_path.empty()) {
+      System::IO::Directory::CreateDirectory(
+          gcnew System::String(cache_directory.c_str()));
+      if (!index->Save(cache_path)) {
+        Log("Failed to save " + gcnew System::String(cache_path.c_str()));
+      }
+    }
+  }
+
+  msclr::lock lock(SourceLineIndexLock::instance);
+  g_indexes[uuid] = std::move(index);
+  g_pending.erase(uuid);
+}
+
+// Returns the UUID of |module| if it can have an index, or an empty string.
+std::string GetIndexKey(lldb::SBModule module) {
+  const char* uuid = module.GetUUIDString();
+  if (uuid == nullptr || *uuid == '\0' || module.GetNumCompileUnits() == 0) {
+    return {};
+  }
+  return uuid;
+}
+
+}  // namespace
+
+void BuildSourceLineIndexesInBackground(std::vector<lldb::SBModule> modules) {
+  for (lldb::SBModule& module : modules) {
+    std::string uuid = GetIndexKey(module);
+    if (uuid.empty()) {
+      continue;
+    }
+    {
+      msclr::lock lock(SourceLineIndexLock::instance);
+      if (g_indexes.count(uuid) > 0 || !g_pending.insert(uuid).second) {
+        continue;
+      }
+    }
+    RunInBackground([module, uuid]() { LoadOrBuildIndex(module, uuid); });
+  }
+}
+
+const SourceLineIndex* GetSourceLineIndex(lldb::SBModule module) {
+  std::string uuid = GetIndexKey(module);
+  if (uuid.empty()) {
+    return nullptr;
+  }
+  {
+    msclr::lock lock(SourceLineIndexLock::instance);
+    auto it = g_indexes.find(uuid);
+    if (it != g_indexes.end()) {
+      return it->second.get();
+    }
+  }
+  BuildSourceLineIndexesInBackground({module});
+  return nullptr;
+}
+
+lldb::SBBreakpoint BreakpointCreateFromSourceLineIndex(lldb::SBTarget target,
+                                                       const std::string& file,
+                                                       uint32_t line) {
+  std::string normalized_path = NormalizeSourcePath(file);
+  lldb::SBAddress match;
+  for (uint32_t i = 0; i < target.GetNumModules(); ++i) {
+    lldb::SBModule module = target.GetModuleAtIndex(i);
+    const SourceLineIndex* index = GetSourceLineIndex(module);
+    if (index == nullptr) {
+      // Without an index it is unknown whether the module has code for the
+      // line, unless it has no line tables at all. This includes indexes that
+      // are still being built.
+      if (module.GetNumCompileUnits() > 0) {
+        return lldb::SBBreakpoint();
+      }
+      continue;
+    }
+    if (!index->ContainsFileName(normalized_path)) {
+      continue;
+    }
+    const std::vector<uint64_t>* addresses =
+        index->Lookup(normalized_path, line);
+    // The module might have the file under a different directory (e.g. due to
+    // a source map), or the line has no code and LLDB would move the
+    // breakpoint to the next line with code.
+    if (addresses == nullptr || addresses->empty() || match.IsValid()) {
+      return lldb::SBBreakpoint();
+    }
+
+    lldb::SBFunction function;
+    for (uint64_t file_address : *addresses) {
+      lldb::SBAddress address = module.ResolveFileAddress(file_address);
+      lldb::SBFunction address_function = address.GetFunction();
+      if (!address_function.IsValid() ||
+          address.GetBlock().GetContainingInlinedBlock().IsValid()) {
+        return lldb::SBBreakpoint();
+      }
+      if (!function.IsValid()) {
+        function = address_function;
+      } else if (function != address_function) {
+        return lldb::SBBreakpoint();
+      }
+    }
+    // LLDB moves breakpoints on the first line of a function past the
+    // prologue.
+    uint64_t prologue_end = function.GetStartAddress().GetFileAddress() +
+                            function.GetPrologueByteSize();
+    if (addresses->front() < prologue_end) {
+      return lldb::SBBreakpoint();
+    }
+    match = module.ResolveFileAddress(addresses->front());
+  }
+  if (!match.IsValid()) {
+    return lldb::SBBreakpoint();
+  }
+  // The breakpoint stays a file and line breakpoint, so LLDB still resolves it
+  // in modules that are loaded later. Only the search of the loaded modules is
+  // replaced by the index.
+  return target.BreakpointCreateByResolvedLocation(
+      lldb::SBFileSpec(file.c_str(), false), line, match);
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
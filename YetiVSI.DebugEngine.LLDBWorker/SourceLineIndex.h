@@ -0,0 +1,99 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "lldb/API/SBBreakpoint.h"
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBTarget.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Normalizes |path| for index lookups. Separators become '/', "." and ".."
+// components are resolved and the path is lowercased, since Visual Studio
+// treats source paths case-insensitively.
+std::string NormalizeSourcePath(const std::string& path);
+
+// Maps normalized source paths and lines to the file addresses of the line
+// table entries of a module.
+class SourceLineIndex {
+ public:
+  // Builds the index from the line tables of |module|. Compile units are
+  // processed in parallel.
+  static std::unique_ptr<SourceLineIndex> Build(lldb::SBModule module);
+
+  // Reads an index written by Save. Returns nullptr if |path| doesn't exist or
+  // is not a valid index.
+  static std::unique_ptr<SourceLineIndex> Load(const std::string& path);
+
+  bool Save(const std::string& path) const;
+
+  // Returns true if the index has a file with the same file name as
+  // |normalized_path|, in any directory.
+  bool ContainsFileName(const std::string& normalized_path) const;
+
+  // Returns the sorted file addresses of |line| in |normalized_path|, or
+  // nullptr if the line has no code.
+  const std::vector<uint64_t>* Lookup(const std::string& normalized_path,
+                                      uint32_t line) const;
+
+ private:
+  using LineMap = std::map<uint32_t, std::vector<uint64_t>>;
+
+  void AddFile(std::string normalized_path, LineMap lines);
+
+  std::unordered_map<std::string, LineMap> files_;
+  std::unordered_set<std::string> file_names_;
+};
+
+// Sets the directory indexes are persisted in, keyed by module UUID. Indexes
+// are only kept in memory if no directory is set.
+void SetSourceLineIndexCacheDirectory(const std::string& path);
+
+// Loads the indexes of |modules| from the cache directory, or builds and saves
+// them, on the thread pool. Modules that are indexed already are skipped.
+void BuildSourceLineIndexesInBackground(std::vector<lldb::SBModule> modules);
+
+// Returns the index of |module| if it is ready. Otherwise returns nullptr and
+// starts loading or building it in the background. Returns nullptr for modules
+// without UUID or line tables.
+const SourceLineIndex* GetSourceLineIndex(lldb::SBModule module);
+
+// Creates a breakpoint for |file|:|line| whose locations in the loaded modules
+// come from the source line indexes, which avoids LLDB's search of all line
+// tables. This only succeeds if the line has code in a single function of a
+// single module, outside of its prologue and of inlined blocks. In that case
+// LLDB would resolve the breakpoint to the lowest of these addresses. The
+// breakpoint is still a file and line breakpoint, so LLDB resolves it in
+// modules that are loaded later. Otherwise, or if a module with line tables
+// has no index yet, an invalid breakpoint is returned and the caller falls back
+// to SBTarget::BreakpointCreateByLocation.
+lldb::SBBreakpoint BreakpointCreateFromSourceLineIndex(lldb::SBTarget target,
+                                                       const std::string& file,
+                                                       uint32_t line);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
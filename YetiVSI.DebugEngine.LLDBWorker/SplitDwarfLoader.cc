@@ -0,0 +1,199 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma managed(on)
+
+#include "SplitDwarfLoader.h"
+
+#include <cstdint>
+
+#include "ParallelUtil.h"
+#include "lldb/API/SBCompileUnit.h"
+#include "lldb/API/SBData.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBSection.h"
+#include "lldb/API/SBSymbolContextList.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+namespace {
+
+// Modules loaded at the same time. LLDB indexes the units of a module on its
+// own thread pool, so a few modules are enough to keep the cores busy.
+constexpr int32_t kMaxConcurrentLoads = 4;
+
+constexpr uint8_t kDwUtSkeleton = 0x04;
+constexpr uint64_t kDwAtDwoName = 0x76;
+constexpr uint64_t kDwAtGnuDwoName = 0x2130;
+constexpr uint64_t kDwFormImplicitConst = 0x21;
+
+// Long enough for the largest unit header and the abbreviation code of the
+// unit DIE.
+constexpr uint64_t kUnitHeaderReadSize = 40;
+
+// No function has this name, so looking it up only builds the index.
+constexpr char kIndexProbeName[] = "$split-dwarf-index-probe$";
+
+void LoadSplitDwarf(lldb::SBModule module) {
+  // Building the manual DWARF index extracts the units of the .dwo files and
+  // the package in parallel. An index read from the cache doesn't touch them.
+  module.FindFunctions(kIndexProbeName, lldb::eFunctionNameTypeFull);
+  // Creating a compile unit locates and maps its split unit, if the index
+  // didn't already. LLDB serializes this per module.
+  uint32_t num_compile_units = module.GetNumCompileUnits();
+  for (uint32_t i = 0; i < num_compile_units; ++i) {
+    module.GetCompileUnitAtIndex(i);
+  }
+}
+
+bool ReadULEB128(lldb::SBData& data, lldb::offset_t* offset,
+                 uint64_t* value) {
+  lldb::SBError error;
+  *value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = data.GetUnsignedInt8(error, (*offset)++);
+    if (error.Fail()) {
+      return false;
+    }
+    *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if abbreviation |code| of the table at |offset| in
+// |debug_abbrev| has a DWO name, which only skeleton units have.
+bool AbbreviationHasDwoName(lldb::SBData& debug_abbrev, lldb::offset_t offset,
+                            uint64_t code) {
+  uint64_t abbreviation_code;
+  while (ReadULEB128(debug_abbrev, &offset, &abbreviation_code) &&
+         abbreviation_code != 0) {
+    uint64_t tag;
+    if (!ReadULEB128(debug_abbrev, &offset, &tag)) {
+      return false;
+    }
+    // Skips DW_CHILDREN.
+    ++offset;
+    uint64_t name;
+    uint64_t form;
+    while (ReadULEB128(debug_abbrev, &offset, &name) &&
+           ReadULEB128(debug_abbrev, &offset, &form) &&
+           (name != 0 || form != 0)) {
+      if (abbreviation_code == code &&
+          (name == kDwAtDwoName || name == kDwAtGnuDwoName)) {
+        return true;
+      }
+      // The constant is stored in the abbreviation. Reading it as unsigned
+      // skips the same bytes.
+      uint64_t implicit_const;
+      if (form == kDwFormImplicitConst &&
+          !ReadULEB128(debug_abbrev, &offset, &implicit_const)) {
+        return false;
+      }
+    }
+    if (abbreviation_code == code) {
+      return false;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool HasSplitDwarf(lldb::SBModule module) {
+  lldb::SBSection debug_info = module.FindSection(".debug_info");
+  if (!debug_info.IsValid() || !module.FindSection(".debug_addr").IsValid()) {
+    return false;
+  }
+  lldb::SBSection debug_abbrev_section = module.FindSection(".debug_abbrev");
+  lldb::SBData debug_abbrev;
+  if (debug_abbrev_section.IsValid()) {
+    debug_abbrev = debug_abbrev_section.GetSectionData();
+  }
+
+  // Mixed modules can have skeletons anywhere, so the units are scanned until
+  // one is found. Only the unit headers are read.
+  uint64_t size = debug_info.GetFileByteSize();
+  uint64_t unit_offset = 0;
+  while (unit_offset < size) {
+    lldb::SBData header =
+        debug_info.GetSectionData(unit_offset, kUnitHeaderReadSize);
+    lldb::SBError error;
+    uint64_t unit_length = header.GetUnsignedInt32(error, 0);
+    lldb::offset_t offset = 4;
+    uint32_t offset_size = 4;
+    if (unit_length == 0xffffffff) {
+      unit_length = header.GetUnsignedInt64(error, offset);
+      offset += 8;
+      offset_size = 8;
+    }
+    uint16_t version = header.GetUnsignedInt16(error, offset);
+    offset += 2;
+    if (error.Fail()) {
+      return false;
+    }
+    // A compressed section starts with a compression header. Its type is too
+    // small to be the length of a unit, and the units can't be read in place.
+    if (unit_offset == 0 && unit_length < 7) {
+      return true;
+    }
+
+    if (version >= 5) {
+      uint8_t unit_type = header.GetUnsignedInt8(error, offset);
+      if (error.Success() && unit_type == kDwUtSkeleton) {
+        return true;
+      }
+    } else {
+      // DWARF 4 skeletons are compile units with DW_AT_GNU_dwo_name.
+      uint64_t abbrev_offset = offset_size == 8
+                                   ? header.GetUnsignedInt64(error, offset)
+                                   : header.GetUnsignedInt32(error, offset);
+      // Skips the address size.
+      offset += offset_size + 1;
+      uint64_t code;
+      if (error.Fail() || !ReadULEB128(header, &offset, &code)) {
+        return false;
+      }
+      if (!debug_abbrev.IsValid()) {
+        // Without abbreviations, only split DWARF produces .debug_addr for
+        // DWARF 4.
+        return true;
+      }
+      if (AbbreviationHasDwoName(debug_abbrev, abbrev_offset, code)) {
+        return true;
+      }
+    }
+    unit_offset += (offset_size == 8 ? 12 : 4) + unit_length;
+  }
+  return false;
+}
+
+void LoadSplitDwarfInBackground(std::vector<lldb::SBModule> modules) {
+  RunInBackground([modules]() {
+    ParallelFor(
+        static_cast<int32_t>(modules.size()),
+        [&](int32_t i) {
+          if (HasSplitDwarf(modules[i])) {
+            LoadSplitDwarf(modules[i]);
+          }
+        },
+        kMaxConcurrentLoads);
+  });
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "lldb/API/SBModule.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Returns true if |module| has a split DWARF skeleton unit, whose debug info
+// is in a .dwo file or in a DWARF package (.dwp).
+bool HasSplitDwarf(lldb::SBModule module);
+
+// Starts loading the split DWARF of |modules| on the thread pool. The DWARF
+// index of each module is built or read from the index cache, and the .dwo
+// files or package units of all compile units are located and mapped.
+// Otherwise LLDB opens them one at a time when the first expression touches
+// their compile units. Modules without split DWARF are skipped.
+void LoadSplitDwarfInBackground(std::vector<lldb::SBModule> modules);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
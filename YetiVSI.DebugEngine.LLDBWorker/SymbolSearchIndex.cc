@@ -0,0 +1,534 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma managed(on)
+
+#include "SymbolSearchIndex.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "ParallelUtil.h"
+#include "lldb/API/SBAddress.h"
+#include "lldb/API/SBSymbol.h"
+
+#using < system.dll>
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the index registry. <mutex> is not available when compiling with
+// /clr.
+private
+ref class SymbolSearchIndexLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+constexpr char kIndexFileMagic[] = "YSIDX001";
+
+// Trigrams of longer names would make up most of the postings of a module
+// with many template instantiations, while searches rarely target them.
+constexpr size_t kMaxIndexedNameLength = 512;
+
+// Each build holds a copy of all symbol names of its module.
+constexpr int32_t kMaxConcurrentBuilds = 4;
+
+std::string g_cache_directory;
+std::unordered_map<std::string, std::shared_ptr<const SymbolTrigramIndex>>
+    g_indexes;
+
+void Log(System::String ^ message) {
+  System::String ^ tagged_message =
+      System::String::Format("SymbolSearchIndex: {0}", message);
+  System::Diagnostics::Debug::WriteLine(tagged_message);
+}
+
+uint32_t GetTrigram(const char* str) {
+  return static_cast<uint32_t>(static_cast<unsigned char>(str[0])) << 16 |
+         static_cast<uint32_t>(static_cast<unsigned char>(str[1])) << 8 |
+         static_cast<uint32_t>(static_cast<unsigned char>(str[2]));
+}
+
+// Stores the distinct trigrams of |str| in |trigrams|, sorted.
+void GetTrigrams(const char* str, size_t length,
+                 std::vector<uint32_t>* trigrams) {
+  trigrams->clear();
+  for (size_t i = 0; i + 3 <= length; ++i) {
+    trigrams->push_back(GetTrigram(str + i));
+  }
+  std::sort(trigrams->begin(), trigrams->end());
+  trigrams->erase(std::unique(trigrams->begin(), trigrams->end()),
+                  trigrams->end());
+}
+
+// The worker only runs on little-endian hosts.
+template <typename T>
+void Write(std::ofstream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool Read(std::ifstream& in, T* value) {
+  return static_cast<bool>(
+      in.read(reinterpret_cast<char*>(value), sizeof(*value)));
+}
+
+template <typename T>
+void WriteVector(std::ofstream& out, const std::vector<T>& values) {
+  Write(out, static_cast<uint64_t>(values.size()));
+  out.write(reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(T));
+}
+
+template <typename T>
+bool ReadVector(std::ifstream& in, std::vector<T>* values) {
+  uint64_t size;
+  // Bounds the allocation if the file is corrupt.
+  if (!Read(in, &size) || size > UINT32_MAX) {
+    return false;
+  }
+  values->resize(static_cast<size_t>(size));
+  return static_cast<bool>(in.read(reinterpret_cast<char*>(values->data()),
+                                   values->size() * sizeof(T)));
+}
+
+// Finds literal strings that every match of the .NET regular expression
+// |pattern| contains and stores those of three or more bytes in |literals|.
+// Anything that might be optional, repeated or case-insensitive ends a
+// literal. Returns false if the pattern has constructs the literals can't be
+// derived for, e.g. alternations or inline options.
+bool GetRequiredLiterals(const std::string& pattern,
+                         std::vector<std::string>* literals) {
+  std::string literal;
+  auto end_literal = [&]() {
+    if (literal.size() >= 3) {
+      literals->push_back(literal);
+    }
+    literal.clear();
+  };
+  // Skips a character class starting at |i| and returns the index of its
+  // closing bracket, or std::string::npos if there is none.
+  auto skip_class = [&](size_t i) {
+    ++i;
+    if (i < pattern.size() && pattern[i] == '^') {
+      ++i;
+    }
+    // A leading ']' is part of the class.
+    if (i < pattern.size() && pattern[i] == ']') {
+      ++i;
+    }
+    for (; i < pattern.size(); ++i) {
+      if (pattern[i] == '\\') {
+        ++i;
+      } else if (pattern[i] == ']') {
+        return i;
+      }
+    }
+    return std::string::npos;
+  };
+
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    char c = pattern[i];
+    switch (c) {
+      case '|':
+        return false;
+      case '(': {
+        if (i + 1 < pattern.size() && pattern[i + 1] == '?') {
+          return false;
+        }
+        // Groups may be optional or contain alternations, so they are
+        // skipped.
+        end_literal();
+        int depth = 0;
+        for (; i < pattern.size(); ++i) {
+          if (pattern[i] == '\\') {
+            ++i;
+          } else if (pattern[i] == '[') {
+            i = skip_class(i);
+            if (i == std::string::npos) {
+              return false;
+            }
+          } else if (pattern[i] == '(') {
+            ++depth;
+          } else if (pattern[i] == ')' && --depth == 0) {
+            break;
+          }
+        }
+        if (i >= pattern.size()) {
+          return false;
+        }
+        break;
+      }
+      case '[':
+        end_literal();
+        i = skip_class(i);
+        if (i == std::string::npos) {
+          return false;
+        }
+        break;
+      case '*':
+      case '?':
+      case '{':
+        // The preceding character is optional or repeated.
+        if (!literal.empty()) {
+          literal.pop_back();
+        }
+        end_literal();
+        if (c == '{') {
+          i = pattern.find('}', i);
+          if (i == std::string::npos) {
+            return false;
+          }
+        }
+        break;
+      case '+':
+      case '.':
+      case '^':
+      case '$':
+        end_literal();
+        break;
+      case '\\': {
+        if (i + 1 >= pattern.size()) {
+          return false;
+        }
+        char escaped = pattern[++i];
+        if (std::string("dDwWsSbBAzZG").find(escaped) != std::string::npos) {
+          end_literal();
+        } else if (std::isalnum(static_cast<unsigned char>(escaped))) {
+          // Character codes, properties and back references.
+          return false;
+        } else {
+          literal += escaped;
+        }
+        break;
+      }
+      default:
+        literal += c;
+    }
+  }
+  end_literal();
+  return true;
+}
+
+}  // namespace
+
+std::unique_ptr<SymbolTrigramIndex> SymbolTrigramIndex::Build(
+    lldb::SBModule module) {
+  auto index = std::make_unique<SymbolTrigramIndex>();
+  uint32_t num_module_symbols = module.GetNumSymbols();
+  index->num_module_symbols_ = num_module_symbols;
+  for (uint32_t i = 0; i < num_module_symbols; ++i) {
+    lldb::SBSymbol symbol = module.GetSymbolAtIndex(i);
+    if (symbol.GetType() != lldb::eSymbolTypeCode) {
+      continue;
+    }
+    const char* name = symbol.GetDisplayName();
+    uint64_t address = symbol.GetStartAddress().GetFileAddress();
+    if (name == nullptr || *name == '\0' || address == LLDB_INVALID_ADDRESS) {
+      continue;
+    }
+    index->name_offsets_.push_back(
+        static_cast<uint32_t>(index->names_.size()));
+    index->names_.append(name);
+    index->names_.push_back('\0');
+    index->addresses_.push_back(address);
+  }
+
+  // Postings are laid out in one array, so the trigrams are counted first to
+  // size it.
+  uint32_t num_symbols = index->GetNumSymbols();
+  std::vector<uint32_t> trigrams;
+  std::unordered_map<uint32_t, uint32_t> positions;
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    const char* name = index->GetName(i);
+    size_t length = std::strlen(name);
+    if (length > kMaxIndexedNameLength) {
+      index->unindexed_.push_back(i);
+      continue;
+    }
+    GetTrigrams(name, length, &trigrams);
+    for (uint32_t trigram : trigrams) {
+      ++positions[trigram];
+    }
+  }
+  index->trigrams_.reserve(positions.size());
+  for (const auto& trigram : positions) {
+    index->trigrams_.push_back(trigram.first);
+  }
+  std::sort(index->trigrams_.begin(), index->trigrams_.end());
+  index->posting_offsets_.reserve(index->trigrams_.size() + 1);
+  index->posting_offsets_.push_back(0);
+  for (uint32_t trigram : index->trigrams_) {
+    uint32_t& position = positions[trigram];
+    uint32_t count = position;
+    position = index->posting_offsets_.back();
+    index->posting_offsets_.push_back(position + count);
+  }
+
+  index->postings_.resize(index->posting_offsets_.back());
+  for (uint32_t i = 0; i < num_symbols; ++i) {
+    const char* name = index->GetName(i);
+    size_t length = std::strlen(name);
+    if (length > kMaxIndexedNameLength) {
+      continue;
+    }
+    GetTrigrams(name, length, &trigrams);
+    for (uint32_t trigram : trigrams) {
+      index->postings_[positions[trigram]++] = i;
+    }
+  }
+  return index;
+}
+
+std::unique_ptr<SymbolTrigramIndex> SymbolTrigramIndex::Load(
+    const std::string& path, uint32_t num_module_symbols) {
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(kIndexFileMagic) - 1];
+  if (!in || !in.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != kIndexFileMagic) {
+    return nullptr;
+  }
+
+  auto index = std::make_unique<SymbolTrigramIndex>();
+  if (!Read(in, &index->num_module_symbols_) ||
+      index->num_module_symbols_ != num_module_symbols) {
+    return nullptr;
+  }
+  std::vector<char> names;
+  if (!ReadVector(in, &names) || !ReadVector(in, &index->name_offsets_) ||
+      !ReadVector(in, &index->addresses_) ||
+      !ReadVector(in, &index->trigrams_) ||
+      !ReadVector(in, &index->posting_offsets_) ||
+      !ReadVector(in, &index->postings_) ||
+      !ReadVector(in, &index->unindexed_)) {
+    return nullptr;
+  }
+  index->names_.assign(names.begin(), names.end());
+
+  // Lookups don't check bounds, so a truncated or corrupt file must not get
+  // through.
+  uint32_t num_symbols = index->GetNumSymbols();
+  auto is_symbol = [num_symbols](uint32_t i) { return i < num_symbols; };
+  if (index->name_offsets_.size() != num_symbols ||
+      (num_symbols > 0 &&
+       (index->names_.empty() || index->names_.back() != '\0')) ||
+      !std::all_of(index->name_offsets_.begin(), index->name_offsets_.end(),
+                   [&](uint32_t offset) {
+                     return offset < index->names_.size();
+                   }) ||
+      !std::is_sorted(index->trigrams_.begin(), index->trigrams_.end()) ||
+      index->posting_offsets_.size() != index->trigrams_.size() + 1 ||
+      index->posting_offsets_.front() != 0 ||
+      index->posting_offsets_.back() != index->postings_.size() ||
+      !std::is_sorted(index->posting_offsets_.begin(),
+                      index->posting_offsets_.end()) ||
+      !std::all_of(index->postings_.begin(), index->postings_.end(),
+                   is_symbol) ||
+      !std::all_of(index->unindexed_.begin(), index->unindexed_.end(),
+                   is_symbol)) {
+    return nullptr;
+  }
+  return index;
+}
+
+// File layout, all integers little-endian:
+//   "YSIDX001", u32 module symbol count, then the names, name offsets,
+//   addresses, trigrams, posting offsets, postings and unindexed symbols, each
+//   as a u64 element count followed by the elements.
+bool SymbolTrigramIndex::Save(const std::string& path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    return false;
+  }
+  out.write(kIndexFileMagic, sizeof(kIndexFileMagic) - 1);
+  Write(out, num_module_symbols_);
+  WriteVector(out, std::vector<char>(names_.begin(), names_.end()));
+  WriteVector(out, name_offsets_);
+  WriteVector(out, addresses_);
+  WriteVector(out, trigrams_);
+  WriteVector(out, posting_offsets_);
+  WriteVector(out, postings_);
+  WriteVector(out, unindexed_);
+  return static_cast<bool>(out);
+}
+
+std::vector<uint32_t> SymbolTrigramIndex::FindCandidates(
+    const std::vector<std::string>& literals) const {
+  std::vector<std::pair<const uint32_t*, const uint32_t*>> lists;
+  std::vector<uint32_t> trigrams;
+  for (const std::string& literal : literals) {
+    GetTrigrams(literal.data(), literal.size(), &trigrams);
+    for (uint32_t trigram : trigrams) {
+      auto it = std::lower_bound(trigrams_.begin(), trigrams_.end(), trigram);
+      if (it == trigrams_.end() || *it != trigram) {
+        return unindexed_;
+      }
+      size_t i = it - trigrams_.begin();
+      lists.push_back({postings_.data() + posting_offsets_[i],
+                       postings_.data() + posting_offsets_[i + 1]});
+    }
+  }
+
+  std::vector<uint32_t> candidates;
+  if (lists.empty()) {
+    candidates.resize(GetNumSymbols());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    return candidates;
+  }
+  // Starting with the shortest list keeps the intermediate results small.
+  std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) {
+    return a.second - a.first < b.second - b.first;
+  });
+  candidates.assign(lists[0].first, lists[0].second);
+  std::vector<uint32_t> intersection;
+  for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidates.begin(), candidates.end(),
+                          lists[i].first, lists[i].second,
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  if (!unindexed_.empty()) {
+    std::vector<uint32_t> merged;
+    merged.reserve(candidates.size() + unindexed_.size());
+    std::merge(candidates.begin(), candidates.end(), unindexed_.begin(),
+               unindexed_.end(), std::back_inserter(merged));
+    candidates.swap(merged);
+  }
+  return candidates;
+}
+
+void SetSymbolSearchIndexCacheDirectory(const std::string& path) {
+  msclr::lock lock(SymbolSearchIndexLock::instance);
+  g_cache_directory = path;
+}
+
+std::shared_ptr<const SymbolTrigramIndex> GetSymbolTrigramIndex(
+    lldb::SBModule module) {
+  const char* uuid = module.GetUUIDString();
+  if (uuid == nullptr || *uuid == '\0') {
+    return SymbolTrigramIndex::Build(module);
+  }
+
+  uint32_t num_module_symbols = module.GetNumSymbols();
+  std::string cache_directory;
+  {
+    msclr::lock lock(SymbolSearchIndexLock::instance);
+    auto it = g_indexes.find(uuid);
+    if (it != g_indexes.end() &&
+        it->second->GetNumModuleSymbols() == num_module_symbols) {
+      return it->second;
+    }
+    cache_directory = g_cache_directory;
+  }
+
+  // Built outside of the lock, since building the index of a large module
+  // takes seconds. If two threads build the same index, the first one is
+  // kept.
+  std::string cache_path;
+  std::shared_ptr<const SymbolTrigramIndex> index;
+  if (!cache_directory.empty()) {
+    cache_path = cache_directory + "\\" + uuid + "-" +
+                 std::to_string(num_module_symbols) + ".symidx";
+    index = SymbolTrigramIndex::Load(cache_path, num_module_symbols);
+  }
+  if (index == nullptr) {
+    std::unique_ptr<SymbolTrigramIndex> built =
+        SymbolTrigramIndex::Build(module);
+    // The symbol table might have grown while the index was built.
+    if (!cache_path.empty() &&
+        built->GetNumModuleSymbols() == num_module_symbols) {
+      System::IO::Directory::CreateDirectory(
+          gcnew System::String(cache_directory.c_str()));
+      if (!built->Save(cache_path)) {
+        Log("Failed to save " + gcnew System::String(cache_path.c_str()));
+      }
+    }
+    index = std::move(built);
+  }
+
+  msclr::lock lock(SymbolSearchIndexLock::instance);
+  std::shared_ptr<const SymbolTrigramIndex>& entry = g_indexes[uuid];
+  if (entry == nullptr ||
+      entry->GetNumModuleSymbols() < index->GetNumModuleSymbols()) {
+    entry = index;
+  }
+  return entry;
+}
+
+void BuildSymbolTrigramIndexesInBackground(
+    std::vector<lldb::SBModule> modules) {
+  RunInBackground([modules]() {
+    ParallelFor(
+        static_cast<int32_t>(modules.size()),
+        [&](int32_t i) { GetSymbolTrigramIndex(modules[i]); },
+        kMaxConcurrentBuilds);
+  });
+}
+
+bool FindFunctionsMatching(lldb::SBTarget target, const std::string& pattern,
+                           uint32_t max_matches,
+                           std::vector<SymbolMatch>* matches) {
+  System::Text::RegularExpressions::Regex ^ regex;
+  try {
+    regex = gcnew System::Text::RegularExpressions::Regex(
+        gcnew System::String(pattern.c_str()),
+        System::Text::RegularExpressions::RegexOptions::CultureInvariant);
+  } catch (System::ArgumentException ^) {
+    return false;
+  }
+  std::vector<std::string> literals;
+  if (!GetRequiredLiterals(pattern, &literals)) {
+    literals.clear();
+  }
+
+  std::vector<lldb::SBModule> modules(target.GetNumModules());
+  for (size_t i = 0; i < modules.size(); ++i) {
+    modules[i] = target.GetModuleAtIndex(static_cast<uint32_t>(i));
+  }
+  std::vector<std::shared_ptr<const SymbolTrigramIndex>> indexes(
+      modules.size());
+  ParallelFor(
+      static_cast<int32_t>(modules.size()),
+      [&](int32_t i) { indexes[i] = GetSymbolTrigramIndex(modules[i]); },
+      kMaxConcurrentBuilds);
+
+  for (size_t i = 0; i < modules.size(); ++i) {
+    for (uint32_t symbol : indexes[i]->FindCandidates(literals)) {
+      if (matches->size() >= max_matches) {
+        return true;
+      }
+      const char* name = indexes[i]->GetName(symbol);
+      if (regex->IsMatch(gcnew System::String(name))) {
+        matches->push_back(
+            {name, modules[i], indexes[i]->GetFileAddress(symbol)});
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
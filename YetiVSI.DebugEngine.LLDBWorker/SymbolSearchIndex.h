@@ -0,0 +1,109 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lldb/API/SBModule.h"
+#include "lldb/API/SBTarget.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Trigram index over the names of the code symbols of a module. A query
+// intersects the posting lists of the trigrams of the literals the pattern
+// requires, so only the symbols containing all of them have to be matched.
+class SymbolTrigramIndex {
+ public:
+  // Builds the index from the symbol table of |module|.
+  static std::unique_ptr<SymbolTrigramIndex> Build(lldb::SBModule module);
+
+  // Reads an index written by Save. Returns nullptr if the file doesn't exist
+  // or isn't a valid index with |num_module_symbols| symbols.
+  static std::unique_ptr<SymbolTrigramIndex> Load(const std::string& path,
+                                                  uint32_t num_module_symbols);
+
+  bool Save(const std::string& path) const;
+
+  // Returns the indices of the symbols that contain all of |literals|, in
+  // symbol order. With no literal of three or more bytes, that is all
+  // symbols.
+  std::vector<uint32_t> FindCandidates(
+      const std::vector<std::string>& literals) const;
+
+  uint32_t GetNumSymbols() const {
+    return static_cast<uint32_t>(addresses_.size());
+  }
+  const char* GetName(uint32_t index) const {
+    return names_.data() + name_offsets_[index];
+  }
+  uint64_t GetFileAddress(uint32_t index) const { return addresses_[index]; }
+
+  // Number of symbols in the symbol table the index was built from, including
+  // the ones that aren't indexed. Used to detect that symbols were loaded
+  // since.
+  uint32_t GetNumModuleSymbols() const { return num_module_symbols_; }
+
+ private:
+  uint32_t num_module_symbols_ = 0;
+  // Null-terminated names, in symbol order.
+  std::string names_;
+  std::vector<uint32_t> name_offsets_;
+  std::vector<uint64_t> addresses_;
+  // Sorted trigrams, each with a range in postings_ that lists the symbols
+  // containing it.
+  std::vector<uint32_t> trigrams_;
+  std::vector<uint32_t> posting_offsets_;
+  std::vector<uint32_t> postings_;
+  // Symbols whose names are too long to index. They are always candidates.
+  std::vector<uint32_t> unindexed_;
+};
+
+// Sets the directory indexes are persisted in, keyed by module UUID and
+// symbol count. Indexes are only kept in memory if no directory is set.
+void SetSymbolSearchIndexCacheDirectory(const std::string& path);
+
+// Returns the index of |module|, which is loaded from the cache directory or
+// built and saved there on first use. It is rebuilt when the symbol table of
+// the module grew since, e.g. because a symbol file was added. Indexes of
+// modules without UUID are built on every call.
+std::shared_ptr<const SymbolTrigramIndex> GetSymbolTrigramIndex(
+    lldb::SBModule module);
+
+// Starts building the indexes of |modules| on the thread pool, so they are
+// ready when the first search runs.
+void BuildSymbolTrigramIndexesInBackground(
+    std::vector<lldb::SBModule> modules);
+
+struct SymbolMatch {
+  std::string name;
+  lldb::SBModule module;
+  uint64_t file_address;
+};
+
+// Finds up to |max_matches| functions of |target| whose names match the .NET
+// regular expression |pattern|, in module and symbol order. A pattern without
+// metacharacters is a substring search. Returns false if |pattern| is invalid.
+bool FindFunctionsMatching(lldb::SBTarget target, const std::string& pattern,
+                           uint32_t max_matches,
+                           std::vector<SymbolMatch>* matches);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,250 @@
+// Copyright 2022 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma managed(on)
+
+#include "Tracepoint.h"
+
+#include <msclr/lock.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+#include "BreakpointCallback.h"
+#include "lldb/API/SBData.h"
+#include "lldb/API/SBDebugger.h"
+#include "lldb/API/SBFrame.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBTarget.h"
+#include "lldb/API/SBValue.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+// Guards the tracepoint registry and buffers. Tracepoints are hit on LLDB's
+// private state thread while buffers are drained from RPC threads, and
+// <mutex> is not available when compiling with /clr.
+private
+ref class TracepointLock abstract sealed {
+ public:
+  static System::Object ^ instance = gcnew System::Object();
+};
+
+namespace {
+
+constexpr uint32_t kDefaultMaxValueSize = 64;
+constexpr uint32_t kInvalidValueSize = 0xffffffff;
+constexpr char kTraceFileMagic[] = "YTRACE01";
+
+// Tracepoints by debugger ID and breakpoint ID.
+using TracepointKey = std::pair<uint64_t, int32_t>;
+std::map<TracepointKey, std::unique_ptr<Tracepoint>> g_tracepoints;
+
+TracepointKey GetKey(lldb::SBTarget target, int32_t breakpoint_id) {
+  return {target.GetDebugger().GetID(), breakpoint_id};
+}
+
+bool ReadValueData(lldb::SBValue value, uint32_t max_size,
+                   std::vector<uint8_t>* data) {
+  if (!value.IsValid()) {
+    return false;
+  }
+  lldb::SBData sb_data = value.GetData();
+  size_t size = std::min<size_t>(
+      sb_data.GetByteSize(), max_size ? max_size : kDefaultMaxValueSize);
+  data->resize(size);
+  lldb::SBError error;
+  return size == 0 ||
+         sb_data.ReadRawData(error, 0, data->data(), size) == size;
+}
+
+// The worker only runs on little-endian hosts.
+template <typename T>
+void Write(std::ofstream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+Tracepoint::Tracepoint(std::vector<TraceItem> items, size_t capacity)
+    : items_(std::move(items)), ring_(std::max<size_t>(capacity, 1)) {}
+
+void Tracepoint::Collect(lldb::SBThread thread,
+                         lldb::SBBreakpointLocation location) {
+  TraceRecord record;
+  record.timestamp_ns = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+  record.thread_id = thread.GetThreadID();
+  lldb::SBFrame frame = thread.GetFrameAtIndex(0);
+  record.pc = frame.GetPC();
+  record.location_id = location.GetID();
+
+  std::vector<FrameExpression>& expressions = expressions_[record.location_id];
+  if (expressions.empty()) {
+    for (const TraceItem& item : items_) {
+      expressions.emplace_back(item.expression);
+    }
+  }
+
+  lldb::SBProcess process = thread.GetProcess();
+  record.values.resize(items_.size());
+  for (size_t i = 0; i < items_.size(); ++i) {
+    const TraceItem& item = items_[i];
+    TraceValue& value = record.values[i];
+    lldb::SBError error;
+    switch (item.kind) {
+      case TraceItemKind::kRegister:
+        value.valid = ReadValueData(
+            frame.FindRegister(item.expression.c_str()), item.size,
+            &value.data);
+        break;
+      case TraceItemKind::kExpression: {
+        lldb::SBValue result = expressions[i].Evaluate(frame, location, error);
+        value.valid =
+            error.Success() && ReadValueData(result, item.size, &value.data);
+        break;
+      }
+      case TraceItemKind::kMemory: {
+        lldb::SBValue address = expressions[i].Evaluate(frame, location, error);
+        if (error.Fail() || item.size == 0) {
+          value.valid = error.Success();
+          break;
+        }
+        value.data.resize(item.size);
+        size_t read = process.ReadMemory(address.GetValueAsUnsigned(),
+                                         value.data.data(), item.size, error);
+        value.data.resize(read);
+        value.valid = read == item.size;
+        break;
+      }
+    }
+  }
+
+  record.sequence = next_sequence_++;
+  if (size_ == ring_.size()) {
+    ring_[head_] = std::move(record);
+    head_ = (head_ + 1) % ring_.size();
+    dropped_++;
+  } else {
+    ring_[(head_ + size_) % ring_.size()] = std::move(record);
+    size_++;
+  }
+}
+
+uint64_t Tracepoint::Drain(size_t max_records,
+                           std::vector<TraceRecord>* records) {
+  size_t count = max_records == 0 ? size_ : std::min(max_records, size_);
+  records->reserve(records->size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    records->push_back(std::move(ring_[head_]));
+    ring_[head_] = TraceRecord();
+    head_ = (head_ + 1) % ring_.size();
+  }
+  size_ -= count;
+  uint64_t dropped = dropped_;
+  dropped_ = 0;
+  return dropped;
+}
+
+void SetTracepoint(lldb::SBBreakpoint breakpoint, std::vector<TraceItem> items,
+                   size_t capacity) {
+  {
+    msclr::lock lock(TracepointLock::instance);
+    g_tracepoints[GetKey(breakpoint.GetTarget(), breakpoint.GetID())] =
+        std::make_unique<Tracepoint>(std::move(items), capacity);
+  }
+  // Locations with a condition have the same callback installed, which
+  // overrides this one.
+  breakpoint.SetCallback(BreakpointHitCallback, nullptr);
+}
+
+void ClearTracepoint(lldb::SBBreakpoint breakpoint) {
+  breakpoint.SetCallback(nullptr, nullptr);
+  msclr::lock lock(TracepointLock::instance);
+  g_tracepoints.erase(GetKey(breakpoint.GetTarget(), breakpoint.GetID()));
+}
+
+bool CollectTracepointHit(lldb::SBProcess process, lldb::SBThread thread,
+                          lldb::SBBreakpointLocation location) {
+  // The tracepoint is looked up under the lock on every hit, so that it can be
+  // cleared while the process is running.
+  msclr::lock lock(TracepointLock::instance);
+  auto it = g_tracepoints.find(
+      GetKey(process.GetTarget(), location.GetBreakpoint().GetID()));
+  if (it == g_tracepoints.end()) {
+    return false;
+  }
+  it->second->Collect(thread, location);
+  return true;
+}
+
+bool DrainTracepoint(lldb::SBBreakpoint breakpoint, size_t max_records,
+                     std::vector<TraceRecord>* records, uint64_t* dropped) {
+  msclr::lock lock(TracepointLock::instance);
+  auto it =
+      g_tracepoints.find(GetKey(breakpoint.GetTarget(), breakpoint.GetID()));
+  if (it == g_tracepoints.end()) {
+    return false;
+  }
+  *dropped = it->second->Drain(max_records, records);
+  return true;
+}
+
+lldb::SBError WriteTraceFile(const std::string& path, int32_t breakpoint_id,
+                             const std::vector<TraceRecord>& records) {
+  lldb::SBError error;
+  bool is_new_file =
+      std::ifstream(path, std::ios::binary | std::ios::ate).tellg() <= 0;
+  std::ofstream out(path, std::ios::binary | std::ios::app);
+  if (!out) {
+    error.SetErrorStringWithFormat("Failed to open trace file %s",
+                                   path.c_str());
+    return error;
+  }
+  if (is_new_file) {
+    out.write(kTraceFileMagic, sizeof(kTraceFileMagic) - 1);
+  }
+  for (const TraceRecord& record : records) {
+    Write(out, record.sequence);
+    Write(out, record.timestamp_ns);
+    Write(out, record.thread_id);
+    Write(out, record.pc);
+    Write(out, breakpoint_id);
+    Write(out, record.location_id);
+    Write(out, static_cast<uint32_t>(record.values.size()));
+    for (const TraceValue& value : record.values) {
+      if (!value.valid) {
+        Write(out, kInvalidValueSize);
+        continue;
+      }
+      Write(out, static_cast<uint32_t>(value.data.size()));
+      out.write(reinterpret_cast<const char*>(value.data.data()),
+                value.data.size());
+    }
+  }
+  if (!out) {
+    error.SetErrorStringWithFormat("Failed to write trace file %s",
+                                   path.c_str());
+  }
+  return error;
+}
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2022 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FrameExpression.h"
+#include "lldb/API/SBBreakpoint.h"
+#include "lldb/API/SBBreakpointLocation.h"
+#include "lldb/API/SBError.h"
+#include "lldb/API/SBProcess.h"
+#include "lldb/API/SBThread.h"
+
+namespace YetiVSI {
+namespace DebugEngine {
+
+enum class TraceItemKind {
+  // Value of the register named |expression|.
+  kRegister,
+  // Value of |expression|, evaluated with lldb-eval.
+  kExpression,
+  // |size| bytes of memory at the address |expression| evaluates to.
+  kMemory,
+};
+
+// A value collected on every hit of a tracepoint.
+struct TraceItem {
+  TraceItemKind kind;
+  std::string expression;
+  // Bytes read for kMemory. For the other kinds, the maximum number of bytes
+  // kept, 0 for the default.
+  uint32_t size;
+};
+
+struct TraceValue {
+  // False if the item couldn't be evaluated or read.
+  bool valid = false;
+  std::vector<uint8_t> data;
+};
+
+// The values collected on one hit of a tracepoint, one per TraceItem.
+struct TraceRecord {
+  uint64_t sequence = 0;
+  uint64_t timestamp_ns = 0;
+  uint64_t thread_id = 0;
+  uint64_t pc = 0;
+  int32_t location_id = 0;
+  std::vector<TraceValue> values;
+};
+
+// Collects trace items into a bounded ring buffer whenever a breakpoint is
+// hit. When the buffer is full the oldest record is overwritten.
+class Tracepoint {
+ public:
+  Tracepoint(std::vector<TraceItem> items, size_t capacity);
+
+  void Collect(lldb::SBThread thread, lldb::SBBreakpointLocation location);
+
+  // Moves up to |max_records| of the oldest records to |records|, 0 means all
+  // of them. Returns the number of records that were overwritten since the
+  // previous call.
+  uint64_t Drain(size_t max_records, std::vector<TraceRecord>* records);
+
+ private:
+  std::vector<TraceItem> items_;
+  // Compiled expressions of |items_|, by breakpoint location ID.
+  std::map<int32_t, std::vector<FrameExpression>> expressions_;
+  std::vector<TraceRecord> ring_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  uint64_t next_sequence_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+// Turns |breakpoint| into a tracepoint. The process doesn't stop when the
+// breakpoint is hit, instead |items| are collected into a buffer that holds
+// the latest |capacity| hits. Hits of locations with a condition are only
+// collected if the condition is true. Replaces a previous tracepoint of
+// |breakpoint|.
+void SetTracepoint(lldb::SBBreakpoint breakpoint, std::vector<TraceItem> items,
+                   size_t capacity);
+
+// Turns |breakpoint| back into a regular breakpoint and drops its buffer.
+void ClearTracepoint(lldb::SBBreakpoint breakpoint);
+
+// Collects the trace items of the breakpoint of |location| if it is a
+// tracepoint. Returns false if it isn't.
+bool CollectTracepointHit(lldb::SBProcess process, lldb::SBThread thread,
+                          lldb::SBBreakpointLocation location);
+
+// Drains the buffer of |breakpoint|, see Tracepoint::Drain. Returns false if
+// |breakpoint| is not a tracepoint.
+bool DrainTracepoint(lldb::SBBreakpoint breakpoint, size_t max_records,
+                     std::vector<TraceRecord>* records, uint64_t* dropped);
+
+// Appends |records| of |breakpoint_id| to the binary trace file at |path|.
+// A new file starts with the 8 byte magic "YTRACE01". Every record is stored
+// as little-endian
+//   u64 sequence, u64 timestamp_ns, u64 thread_id, u64 pc,
+//   i32 breakpoint_id, i32 location_id, u32 value_count,
+// followed by value_count values, each a u32 size and size bytes of data.
+// Values that couldn't be collected have size 0xffffffff and no data.
+lldb::SBError WriteTraceFile(const std::string& path, int32_t breakpoint_id,
+                             const std::vector<TraceRecord>& records);
+
+}  // namespace DebugEngine
+}  // namespace YetiVSI
@@ -72,6 +72,9 @@ namespace YetiVSI.DebugEngine
         bool _enabled;
         bool _deleted;
 
+        // Condition set on the breakpoint location, or null.
+        string _condition;
+
         // LLDB doesn't support the equal style pass count natively. We implement it by disabling
         // the lldb breakpoint location once its hit count reaches its pass count. While that
         // happens, we don't modify |enabled| so the status appears unchanged on the UI.
@@ -170,6 +173,7 @@ namespace YetiVSI.DebugEngine
             // as it doesn't look like LLDB supports that.  If that's the case we'll need to fake it
             // by disabling the breakpoint.  Currently this is only coded to handle being called
             // from DebugPendingBreakpoint::Delete().
+            TraceConditionStats();
             _deleted = true;
             return VSConstants.S_OK;
         }
@@ -259,10 +263,14 @@ namespace YetiVSI.DebugEngine
             switch (breakpointCondition.styleCondition)
             {
             case enum_BP_COND_STYLE.BP_COND_NONE:
+                TraceConditionStats();
                 _breakpointLocation.SetCondition("");
+                _condition = null;
                 break;
             case enum_BP_COND_STYLE.BP_COND_WHEN_TRUE:
+                TraceConditionStats();
                 _breakpointLocation.SetCondition(breakpointCondition.bstrCondition);
+                _condition = breakpointCondition.bstrCondition;
                 break;
             default:
                 return VSConstants.E_NOTIMPL;
@@ -325,5 +333,29 @@ namespace YetiVSI.DebugEngine
         }
 
 #endregion IDebugBoundBreakpoint2 functions
+
+        /// <summary>
+        /// Logs how often the current condition was evaluated and how long that took, before
+        /// the condition is replaced or the breakpoint is deleted.
+        /// </summary>
+        void TraceConditionStats()
+        {
+            if (string.IsNullOrEmpty(_condition))
+            {
+                return;
+            }
+
+            BreakpointConditionStats stats = _breakpointLocation.GetConditionStats();
+            if (stats == null || stats.hitCount == 0)
+            {
+                return;
+            }
+
+            Trace.WriteLine(
+                $"Condition '{_condition}' of breakpoint location {GetId()}: " +
+                $"{stats.trueCount} of {stats.hitCount} hits stopped, " +
+                $"average {stats.totalEvaluationNanoseconds / stats.hitCount / 1000} us, " +
+                $"max {stats.maxEvaluationNanoseconds / 1000} us.");
+        }
     }
 }
@@ -178,15 +178,19 @@ namespace YetiVSI.DebugEngine
                 GetFileSystem(), moduleParser, symbolServerHttpClient,
                 new CrashReportClient(GetCloudRunner()),
                 SDKUtil.GetDefaultSymbolCachePath(), SDKUtil.GetDefaultSymbolStorePath(),
-                YetiConstants.SymbolServerExcludeList);
+                YetiConstants.SymbolServerExcludeList,
+                BuildIdIndex.Open(GetFileSystem(), SDKUtil.GetBuildIdIndexPath()),
+                YetiConstants.DefaultSymbolCacheMaxSize);
             IModuleFileFinder moduleFileFinder = new ModuleFileFinder(symbolPathParser);
             IModuleFileLoaderFactory moduleFileLoaderFactory = new ModuleFileLoader.Factory();
 
             var moduleFileLoadRecorderFactory =
                 new ModuleFileLoadMetricsRecorder.Factory(moduleFileFinder);
 
-            var symbolLoaderFactory =
-                new SymbolLoader.Factory(moduleParser, moduleFileFinder);
+            var symbolLoaderFactory = new SymbolLoader.Factory(
+                moduleParser, moduleFileFinder,
+                new DecompressedSymbolFileCache(SDKUtil.GetDecompressedSymbolFileCachePath(),
+                                                YetiConstants.DecompressedSymbolFileCacheMaxSize));
             var binaryLoaderFactory = new BinaryLoader.Factory(moduleFileFinder);
 
             var cancelableTaskFactory = GetCancelableTaskFactory();
@@ -23,6 +23,15 @@
         ENABLED,
     }
 
+    /// <summary>
+    /// Indicates if SSH compresses the port forwarding tunnel to lldb-server.
+    /// </summary>
+    public enum TunnelCompression
+    {
+        DISABLED,
+        ENABLED,
+    }
+
     /// <summary>
     /// Strategy used for expression evaluation, whether lldb-eval is preferred over LLDB
     /// (including the fallback option).
@@ -99,26 +99,47 @@ namespace YetiVSI.DebugEngine
         public int GetInfo(enum_MODULE_INFO_FIELDS fields, MODULE_INFO[] moduleInfo)
         {
             var info = new MODULE_INFO();
-            SbFileSpec platformFileSpec = _lldbModule.GetPlatformFileSpec();
-            if (platformFileSpec != null)
+            // Set when the Modules window refreshes, so the fields below don't need a call each.
+            ModuleSnapshot snapshot = _program.TakeModuleSnapshot(_lldbModule);
+            string name = null;
+            string url = null;
+            if (snapshot != null)
+            {
+                if (!string.IsNullOrEmpty(snapshot.platformPath))
+                {
+                    url = snapshot.platformPath;
+                    name = url.Substring(url.LastIndexOfAny(new[] { '/', '\\' }) + 1);
+                }
+            }
+            else
+            {
+                SbFileSpec platformFileSpec = _lldbModule.GetPlatformFileSpec();
+                if (platformFileSpec != null)
+                {
+                    name = platformFileSpec.GetFilename();
+                    // The module paths are for remote files (on Linux) when attaching to a
+                    // game, and for local paths for the postmortem debugging.
+                    string directory = platformFileSpec.GetDirectory();
+                    url = directory.Contains(@"\")
+                        ? Path.Combine(directory, name)
+                        : FileUtil.PathCombineLinux(directory, name);
+                }
+            }
+            bool hasSymbolsLoaded = snapshot?.hasCompileUnits ?? _lldbModule.HasSymbolsLoaded();
+
+            if (name != null)
             {
                 // Name
                 if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_NAME))
                 {
-                    info.m_bstrName = platformFileSpec.GetFilename();
+                    info.m_bstrName = name;
                     info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_NAME;
                 }
 
                 // Path
                 if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_URL))
                 {
-                    // The module paths are for remote files (on Linux) when attaching to a game,
-                    // and for local paths for the postmortem debugging.
-                    string directory = platformFileSpec.GetDirectory();
-                    string filename = platformFileSpec.GetFilename();
-                    info.m_bstrUrl = directory.Contains(@"\")
-                        ? Path.Combine(directory, filename)
-                        : FileUtil.PathCombineLinux(directory, filename);
+                    info.m_bstrUrl = url;
                     info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_URL;
                 }
             }
@@ -126,7 +147,7 @@ namespace YetiVSI.DebugEngine
             // SymbolStatus
             if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_DEBUGMESSAGE))
             {
-                if (!_lldbModule.HasSymbolsLoaded())
+                if (!hasSymbolsLoaded)
                 {
                     info.m_bstrDebugMessage =
                         "Symbols not loaded. Check 'Symbol Load Information...' for details.";
@@ -137,7 +158,8 @@ namespace YetiVSI.DebugEngine
             // Address (range start)
             if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_LOADADDRESS))
             {
-                info.m_addrLoadAddress = _lldbModule.GetCodeLoadAddress();
+                info.m_addrLoadAddress =
+                    snapshot?.codeLoadAddress ?? _lldbModule.GetCodeLoadAddress();
                 info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_LOADADDRESS;
             }
 
@@ -149,14 +171,15 @@ namespace YetiVSI.DebugEngine
                 // address from the library / executable seems nontrivial.
                 // If m_addrLoadAddress is a different value, VS will show a warning on the icons
                 // in the Modules window.
-                info.m_addrPreferredLoadAddress = _lldbModule.GetCodeLoadAddress();
+                info.m_addrPreferredLoadAddress =
+                    snapshot?.codeLoadAddress ?? _lldbModule.GetCodeLoadAddress();
                 info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_PREFFEREDADDRESS;
             }
 
             // is used to calculate address's range end
             if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_SIZE))
             {
-                info.m_dwSize = (uint)_lldbModule.GetCodeSize();
+                info.m_dwSize = (uint)(snapshot?.codeSize ?? _lldbModule.GetCodeSize());
                 info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_SIZE;
             }
 
@@ -170,23 +193,37 @@ namespace YetiVSI.DebugEngine
             // SymbolFile
             if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_URLSYMBOLLOCATION))
             {
-                SbFileSpec symbolFileSpec = _lldbModule.GetSymbolFileSpec();
-                if (symbolFileSpec != null)
+                if (snapshot != null)
+                {
+                    if (!string.IsNullOrEmpty(snapshot.symbolPath))
+                    {
+                        info.m_bstrUrlSymbolLocation = snapshot.symbolPath;
+                        info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_URLSYMBOLLOCATION;
+                    }
+                }
+                else
                 {
-                    info.m_bstrUrlSymbolLocation = Path.Combine(
-                        symbolFileSpec.GetDirectory(), symbolFileSpec.GetFilename());
-                    info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_URLSYMBOLLOCATION;
+                    SbFileSpec symbolFileSpec = _lldbModule.GetSymbolFileSpec();
+                    if (symbolFileSpec != null)
+                    {
+                        info.m_bstrUrlSymbolLocation = Path.Combine(
+                            symbolFileSpec.GetDirectory(), symbolFileSpec.GetFilename());
+                        info.dwValidFields |= enum_MODULE_INFO_FIELDS.MIF_URLSYMBOLLOCATION;
+                    }
                 }
             }
 
             if (HasFlag(enum_MODULE_INFO_FIELDS.MIF_FLAGS))
             {
-                if (_lldbModule.HasSymbolsLoaded())
+                if (hasSymbolsLoaded)
                 {
                     info.m_dwModuleFlags |= enum_MODULE_FLAGS.MODULE_FLAG_SYMBOLS;
                 }
 
-                if (_lldbModule.Is64Bit())
+                bool is64Bit = snapshot != null
+                    ? snapshot.triple.StartsWith("x86_64-") || snapshot.triple == "x86_64"
+                    : _lldbModule.Is64Bit();
+                if (is64Bit)
                 {
                     info.m_dwModuleFlags |= enum_MODULE_FLAGS.MODULE_FLAG_64BIT;
                 }
@@ -238,6 +275,8 @@ namespace YetiVSI.DebugEngine
         public int LoadSymbols()
         {
             IAction action = _actionRecorder.CreateToolAction(ActionType.DebugModuleLoadSymbols);
+            // The symbol status of the last EnumModules() is about to change.
+            _program.TakeModuleSnapshot(_lldbModule);
 
             ICancelableTask<LoadModuleFilesResult> loadSymbolsTask = _cancelableTaskFactory.Create(
                 "Loading symbols...",
@@ -50,6 +50,12 @@ namespace YetiVSI.DebugEngine
         /// Update the list of bound breakpoints.
         /// </summary>
         void UpdateLocations();
+
+        /// <summary>
+        /// Completes a bind that was deferred by IBreakpointManager.TryDeferBind, with the
+        /// breakpoint created for it by RemoteTarget.BreakpointCreateByLocations.
+        /// </summary>
+        void CompleteBind(CreatedBreakpoint createdBreakpoint);
     }
 
     /// <summary>
@@ -167,6 +173,7 @@ namespace YetiVSI.DebugEngine
         DebugBreakpointError _breakpointError;
         bool _enabled;
         bool _deleted;
+        bool _bindDeferred;
 
         DebugPendingBreakpoint(JoinableTaskContext taskContext,
                                DebugBoundBreakpoint.Factory debugBoundBreakpointFactory,
@@ -263,6 +270,11 @@ namespace YetiVSI.DebugEngine
                 return AD7Constants.E_BP_DELETED;
             }
 
+            if (_bindDeferred)
+            {
+                return VSConstants.S_FALSE;
+            }
+
             switch ((enum_BP_LOCATION_TYPE)_requestInfo.bpLocation.bpLocationType)
             {
             case enum_BP_LOCATION_TYPE.BPLT_CODE_FILE_LINE:
@@ -287,8 +299,16 @@ namespace YetiVSI.DebugEngine
                 // Visual Studio uses a zero based index for line numbers, where LLDB uses a one
                 // based index for line numbers.  We need to add one to the line number here to
                 // convert visual studio line numbers to LLDB line numbers.
-                _lldbBreakpoint =
-                    _target.BreakpointCreateByLocation(fileName, startPosition[0].dwLine + 1);
+                uint line = startPosition[0].dwLine + 1;
+                // While the breakpoints are restored on attach, they are created together once
+                // all of them are known, see CompleteBind.
+                if (_breakpointManager.TryDeferBind(Self, fileName, line))
+                {
+                    _bindDeferred = true;
+                    return VSConstants.S_FALSE;
+                }
+
+                _lldbBreakpoint = _target.BreakpointCreateByLocation(fileName, line);
                 break;
             case enum_BP_LOCATION_TYPE.BPLT_CODE_FUNC_OFFSET:
                 IDebugFunctionPosition2 functionPosition =
@@ -384,9 +404,32 @@ namespace YetiVSI.DebugEngine
                 : VSConstants.S_OK;
         }
 
+        public void CompleteBind(CreatedBreakpoint createdBreakpoint)
+        {
+            _bindDeferred = false;
+            if (_deleted)
+            {
+                if (createdBreakpoint.breakpoint != null)
+                {
+                    _target.BreakpointDelete(createdBreakpoint.breakpoint.GetId());
+                }
+                return;
+            }
+
+            _lldbBreakpoint = createdBreakpoint.breakpoint;
+            if (_lldbBreakpoint == null)
+            {
+                SetError(enum_BP_ERROR_TYPE.BPET_GENERAL_WARNING, _breakpointNotSet);
+                return;
+            }
+
+            UpdateLocations(createdBreakpoint.locations);
+            _breakpointManager.RegisterPendingBreakpoint(Self);
+        }
+
         public void UpdateLocations()
         {
-            var remoteLocations = new Dictionary<int, SbBreakpointLocation>();
+            var locations = new List<SbBreakpointLocation>();
             uint lldbBreakpointLocationNum = _lldbBreakpoint.GetNumLocations();
             for (uint i = 0; i < lldbBreakpointLocationNum; i++)
             {
@@ -397,6 +440,16 @@ namespace YetiVSI.DebugEngine
                     continue;
                 }
 
+                locations.Add(breakpointLocation);
+            }
+            UpdateLocations(locations);
+        }
+
+        void UpdateLocations(IEnumerable<SbBreakpointLocation> locations)
+        {
+            var remoteLocations = new Dictionary<int, SbBreakpointLocation>();
+            foreach (SbBreakpointLocation breakpointLocation in locations)
+            {
                 remoteLocations.Add(breakpointLocation.GetId(), breakpointLocation);
             }
 
@@ -481,17 +534,18 @@ namespace YetiVSI.DebugEngine
             }
 
             _deleted = true;
+            // Bound breakpoints are deleted first, while their locations still exist.
+            foreach (IBoundBreakpoint boundBreakpoint in _boundBreakpoints.Values)
+            {
+                boundBreakpoint.Delete();
+            }
+            _boundBreakpoints.Clear();
             if (_lldbBreakpoint != null)
             {
                 _breakpointManager.RemovePendingBreakpoint(Self);
                 _target.BreakpointDelete(_lldbBreakpoint.GetId());
                 _lldbBreakpoint = null;
             }
-            foreach (IBoundBreakpoint boundBreakpoint in _boundBreakpoints.Values)
-            {
-                boundBreakpoint.Delete();
-            }
-            _boundBreakpoints.Clear();
             return VSConstants.S_OK;
         }
 
@@ -51,6 +51,13 @@ namespace YetiVSI.DebugEngine
         /// Returns remote target for the current program.
         /// </summary>
         RemoteTarget Target { get; }
+
+        /// <summary>
+        /// Returns the info the last EnumModules() fetched for |lldbModule| and forgets it, or
+        /// null if there is none. It is only used once, since the module's symbols may be
+        /// loaded afterwards.
+        /// </summary>
+        ModuleSnapshot TakeModuleSnapshot(SbModule lldbModule);
     }
 
     public interface IDebugProgramFactory
@@ -125,6 +132,10 @@ namespace YetiVSI.DebugEngine
         readonly DebugCodeContext.Factory _codeContextFactory;
         readonly IDebugModuleCache _debugModuleCache;
 
+        // Module info fetched with one call by the last EnumModules(), see TakeModuleSnapshot.
+        readonly Dictionary<SbModule, ModuleSnapshot> _moduleSnapshots =
+            new Dictionary<SbModule, ModuleSnapshot>(SbModuleEqualityComparer.Instance);
+
         readonly ThreadEnumFactory _threadEnumFactory;
         readonly ModuleEnumFactory _moduleEnumFactory;
         readonly CodeContextEnumFactory _codeContextEnumFactory;
@@ -192,6 +203,19 @@ namespace YetiVSI.DebugEngine
 
         public bool DetachRequested { get; private set; }
 
+        public ModuleSnapshot TakeModuleSnapshot(SbModule lldbModule)
+        {
+            lock (_moduleSnapshots)
+            {
+                if (!_moduleSnapshots.TryGetValue(lldbModule, out ModuleSnapshot snapshot))
+                {
+                    return null;
+                }
+                _moduleSnapshots.Remove(lldbModule);
+                return snapshot;
+            }
+        }
+
         #endregion
 
         #region IDebugProgram3 functions
@@ -312,7 +336,29 @@ namespace YetiVSI.DebugEngine
 
         public int EnumModules(out IEnumDebugModules2 modulesEnum)
         {
-            var sbModules = GetSbModules();
+            // The Modules window calls GetInfo() on every module after this. Fetch what it
+            // shows for all modules at once instead of several calls per module.
+            List<ModuleSnapshot> snapshots = _lldbTarget.GetModuleSnapshot();
+            List<SbModule> sbModules;
+            if (snapshots != null)
+            {
+                snapshots = snapshots.Where(s => s.module != null).ToList();
+                sbModules = snapshots.Select(s => s.module).ToList();
+            }
+            else
+            {
+                snapshots = new List<ModuleSnapshot>();
+                sbModules = GetSbModules();
+            }
+            lock (_moduleSnapshots)
+            {
+                _moduleSnapshots.Clear();
+                foreach (ModuleSnapshot snapshot in snapshots)
+                {
+                    _moduleSnapshots[snapshot.module] = snapshot;
+                }
+            }
+
             _debugModuleCache.RemoveAllExcept(sbModules);
             var modules = sbModules.Select(m => _debugModuleCache.GetOrCreate(m, Self));
             modulesEnum = _moduleEnumFactory.Create(modules);
@@ -483,7 +529,10 @@ namespace YetiVSI.DebugEngine
 
         public int WriteDump(enum_DUMPTYPE dumpType, string dumpUrl)
         {
-            _lldbProcess.SaveCore(dumpUrl, out SbError error);
+            SaveCoreStyle style = dumpType == enum_DUMPTYPE.DUMP_FULLDUMP
+                ? SaveCoreStyle.Full
+                : SaveCoreStyle.StackOnly;
+            _lldbProcess.SaveCore(dumpUrl, style, null, out SbError error);
             if (error.Fail())
             {
                 string errorMessage = error.GetCString();
@@ -596,20 +645,18 @@ namespace YetiVSI.DebugEngine
         {
             var context = (IGgpDebugCodeContext)startMemoryContext;
 
-            ulong bytesWritten = _lldbProcess.WriteMemory(
-                context.Address, buffer, count, out SbError error);
+            // Goes through the batched write, which reports one error per write. A partial
+            // write is reported as an error.
+            byte[] bytes = count == buffer.Length ? buffer : buffer.Take((int)count).ToArray();
+            SbError error = _lldbProcess
+                .WriteMemory(new List<MemoryWrite> { new MemoryWrite(context.Address, bytes) })
+                .Single();
 
             if (error.Fail())
             {
                 Trace.WriteLine($"Error: {error.GetCString()}");
                 return VSConstants.E_FAIL;
             }
-            if (bytesWritten != count)
-            {
-                Trace.WriteLine(
-                    $"Warning: WriteMemory failed: wrote {bytesWritten} out of {count} bytes.");
-                return VSConstants.S_FALSE;
-            }
             return VSConstants.S_OK;
         }
 
@@ -232,11 +232,14 @@ namespace YetiVSI.DebugEngine
             stadiaDebugger.Debugger.SetSelectedPlatform(lldbPlatform);
 
             var lldbListener = CreateListener(grpcConnection);
-            // This is required to catch breakpoint change events.
+            // This is required to catch breakpoint change events. Symbols loaded events let
+            // the worker refresh its per-module caches once SymbolLoader adds symbols to a
+            // module that has already been loaded.
             stadiaDebugger.Target.AddListener(lldbListener,
                                               TargetEventType.BREAKPOINT_CHANGED |
                                               TargetEventType.MODULES_LOADED |
-                                              TargetEventType.MODULES_UNLOADED);
+                                              TargetEventType.MODULES_UNLOADED |
+                                              TargetEventType.SYMBOLS_LOADED);
             var listenerSubscriber = new LldbListenerSubscriber(lldbListener);
             LldbFileUpdateListener fileUpdateListener =
                 new LldbFileUpdateListener(listenerSubscriber, task);
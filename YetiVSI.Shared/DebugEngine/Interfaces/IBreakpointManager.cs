@@ -57,6 +57,12 @@ namespace YetiVSI.DebugEngine.Interfaces
         /// <returns>The number of objects which still use the watchpoint.</returns>
         int GetWatchpointRefCount(IWatchpoint watchpoint);
 
+        /// <summary>
+        /// Returns true if a registered watchpoint is implemented with page protection, i.e.
+        /// stops of the process may be caused by it.
+        /// </summary>
+        bool HasPageWatchpoints();
+
         /// <summary>
         /// Look up a registered breakpoint by its ID.
         /// </summary>
@@ -101,5 +107,28 @@ namespace YetiVSI.DebugEngine.Interfaces
             IPendingBreakpoint breakpoint,
             IEnumerable<IDebugBoundBreakpoint2> newlyBoundBreakpoints,
             BoundBreakpointEnumFactory breakpointBoundEnumFactory);
+
+        /// <summary>
+        /// Starts deferring the binding of file and line breakpoints until EndBatchBind is
+        /// called. Used while Visual Studio restores the breakpoints on attach, so that they
+        /// are created with a single call.
+        /// </summary>
+        /// <param name="target">Target to create the deferred breakpoints in.</param>
+        void BeginBatchBind(RemoteTarget target);
+
+        /// <summary>
+        /// Creates the breakpoints deferred since BeginBatchBind with a single call to
+        /// RemoteTarget.BreakpointCreateByLocations and completes their binding. Does nothing
+        /// if no batch is in progress.
+        /// </summary>
+        void EndBatchBind();
+
+        /// <summary>
+        /// Defers the binding of |breakpoint| at |file|:|line| if a batch is in progress.
+        /// </summary>
+        /// <returns>
+        /// False if no batch is in progress, in which case the caller binds the breakpoint.
+        /// </returns>
+        bool TryDeferBind(IPendingBreakpoint breakpoint, string file, uint line);
     }
 }
@@ -211,7 +211,7 @@ namespace YetiVSI.DebugEngine
                 var debugEngineHandler = _debugEngineHandlerFactory.Create(debugEngine, callback);
 
                 var binaryLoader = _binaryLoaderFactory.Create(target);
-                var symbolLoader = _symbolLoaderFactory.Create(commandInterpreter);
+                var symbolLoader = _symbolLoaderFactory.Create(commandInterpreter, target);
                 var moduleFileLoader = _moduleFileLoaderFactory.Create(symbolLoader, binaryLoader,
                                                                        isCoreAttach,
                                                                        moduleSearchLogHolder);
@@ -310,6 +310,9 @@ namespace YetiVSI.DebugEngine
         public void Start(IDebugEngine2 debugEngine)
         {
             _listenerSubscriber.BreakpointChanged += OnBreakpointChanged;
+            // Visual Studio restores the saved breakpoints in response to ProgramCreateEvent.
+            // Collect them and create them together before the process continues.
+            _breakpointManager.BeginBatchBind(_target);
             // The order of these two events is important!! Visual studio always needs to know that
             // the engine has been created before the program is created.
             _debugEngineHandler.SendEvent(new EngineCreateEvent(debugEngine), _debugProgram);
@@ -339,6 +342,7 @@ namespace YetiVSI.DebugEngine
         /// </summary>
         public void ContinueFromSuspended()
         {
+            _breakpointManager.EndBatchBind();
             _eventManager.StartListener();
             _process.Continue();
             _lldbShell.AddDebugger(_debugger);
@@ -350,6 +354,7 @@ namespace YetiVSI.DebugEngine
         /// </summary>
         public void ContinueInBreakMode()
         {
+            _breakpointManager.EndBatchBind();
             RemoteThread thread = _process.GetSelectedThread();
             ExceptionEvent exceptionEvent;
             if (thread.GetStopReason() == StopReason.SIGNAL && thread.GetStopReasonDataCount() > 0)
@@ -401,12 +406,33 @@ namespace YetiVSI.DebugEngine
             SymbolInclusionSettings symbolsSettings, bool isStadiaSymbolsServerUsed,
             ICancelable task, IModuleFileLoadMetricsRecorder moduleFileLoadRecorder)
         {
+            List<SbModule> modules = Enumerable.Range(0, NumLoadedModules)
+                .Select(_target.GetModuleAtIndex).Where(m => m != null).ToList();
             return _moduleFileLoader.LoadModuleFilesAsync(
-                Enumerable.Range(0, NumLoadedModules).Select(_target.GetModuleAtIndex)
-                    .Where(m => m != null).ToList(), symbolsSettings, isStadiaSymbolsServerUsed,
+                PrioritizeStoppedModules(modules), symbolsSettings, isStadiaSymbolsServerUsed,
                 task, moduleFileLoadRecorder);
         }
 
+        /// <summary>
+        /// Moves the modules that contain the PC of a thread to the front. Modules are loaded
+        /// in list order, so the top frames of the call stacks get symbols first.
+        /// </summary>
+        List<SbModule> PrioritizeStoppedModules(List<SbModule> modules)
+        {
+            var stoppedModules = new HashSet<SbModule>(SbModuleEqualityComparer.Instance);
+            int numThreads = _process.GetNumThreads();
+            for (int i = 0; i < numThreads; i++)
+            {
+                SbModule module = _process.GetThreadAtIndex(i)?.GetFrameAtIndex(0)?.GetModule();
+                if (module != null)
+                {
+                    stoppedModules.Add(module);
+                }
+            }
+
+            return modules.OrderBy(m => stoppedModules.Contains(m) ? 0 : 1).ToList();
+        }
+
         public IList<IDebugModule3> GetModulesByName(string moduleName)
         {
             return Enumerable.Range(0, NumLoadedModules)
@@ -64,6 +64,16 @@ namespace YetiVSI.DebugEngine
             new Dictionary<int, IWatchpoint>();
         Dictionary<int, int> watchpointsCount = new Dictionary<int, int>();
 
+        // Watchpoints that are too large for the debug registers get IDs starting here, see
+        // PageWatchpoint.h in the LLDB worker.
+        const int PageWatchpointIdBase = 0x40000000;
+        int pageWatchpointCount;
+
+        // The target and the deferred binds of the batch in progress, see BeginBatchBind.
+        RemoteTarget batchTarget;
+        List<IPendingBreakpoint> deferredBreakpoints = new List<IPendingBreakpoint>();
+        List<SourceLine> deferredLocations = new List<SourceLine>();
+
         private LldbBreakpointManager(
             JoinableTaskContext taskContext,
             DebugPendingBreakpoint.Factory pendingBreakpointFactory,
@@ -122,6 +132,10 @@ namespace YetiVSI.DebugEngine
                 int currentCount;
                 watchpointsCount.TryGetValue(id, out currentCount);
                 watchpointsCount[id] = currentCount + 1;
+                if (currentCount == 0 && id >= PageWatchpointIdBase)
+                {
+                    pageWatchpointCount++;
+                }
             }
             else
             {
@@ -146,6 +160,10 @@ namespace YetiVSI.DebugEngine
                 {
                     watchpointsCount.Remove(id);
                     watchpoints.Remove(id);
+                    if (id >= PageWatchpointIdBase)
+                    {
+                        pageWatchpointCount--;
+                    }
                 }
             }
             else
@@ -166,6 +184,8 @@ namespace YetiVSI.DebugEngine
             return currentCount;
         }
 
+        public bool HasPageWatchpoints() => pageWatchpointCount > 0;
+
         public void ReportBreakpointError(DebugBreakpointError error)
             => debugEngineHandler.OnBreakpointError(error, debugProgram);
 
@@ -215,5 +235,48 @@ namespace YetiVSI.DebugEngine
                     breakpointBoundEnumFactory, debugProgram);
             }
         }
+
+        public void BeginBatchBind(RemoteTarget target)
+        {
+            batchTarget = target;
+        }
+
+        public void EndBatchBind()
+        {
+            if (batchTarget == null)
+            {
+                return;
+            }
+
+            RemoteTarget target = batchTarget;
+            List<IPendingBreakpoint> breakpoints = deferredBreakpoints;
+            List<SourceLine> locations = deferredLocations;
+            batchTarget = null;
+            deferredBreakpoints = new List<IPendingBreakpoint>();
+            deferredLocations = new List<SourceLine>();
+            if (breakpoints.Count == 0)
+            {
+                return;
+            }
+
+            List<CreatedBreakpoint> createdBreakpoints =
+                target.BreakpointCreateByLocations(locations);
+            for (int i = 0; i < breakpoints.Count; i++)
+            {
+                breakpoints[i].CompleteBind(createdBreakpoints[i]);
+            }
+        }
+
+        public bool TryDeferBind(IPendingBreakpoint breakpoint, string file, uint line)
+        {
+            if (batchTarget == null)
+            {
+                return false;
+            }
+
+            deferredBreakpoints.Add(breakpoint);
+            deferredLocations.Add(new SourceLine(file, line));
+            return true;
+        }
     }
 }
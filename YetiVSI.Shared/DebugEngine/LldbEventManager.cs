@@ -161,11 +161,29 @@ namespace YetiVSI.DebugEngine
                         break;
                     }
 
+                    // Watchpoints that are too large for the debug registers stop the process
+                    // with SIGSEGVs, which must not be reported. Only ask the worker when such a
+                    // watchpoint exists, so other stops don't pay for the extra call.
+                    var pageWatchpointResult = PageWatchpointStopResult.NotHandled;
+                    int pageWatchpointId = -1;
+                    if (_lldbBreakpointManager.HasPageWatchpoints())
+                    {
+                        pageWatchpointResult =
+                            _lldbProcess.HandlePageWatchpointStop(out pageWatchpointId);
+                    }
+                    if (pageWatchpointResult == PageWatchpointStopResult.Resumed)
+                    {
+                        break;
+                    }
+
                     var currentThread = _lldbProcess.GetSelectedThread();
                     var currentStopReason = StopReason.INVALID;
                     if (currentThread != null)
                     {
-                        currentStopReason = currentThread.GetStopReason();
+                        currentStopReason =
+                            pageWatchpointResult == PageWatchpointStopResult.Hit
+                                ? StopReason.WATCHPOINT
+                                : currentThread.GetStopReason();
                     }
 
                     // When stopping pick the most relevant thread based on the stop reason.
@@ -270,7 +288,10 @@ namespace YetiVSI.DebugEngine
                             eventToSend = HandleBreakpointStop(currentThread);
                             break;
                         case StopReason.WATCHPOINT:
-                            eventToSend = HandleWatchpointStop(currentThread);
+                            eventToSend = HandleWatchpointStop(
+                                pageWatchpointResult == PageWatchpointStopResult.Hit
+                                    ? pageWatchpointId
+                                    : (int)currentThread.GetStopReasonDataAtIndex(0));
                             break;
                         case StopReason.SIGNAL:
                             eventToSend = HandleSignalStop(currentThread);
@@ -364,9 +385,8 @@ namespace YetiVSI.DebugEngine
         /// <summary>
         /// Handle a watchpoint stop event.
         /// </summary>
-        IGgpDebugEvent HandleWatchpointStop(RemoteThread thread)
+        IGgpDebugEvent HandleWatchpointStop(int id)
         {
-            int id = (int)thread.GetStopReasonDataAtIndex(0);
             if (!_lldbBreakpointManager.GetWatchpointById(id, out IWatchpoint watchpoint))
             {
                 return null;
@@ -18,11 +18,13 @@ using System.Diagnostics;
 using System.IO;
 using System.Linq;
 using System.Text.RegularExpressions;
+using System.Threading;
 using System.Threading.Tasks;
 using DebuggerApi;
 using JetBrains.Annotations;
 using Metrics.Shared;
 using Microsoft.VisualStudio;
+using YetiCommon.Logging;
 
 namespace YetiVSI.DebugEngine
 {
@@ -143,6 +145,25 @@ namespace YetiVSI.DebugEngine
                                      moduleSearchLogHolder);
         }
 
+        class ModuleLoadResult
+        {
+            public SbModule Module { get; }
+            public bool Ok { get; }
+            public string SearchLog { get; }
+
+            public ModuleLoadResult(SbModule module, bool ok, string searchLog)
+            {
+                Module = module;
+                Ok = ok;
+                SearchLog = searchLog;
+            }
+        }
+
+        // Binaries or symbol files loaded at the same time. Loads spend much of their time
+        // waiting on symbol stores and on LLDB parsing and indexing symbol files, so this is a
+        // bit above the core count.
+        static readonly int _maxConcurrentLoads = Environment.ProcessorCount * 2;
+
         readonly ISymbolLoader _symbolLoader;
         readonly IBinaryLoader _binaryLoader;
         readonly bool _isCoreAttach;
@@ -345,37 +366,49 @@ namespace YetiVSI.DebugEngine
             DeveloperLogEvent.Types.LoadSymbolData loadSymbolData,
             LoadModuleFilesResult result)
         {
+            bool[] hasBinary = preFilteredModules.Select(m => m.HasBinaryLoaded()).ToArray();
+            List<SbModule> placeholders =
+                preFilteredModules.Where((m, index) => !hasBinary[index]).ToList();
+
+            // Each replaced module is published through LldbModuleReplaced as soon as it is
+            // loaded. The results are merged in module order afterwards.
+            ModuleLoadResult[] loads = await LoadConcurrentlyAsync(
+                placeholders, async (sbModule, index) =>
+                {
+                    task.ThrowIfCancellationRequested();
+                    string name = sbModule.GetPlatformFileSpec().GetFilename();
+                    task.Progress.Report(
+                        $"Loading binary for {name} ({index}/{placeholders.Count})");
+                    TextWriter searchLog = new StringWriter();
+                    (SbModule outputModule, bool ok) =
+                        await _binaryLoader.LoadBinaryAsync(sbModule, searchLog, forceLoad);
+                    return new ModuleLoadResult(outputModule, ok, searchLog.ToString());
+                });
+
             var modulesWithBinary = new List<SbModule>();
-            for (int index = 0; index < preFilteredModules.Count; index++)
+            for (int index = 0, loadIndex = 0; index < preFilteredModules.Count; index++)
             {
-                SbModule sbModule = preFilteredModules[index];
-                if (sbModule.HasBinaryLoaded())
+                if (hasBinary[index])
                 {
-                    modulesWithBinary.Add(sbModule);
+                    modulesWithBinary.Add(preFilteredModules[index]);
                     continue;
                 }
 
-                string name = sbModule.GetPlatformFileSpec().GetFilename();
-                TextWriter searchLog = new StringWriter();
-
-                task.ThrowIfCancellationRequested();
-                task.Progress.Report($"Loading binary for {name} " +
-                                     $"({index}/{preFilteredModules.Count})");
-                (SbModule outputModule, bool ok) =
-                    await _binaryLoader.LoadBinaryAsync(sbModule, searchLog, forceLoad);
-                if (ok)
+                ModuleLoadResult load = loads[loadIndex++];
+                if (load.Ok)
                 {
-                    modulesWithBinary.Add(outputModule);
+                    modulesWithBinary.Add(load.Module);
                     loadSymbolData.BinariesLoadedAfterCount++;
                 }
                 else
                 {
+                    string name = preFilteredModules[index].GetPlatformFileSpec().GetFilename();
                     result.ResultCode = VSConstants.E_FAIL;
                     result.SuggestToEnableSymbolStore |=
                         ShouldAskToEnableSymbolStores(name, isStadiaSymbolsServerUsed);
                 }
 
-                _moduleSearchLogHolder.AppendSearchLog(outputModule, searchLog.ToString());
+                _moduleSearchLogHolder.AppendSearchLog(load.Module, load.SearchLog);
             }
 
             return modulesWithBinary;
@@ -384,7 +417,7 @@ namespace YetiVSI.DebugEngine
         /// <summary>
         /// Attempts to load symbols for all modules that don't have them loaded yet (it
         /// includes searching for a separate symbol file locally and in the enabled symbol
-        /// stores).
+        /// stores). The time each module took is written to its search log.
         /// </summary>
         /// <remarks>
         /// Updates <c>loadSymbolData</c>'s ModulesWithSymbolsLoadedAfterCount property and
@@ -394,21 +427,28 @@ namespace YetiVSI.DebugEngine
             IReadOnlyList<SbModule> modulesWithBinariesLoaded, ICancelable task, bool forceLoad,
             DeveloperLogEvent.Types.LoadSymbolData loadSymbolData, LoadModuleFilesResult result)
         {
-            for (int index = 0; index < modulesWithBinariesLoaded.Count; index++)
-            {
-                SbModule sbModule = modulesWithBinariesLoaded[index];
-                if (sbModule.HasSymbolsLoaded())
-                {
-                    continue;
-                }
+            List<SbModule> modulesWithoutSymbols =
+                modulesWithBinariesLoaded.Where(m => !m.HasSymbolsLoaded()).ToList();
 
-                string name = sbModule.GetPlatformFileSpec().GetFilename();
-                TextWriter searchLog = new StringWriter();
-                task.ThrowIfCancellationRequested();
-                task.Progress.Report($"Loading symbols for {name} " +
-                                     $"({index}/{modulesWithBinariesLoaded.Count})");
-                bool ok = await _symbolLoader.LoadSymbolsAsync(sbModule, searchLog, forceLoad);
-                if (!ok)
+            ModuleLoadResult[] loads = await LoadConcurrentlyAsync(
+                modulesWithoutSymbols, async (sbModule, index) =>
+                {
+                    task.ThrowIfCancellationRequested();
+                    string name = sbModule.GetPlatformFileSpec().GetFilename();
+                    task.Progress.Report(
+                        $"Loading symbols for {name} ({index}/{modulesWithoutSymbols.Count})");
+                    TextWriter searchLog = new StringWriter();
+                    Stopwatch stopwatch = Stopwatch.StartNew();
+                    bool ok = await _symbolLoader.LoadSymbolsAsync(sbModule, searchLog,
+                                                                   forceLoad);
+                    searchLog.WriteLineAndTrace(
+                        $"Loading symbols for '{name}' took {stopwatch.ElapsedMilliseconds} ms.");
+                    return new ModuleLoadResult(sbModule, ok, searchLog.ToString());
+                });
+
+            foreach (ModuleLoadResult load in loads)
+            {
+                if (!load.Ok)
                 {
                     result.ResultCode = VSConstants.E_FAIL;
                 }
@@ -417,7 +457,41 @@ namespace YetiVSI.DebugEngine
                     loadSymbolData.ModulesWithSymbolsLoadedAfterCount++;
                 }
 
-                _moduleSearchLogHolder.AppendSearchLog(sbModule, searchLog.ToString());
+                _moduleSearchLogHolder.AppendSearchLog(load.Module, load.SearchLog);
+            }
+        }
+
+        /// <summary>
+        /// Runs <c>load</c> for every module on the thread pool, at most
+        /// <c>_maxConcurrentLoads</c> at a time. Loads are started in list order, so modules
+        /// at the front of the list are loaded first.
+        /// </summary>
+        /// <returns>The results in list order.</returns>
+        static async Task<ModuleLoadResult[]> LoadConcurrentlyAsync(
+            IReadOnlyList<SbModule> modules, Func<SbModule, int, Task<ModuleLoadResult>> load)
+        {
+            var loads = new Task<ModuleLoadResult>[modules.Count];
+            using (var throttle = new SemaphoreSlim(_maxConcurrentLoads))
+            {
+                for (int index = 0; index < modules.Count; index++)
+                {
+                    await throttle.WaitAsync();
+                    SbModule sbModule = modules[index];
+                    int moduleIndex = index;
+                    loads[index] = Task.Run(async () =>
+                    {
+                        try
+                        {
+                            return await load(sbModule, moduleIndex);
+                        }
+                        finally
+                        {
+                            throttle.Release();
+                        }
+                    });
+                }
+
+                return await Task.WhenAll(loads);
             }
         }
 
@@ -404,7 +404,8 @@ namespace YetiVSI.DebugEngine.NatvisEngine
                                                       : ".") + vsExpression.Value);
             }
 
-            if (!NatvisTextMatcher.IsExpressionPath(vsExpression.Value))
+            if (!NatvisTextMatcher.IsExpressionPath(vsExpression.Value) ||
+                IsKnownNonMember(variable, vsExpression.Value))
             {
                 return null;
             }
@@ -423,6 +424,36 @@ namespace YetiVSI.DebugEngine.NatvisEngine
             return value;
         }
 
+        /// <summary>
+        /// Returns true if the type layout of the variable shows that the member access
+        /// expression |expressionPath| doesn't start with one of its data members. Saves looking
+        /// up expressions that refer to globals or need to be evaluated. The layout is fetched
+        /// once per type object, so only variables that aren't pointers or references are
+        /// checked.
+        /// </summary>
+        static bool IsKnownNonMember(IVariableInformation variable, string expressionPath)
+        {
+            if (variable.Error || variable.IsPointer || variable.IsReference ||
+                !expressionPath.StartsWith("."))
+            {
+                return false;
+            }
+
+            Match name = _varNameRegex.Match(expressionPath, 1);
+            if (!name.Success || name.Index != 1)
+            {
+                return false;
+            }
+
+            TypeLayout layout = variable.GetAllInheritedTypes().FirstOrDefault()?.GetLayout();
+            if (layout == null || layout.hasVirtualBases)
+            {
+                return false;
+            }
+
+            return !layout.names.Contains(name.Value);
+        }
+
         /// <summary>
         /// Try to evaluate the given expression in the context of the variable.
         /// Imagine the variable is a class and the expression is in a method of that class.
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.Threading.Tasks;
@@ -47,29 +48,48 @@ namespace YetiVSI.DebugEngine
         {
             readonly IModuleFileFinder _moduleFileFinder;
             readonly IModuleParser _moduleParser;
+            readonly IDecompressedSymbolFileCache _decompressedSymbolFileCache;
 
             public Factory(IModuleParser moduleParser,
-                IModuleFileFinder moduleFileFinder)
+                IModuleFileFinder moduleFileFinder,
+                IDecompressedSymbolFileCache decompressedSymbolFileCache)
             {
                 _moduleParser = moduleParser;
                 _moduleFileFinder = moduleFileFinder;
+                _decompressedSymbolFileCache = decompressedSymbolFileCache;
             }
 
-            public virtual ISymbolLoader Create(SbCommandInterpreter lldbCommandInterpreter) =>
+            public virtual ISymbolLoader Create(SbCommandInterpreter lldbCommandInterpreter,
+                                                RemoteTarget lldbTarget) =>
                 new SymbolLoader(_moduleParser, _moduleFileFinder,
-                    lldbCommandInterpreter);
+                    _decompressedSymbolFileCache, lldbCommandInterpreter, lldbTarget);
         }
 
         readonly IModuleParser _moduleParser;
         readonly IModuleFileFinder _moduleFileFinder;
+        readonly IDecompressedSymbolFileCache _decompressedSymbolFileCache;
         readonly SbCommandInterpreter _lldbCommandInterpreter;
+        readonly RemoteTarget _lldbTarget;
+
+        // Directories added to target.debug-file-search-paths for DWARF packages.
+        readonly HashSet<string> _dwarfPackageDirectories = new HashSet<string>();
+
+        // Symbol files are looked up, downloaded and added for several modules at once, but
+        // LLDB's command interpreter is not thread safe. The only command left, `settings
+        // append`, changes the debugger's settings and runs one at a time.
+        readonly object _commandLock = new object();
 
         public SymbolLoader(IModuleParser binaryFileUtil,
-            IModuleFileFinder moduleFileFinder, SbCommandInterpreter lldbCommandInterpreter)
+            IModuleFileFinder moduleFileFinder,
+            IDecompressedSymbolFileCache decompressedSymbolFileCache,
+            SbCommandInterpreter lldbCommandInterpreter,
+            RemoteTarget lldbTarget)
         {
             _moduleParser = binaryFileUtil;
             _moduleFileFinder = moduleFileFinder;
+            _decompressedSymbolFileCache = decompressedSymbolFileCache;
             _lldbCommandInterpreter = lldbCommandInterpreter;
+            _lldbTarget = lldbTarget;
         }
 
         public virtual async Task<bool> LoadSymbolsAsync(SbModule lldbModule, TextWriter searchLog,
@@ -93,7 +113,8 @@ namespace YetiVSI.DebugEngine
             if (symbolPath.TryGetFullPath(out string fullPath) &&
                 ShouldAddSymbolFile(fullPath, buildId, format, searchLog))
             {
-                return AddSymbolFile(fullPath, lldbModule, searchLog);
+                return await AddSymbolFileAsync(fullPath, lldbModule, buildId, format, forceLoad,
+                                                searchLog);
             }
 
             string binaryName = lldbModule.GetFileSpec()?.GetFilename();
@@ -106,7 +127,8 @@ namespace YetiVSI.DebugEngine
             string filepath = await SearchSymbolFileInSymbolStoresAsync(
                 binaryName, searchQuery, searchLog);
             return !(string.IsNullOrWhiteSpace(filepath)) &&
-                AddSymbolFile(filepath, lldbModule, searchLog);
+                await AddSymbolFileAsync(filepath, lldbModule, buildId, format, forceLoad,
+                                         searchLog);
         }
 
         SymbolFileLocation GetSymbolPathFromSbModule(SbModule lldbModule)
@@ -240,38 +262,104 @@ namespace YetiVSI.DebugEngine
         }
 
         /// <summary>
-        /// Call `target symbols add` in Lldb shell to update SbModule's symbol info.
+        /// Prepares an ELF symbol file for LLDB and adds it. LLDB inflates compressed debug
+        /// sections on every load, single-threaded, so files with such sections are replaced
+        /// by a cached copy in which they are decompressed. The DWARF package of a split DWARF
+        /// file is located first, because the worker starts loading the split units as soon
+        /// as the symbol file is added.
         /// </summary>
-        bool AddSymbolFile(string filepath, SbModule module, TextWriter searchLog)
+        async Task<bool> AddSymbolFileAsync(string filepath, SbModule module, BuildId buildId,
+                                            ModuleFormat format, bool forceLoad,
+                                            TextWriter searchLog)
+        {
+            if (format == ModuleFormat.Elf)
+            {
+                filepath = _decompressedSymbolFileCache.GetDecompressedFile(filepath, buildId,
+                                                                            searchLog);
+                await AddDwarfPackageSearchPathAsync(filepath, module, buildId, forceLoad,
+                                                     searchLog);
+            }
+
+            return AddSymbolFile(filepath, module, searchLog);
+        }
+
+        /// <summary>
+        /// LLDB looks for the DWARF package of a module as '<binary>.dwp' in the directories
+        /// of target.debug-file-search-paths. Packages have no build ID of their own, so they
+        /// are searched for in the symbol stores under the build ID of the module. The
+        /// directory of a package that is found is added to the search paths.
+        /// </summary>
+        async Task AddDwarfPackageSearchPathAsync(string symbolFilepath, SbModule module,
+                                                  BuildId buildId, bool forceLoad,
+                                                  TextWriter searchLog)
         {
-            string command = "target symbols add";
+            string binaryName = module.GetFileSpec()?.GetFilename();
+            if (string.IsNullOrWhiteSpace(binaryName) || BuildId.IsNullOrEmpty(buildId) ||
+                !_moduleParser.HasSplitDwarf(symbolFilepath))
+            {
+                return;
+            }
 
-            SbFileSpec platformFileSpec = module.GetPlatformFileSpec();
-            if (platformFileSpec != null)
+            var searchQuery = new ModuleSearchQuery($"{binaryName}.dwp", buildId,
+                                                    ModuleFormat.Elf)
             {
-                string platformPath = FileUtil.PathCombineLinux(platformFileSpec.GetDirectory(),
-                                                                platformFileSpec.GetFilename());
-                // The -s flag specifies the path of the module to add symbols to.
-                command += " -s " + LldbCommandUtil.QuoteArgument(platformPath);
+                SkipBuildIdVerification = true,
+                ForceLoad = forceLoad
+            };
+            string packagePath = await _moduleFileFinder.FindFileAsync(searchQuery, searchLog);
+            if (string.IsNullOrWhiteSpace(packagePath))
+            {
+                return;
             }
 
-            command += " " + LldbCommandUtil.QuoteArgument(filepath);
+            string directory = Path.GetDirectoryName(packagePath);
+            lock (_dwarfPackageDirectories)
+            {
+                if (!_dwarfPackageDirectories.Add(directory))
+                {
+                    return;
+                }
+            }
 
-            _lldbCommandInterpreter.HandleCommand(command,
-                                                  out SbCommandReturnObject commandResult);
+            string command = "settings append target.debug-file-search-paths " +
+                LldbCommandUtil.QuoteArgument(directory);
+            SbCommandReturnObject commandResult = HandleCommand(command);
             Trace.WriteLine($"Executed LLDB command '{command}' with result:" +
                 Environment.NewLine + commandResult.GetDescription());
-
             if (!commandResult.Succeeded())
             {
                 searchLog.WriteLineAndTrace("LLDB error: " + commandResult.GetError());
-                return false;
+                return;
+            }
+
+            searchLog.WriteLineAndTrace($"Using DWARF package '{packagePath}'.");
+        }
+
+        SbCommandReturnObject HandleCommand(string command)
+        {
+            lock (_commandLock)
+            {
+                _lldbCommandInterpreter.HandleCommand(command,
+                                                      out SbCommandReturnObject commandResult);
+                return commandResult;
             }
+        }
 
-            string text = $"LLDB output: {commandResult.GetOutput()}{Environment.NewLine}" +
-                $"Successfully loaded symbol file '{filepath}'.";
-            searchLog.WriteLineAndTrace(text);
+        /// <summary>
+        /// Adds the symbol file to SbModule, like `target symbols add`. This doesn't go through
+        /// the command interpreter, so symbol files of several modules are parsed and indexed
+        /// in parallel.
+        /// </summary>
+        bool AddSymbolFile(string filepath, SbModule module, TextWriter searchLog)
+        {
+            SbError error = _lldbTarget.AddSymbolFile(module, filepath);
+            if (error.Fail())
+            {
+                searchLog.WriteLineAndTrace("LLDB error: " + error.GetCString());
+                return false;
+            }
 
+            searchLog.WriteLineAndTrace($"Successfully loaded symbol file '{filepath}'.");
             return true;
         }
     }
@@ -168,6 +168,14 @@ namespace YetiVSI
         [Description("Disabled")] DISABLED = 2,
     }
 
+    public enum TunnelCompressionFlag
+    {
+        [Description("Default - Disabled")] [EnumValueAlias(DISABLED)]
+        DEFAULT = 0,
+        [Description("Enabled")] ENABLED = 1,
+        [Description("Disabled")] DISABLED = 2,
+    }
+
     public enum ExpressionEvaluationEngineFlag
     {
         [Description("Default - lldb-eval with fallback to LLDB")]
@@ -200,6 +208,7 @@ namespace YetiVSI
         NatvisLoggingLevel NatvisLoggingLevel { get; }
         FastExpressionEvaluation FastExpressionEvaluation { get; }
         ExpressionEvaluationStrategy ExpressionEvaluationStrategy { get; }
+        TunnelCompression TunnelCompression { get; }
         ShowOption SdkCompatibilityWarningOption { get; }
         void AddSdkVersionsToHide(string gameletVersion, string localVersion, string gameletName);
         bool SdkVersionsAreHidden(string gameletVersion, string localVersion, string gameletName);
@@ -330,6 +339,17 @@ namespace YetiVSI
             }
         }
 
+        [Category(LldbDebugger)]
+        [DisplayName("Compress the debugger connection")]
+        [Description("Makes SSH compress the connection between LLDB and the gamelet. " +
+            "lldb-server already compresses large packets, such as module downloads and " +
+            "large memory reads, when it and LLDB are built with zlib. SSH compression also " +
+            "covers small packets, but adds latency to each of them. Takes effect on the next " +
+            "debug session.")]
+        [TypeConverter(typeof(FeatureFlagConverter))]
+        [DefaultValue(TunnelCompressionFlag.DEFAULT)]
+        public TunnelCompressionFlag TunnelCompression { get; set; }
+
         public OptionPageGrid()
         {
             ResetSettings();
@@ -391,6 +411,10 @@ namespace YetiVSI
             EnumValueAliasAttribute.GetAliasOrValue(ExpressionEvaluationEngine)
                 .ConvertTo<ExpressionEvaluationStrategy>();
 
+        TunnelCompression IExtensionOptions.TunnelCompression =>
+            EnumValueAliasAttribute.GetAliasOrValue(TunnelCompression)
+                .ConvertTo<TunnelCompression>();
+
         ShowOption IExtensionOptions.SdkCompatibilityWarningOption =>
             SdkIncompatibilityWarning.ShowOption;
 
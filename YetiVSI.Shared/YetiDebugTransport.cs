@@ -368,7 +368,12 @@ namespace YetiVSI
                     RemotePort = session.TransportSession.GetReservedLocalAndRemotePort(),
                 }
             };
-            var startInfo = ProcessStartInfoBuilder.BuildForSshPortForward(ports, target);
+            // lldb-server compresses large packets itself when LLDB negotiates it. SSH
+            // compression also covers LLDBs that don't, but applies to every small packet.
+            bool compress =
+                _yetiVSIService.Options.TunnelCompression == TunnelCompression.ENABLED;
+            var startInfo =
+                ProcessStartInfoBuilder.BuildForSshPortForward(ports, target, compress);
             return new ProcessStartData("lldb port forwarding", startInfo);
         }
 
@@ -293,6 +293,30 @@ namespace YetiVSI.Test.DebugEngine
             mockBreakpointLocation.Received(1).SetCondition("");
         }
 
+        [Test]
+        public void ConditionStatsReadBeforeConditionIsReplaced()
+        {
+            BP_CONDITION condition;
+            condition.styleCondition = enum_BP_COND_STYLE.BP_COND_WHEN_TRUE;
+            condition.bstrCondition = "i == 1";
+            condition.bstrContext = null;
+            condition.pThread = null;
+            condition.nRadix = 10;
+            boundBreakpoint.SetCondition(condition);
+            mockBreakpointLocation.DidNotReceive().GetConditionStats();
+
+            condition.bstrCondition = "i == 2";
+            boundBreakpoint.SetCondition(condition);
+            Received.InOrder(() =>
+            {
+                mockBreakpointLocation.GetConditionStats();
+                mockBreakpointLocation.SetCondition("i == 2");
+            });
+
+            boundBreakpoint.Delete();
+            mockBreakpointLocation.Received(2).GetConditionStats();
+        }
+
         [Test]
         public void GetPendingBreakpoint()
         {
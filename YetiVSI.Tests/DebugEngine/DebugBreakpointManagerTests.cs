@@ -16,6 +16,7 @@ using DebuggerApi;
 using Microsoft.VisualStudio.Debugger.Interop;
 using NUnit.Framework;
 using NSubstitute;
+using System.Collections.Generic;
 using YetiVSI.DebugEngine;
 using Microsoft.VisualStudio.Threading;
 using YetiVSI.DebugEngine.Interfaces;
@@ -130,6 +131,26 @@ namespace YetiVSI.Test.DebugEngine
             Assert.AreEqual(0, watchpointCount);
         }
 
+        [Test]
+        public void HasPageWatchpoints()
+        {
+            var pageWatchpoint = Substitute.For<IWatchpoint>();
+            pageWatchpoint.GetId().Returns(0x40000000);
+
+            breakpointManager.RegisterWatchpoint(mockWatchpoint);
+            Assert.IsFalse(breakpointManager.HasPageWatchpoints());
+
+            breakpointManager.RegisterWatchpoint(pageWatchpoint);
+            breakpointManager.RegisterWatchpoint(pageWatchpoint);
+            Assert.IsTrue(breakpointManager.HasPageWatchpoints());
+
+            breakpointManager.UnregisterWatchpoint(pageWatchpoint);
+            Assert.IsTrue(breakpointManager.HasPageWatchpoints());
+
+            breakpointManager.UnregisterWatchpoint(pageWatchpoint);
+            Assert.IsFalse(breakpointManager.HasPageWatchpoints());
+        }
+
         [Test]
         public void GetNumPendingBreakpoints()
         {
@@ -155,6 +176,47 @@ namespace YetiVSI.Test.DebugEngine
             Assert.AreEqual(numLocations, breakpointManager.GetNumBoundBreakpoints());
         }
 
+        [Test]
+        public void TryDeferBindWithoutBatch()
+        {
+            Assert.IsFalse(breakpointManager.TryDeferBind(mockPendingBreakpoint, "main.cc", 1));
+            breakpointManager.EndBatchBind();
+            mockTarget.DidNotReceiveWithAnyArgs().BreakpointCreateByLocations(null);
+        }
+
+        [Test]
+        public void BatchBind()
+        {
+            var firstBreakpoint = Substitute.For<IPendingBreakpoint>();
+            var secondBreakpoint = Substitute.For<IPendingBreakpoint>();
+            var firstCreated = new CreatedBreakpoint(Substitute.For<RemoteBreakpoint>(),
+                                                     new List<SbBreakpointLocation>());
+            var secondCreated = new CreatedBreakpoint(null, new List<SbBreakpointLocation>());
+            List<SourceLine> locations = null;
+            mockTarget.BreakpointCreateByLocations(Arg.Do<IList<SourceLine>>(
+                    l => locations = new List<SourceLine>(l)))
+                .Returns(new List<CreatedBreakpoint> { firstCreated, secondCreated });
+
+            breakpointManager.BeginBatchBind(mockTarget);
+            Assert.IsTrue(breakpointManager.TryDeferBind(firstBreakpoint, "main.cc", 10));
+            Assert.IsTrue(breakpointManager.TryDeferBind(secondBreakpoint, "util.cc", 20));
+            mockTarget.DidNotReceiveWithAnyArgs().BreakpointCreateByLocations(null);
+
+            breakpointManager.EndBatchBind();
+
+            mockTarget.ReceivedWithAnyArgs(1).BreakpointCreateByLocations(null);
+            Assert.AreEqual(2, locations.Count);
+            Assert.AreEqual("main.cc", locations[0].file);
+            Assert.AreEqual(10u, locations[0].line);
+            Assert.AreEqual("util.cc", locations[1].file);
+            Assert.AreEqual(20u, locations[1].line);
+            firstBreakpoint.Received(1).CompleteBind(firstCreated);
+            secondBreakpoint.Received(1).CompleteBind(secondCreated);
+
+            // The batch is over, breakpoints are bound directly again.
+            Assert.IsFalse(breakpointManager.TryDeferBind(firstBreakpoint, "main.cc", 10));
+        }
+
         public void RegisterBreakpoints(int count)
         {
             for (int i = 0; i < count; i++)
@@ -112,6 +112,41 @@ namespace YetiVSI.Test.DebugEngine
             });
         }
 
+        [Test]
+        public void GetInfoFromSnapshot()
+        {
+            var snapshot = new ModuleSnapshot(_mockModule, "/platform/dir/platform file",
+                                              "c:\\symbol\\dir\\symbol file", "uuid",
+                                              "x86_64-unknown-linux-gnu", 456, 789, true, true);
+            _mockDebugProgram.TakeModuleSnapshot(_mockModule).Returns(snapshot, null);
+
+            var flags = enum_MODULE_INFO_FIELDS.MIF_NAME | enum_MODULE_INFO_FIELDS.MIF_URL |
+                        enum_MODULE_INFO_FIELDS.MIF_URLSYMBOLLOCATION |
+                        enum_MODULE_INFO_FIELDS.MIF_LOADADDRESS |
+                        enum_MODULE_INFO_FIELDS.MIF_PREFFEREDADDRESS |
+                        enum_MODULE_INFO_FIELDS.MIF_SIZE | enum_MODULE_INFO_FIELDS.MIF_LOADORDER |
+                        enum_MODULE_INFO_FIELDS.MIF_FLAGS;
+            var moduleInfo = new MODULE_INFO[1];
+
+            Assert.Multiple(() =>
+            {
+                Assert.That(_debugModule.GetInfo(flags, moduleInfo), Is.EqualTo(VSConstants.S_OK));
+                Assert.That(moduleInfo[0].dwValidFields, Is.EqualTo(flags));
+                Assert.That(moduleInfo[0].m_bstrName, Is.EqualTo("platform file"));
+                Assert.That(moduleInfo[0].m_bstrUrl, Is.EqualTo("/platform/dir/platform file"));
+                Assert.That(moduleInfo[0].m_bstrUrlSymbolLocation,
+                            Is.EqualTo("c:\\symbol\\dir\\symbol file"));
+                Assert.That(moduleInfo[0].m_addrLoadAddress, Is.EqualTo(456));
+                Assert.That(moduleInfo[0].m_dwSize, Is.EqualTo(789));
+                Assert.That(moduleInfo[0].m_dwModuleFlags,
+                            Is.EqualTo(enum_MODULE_FLAGS.MODULE_FLAG_64BIT |
+                                       enum_MODULE_FLAGS.MODULE_FLAG_SYMBOLS));
+            });
+            _mockModule.DidNotReceive().GetPlatformFileSpec();
+            _mockModule.DidNotReceive().HasCompileUnits();
+            _mockModule.DidNotReceive().GetCodeLoadAddress();
+        }
+
         [Test]
         public void GetSymbolInfo()
         {
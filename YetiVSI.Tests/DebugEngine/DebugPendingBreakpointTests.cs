@@ -211,6 +211,66 @@ namespace YetiVSI.Test.DebugEngine
             Assert.AreEqual(VSConstants.S_OK, result);
         }
 
+        [Test]
+        public void BindLineBreakpointDeferred()
+        {
+            MockDocumentPosition(TEST_FILE_NAME, LINE_NUMBER, COLUMN_NUMBER);
+            mockBreakpointManager.TryDeferBind(pendingBreakpoint, TEST_FILE_NAME, LINE_NUMBER + 1)
+                .Returns(true);
+
+            var result = pendingBreakpoint.Bind();
+
+            mockTarget.DidNotReceiveWithAnyArgs().BreakpointCreateByLocation(null, 0);
+            mockBreakpointManager.DidNotReceiveWithAnyArgs().RegisterPendingBreakpoint(null);
+            Assert.AreEqual(VSConstants.S_FALSE, result);
+
+            // A second bind while the first is deferred doesn't defer the breakpoint again.
+            pendingBreakpoint.Bind();
+            mockBreakpointManager.ReceivedWithAnyArgs(1).TryDeferBind(null, null, 0);
+        }
+
+        [Test]
+        public void CompleteBind()
+        {
+            var breakpointLocations = CreateMockBreakpointLocations(2);
+            MockDocumentPosition(TEST_FILE_NAME, LINE_NUMBER, COLUMN_NUMBER);
+            mockBreakpointManager.TryDeferBind(pendingBreakpoint, TEST_FILE_NAME, LINE_NUMBER + 1)
+                .Returns(true);
+            pendingBreakpoint.Bind();
+
+            pendingBreakpoint.CompleteBind(
+                new CreatedBreakpoint(mockLldbBreakpoint, breakpointLocations));
+
+            // The locations come with the created breakpoint, they are not queried again.
+            mockLldbBreakpoint.DidNotReceiveWithAnyArgs().GetLocationAtIndex(0);
+            Assert.AreEqual(2, GetBoundBreakpoints().Count);
+            Assert.AreEqual(null, GetBreakpointError());
+            mockBreakpointManager.Received().RegisterPendingBreakpoint(pendingBreakpoint);
+        }
+
+        [Test]
+        public void CompleteBindFailed()
+        {
+            pendingBreakpoint.CompleteBind(
+                new CreatedBreakpoint(null, new List<SbBreakpointLocation>()));
+
+            Assert.AreNotEqual(null, GetBreakpointError());
+            mockBreakpointManager.DidNotReceiveWithAnyArgs().RegisterPendingBreakpoint(null);
+        }
+
+        [Test]
+        public void CompleteBindDeleted()
+        {
+            pendingBreakpoint.Delete();
+
+            pendingBreakpoint.CompleteBind(
+                new CreatedBreakpoint(mockLldbBreakpoint, CreateMockBreakpointLocations(1)));
+
+            mockTarget.Received().BreakpointDelete(EXPECTED_ID);
+            Assert.AreEqual(0, GetBoundBreakpoints().Count);
+            mockBreakpointManager.DidNotReceiveWithAnyArgs().RegisterPendingBreakpoint(null);
+        }
+
         [Test]
         public void BindInvalidFile()
         {
@@ -81,6 +81,40 @@ namespace YetiVSI.Test.DebugEngine
                     mockSbProcess, mockRemoteTarget, mockDebugModuleCache, false);
         }
 
+        [Test]
+        public void EnumModulesFetchesSnapshotOnce()
+        {
+            var module = Substitute.For<SbModule>();
+            module.GetId().Returns(1);
+            var snapshot = new ModuleSnapshot(module, "/dir/file", "", "uuid",
+                                              "x86_64-unknown-linux-gnu", 1, 2, true, true);
+            mockRemoteTarget.GetModuleSnapshot().Returns(new List<ModuleSnapshot> {
+                snapshot,
+                new ModuleSnapshot(null, "", "", "", "", 0, 0, false, false),
+            });
+
+            Assert.AreEqual(VSConstants.S_OK, program.EnumModules(out _));
+
+            mockRemoteTarget.DidNotReceive().GetNumModules();
+            mockDebugModuleCache.Received(1).GetOrCreate(module, Arg.Any<IGgpDebugProgram>());
+            Assert.AreSame(snapshot, program.TakeModuleSnapshot(module));
+            Assert.IsNull(program.TakeModuleSnapshot(module));
+        }
+
+        [Test]
+        public void EnumModulesWithoutSnapshot()
+        {
+            var module = Substitute.For<SbModule>();
+            mockRemoteTarget.GetModuleSnapshot().Returns((List<ModuleSnapshot>)null);
+            mockRemoteTarget.GetNumModules().Returns(1);
+            mockRemoteTarget.GetModuleAtIndex(0).Returns(module);
+
+            Assert.AreEqual(VSConstants.S_OK, program.EnumModules(out _));
+
+            mockDebugModuleCache.Received(1).GetOrCreate(module, Arg.Any<IGgpDebugProgram>());
+            Assert.IsNull(program.TakeModuleSnapshot(module));
+        }
+
         [Test]
         public void StepInto()
         {
@@ -322,13 +356,10 @@ namespace YetiVSI.Test.DebugEngine
             var mockMemoryContext = Substitute.For<IGgpDebugCodeContext>();
             mockMemoryContext.Address.Returns(0xdeadbeef);
             byte[] buffer = { 1, 2, 3, 4 };
-            mockSbProcess.WriteMemory(
-                ADDRESS, buffer, SIZE, out SbError error).Returns(
-                x =>
-                {
-                    x[3] = mockError;
-                    return SIZE;
-                });
+            mockSbProcess
+                .WriteMemory(Arg.Is<IList<MemoryWrite>>(
+                    w => w.Count == 1 && w[0].address == ADDRESS && w[0].buffer == buffer))
+                .Returns(new List<SbError> { mockError });
             Assert.AreEqual(VSConstants.S_OK, program.WriteAt(mockMemoryContext, SIZE, buffer));
         }
 
@@ -342,16 +373,27 @@ namespace YetiVSI.Test.DebugEngine
             var mockMemoryContext = Substitute.For<IGgpDebugCodeContext>();
             mockMemoryContext.Address.Returns(0xdeadbeef);
             byte[] buffer = { 1, 2, 3, 4 };
-            mockSbProcess.WriteMemory(
-                ADDRESS, buffer, SIZE, out SbError error).Returns(
-                x =>
-                {
-                    x[3] = mockError;
-                    return 0u;
-                });
+            mockSbProcess.WriteMemory(Arg.Any<IList<MemoryWrite>>())
+                .Returns(new List<SbError> { mockError });
             Assert.AreEqual(VSConstants.E_FAIL, program.WriteAt(mockMemoryContext, SIZE, buffer));
         }
 
+        [Test]
+        public void WriteAtOnlyWritesCount()
+        {
+            const ulong ADDRESS = 0xdeadbeef;
+            var mockError = Substitute.For<SbError>();
+            mockError.Fail().Returns(false);
+            var mockMemoryContext = Substitute.For<IGgpDebugCodeContext>();
+            mockMemoryContext.Address.Returns(ADDRESS);
+            byte[] buffer = { 1, 2, 3, 4 };
+            mockSbProcess
+                .WriteMemory(Arg.Is<IList<MemoryWrite>>(
+                    w => w.Count == 1 && w[0].buffer.Length == 2))
+                .Returns(new List<SbError> { mockError });
+            Assert.AreEqual(VSConstants.S_OK, program.WriteAt(mockMemoryContext, 2, buffer));
+        }
+
         [Test]
         public void GetDisassemblyStream()
         {
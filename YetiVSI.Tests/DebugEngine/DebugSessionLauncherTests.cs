@@ -16,6 +16,7 @@ using System;
 using System.Collections.Generic;
 using System.IO.Abstractions.TestingHelpers;
 using System.Threading.Tasks;
+using DebuggerApi;
 using DebuggerGrpcClient;
 using GgpGrpc.Models;
 using Metrics.Shared;
@@ -140,6 +141,20 @@ namespace YetiVSI.Test.DebugEngine
             attachedProgram.Stop();
         }
 
+        [Test]
+        public async Task TestAttachToGameListensForSymbolsLoadedAsync()
+        {
+            var launcherFactory = CreateLauncherFactory(false);
+            var launcher = launcherFactory.Create(_debugEngine, "", _gameBinary, _gameLaunch);
+            var stadiaDebugger = CreateStadiaLldbDebugger(_gameBinary, false);
+            var attachedProgram =
+                await LaunchAsync(launcher, LaunchOption.AttachToGame, stadiaDebugger);
+            var target = (RemoteTargetStub)stadiaDebugger.Target;
+            Assert.That(target.ListenerEventMask.HasFlag(TargetEventType.SYMBOLS_LOADED));
+            Assert.That(target.ListenerEventMask.HasFlag(TargetEventType.MODULES_LOADED));
+            attachedProgram.Stop();
+        }
+
         [Test]
         public void TestAttachToGameFail_AnotherTracer()
         {
@@ -529,7 +544,8 @@ namespace YetiVSI.Test.DebugEngine
                                                       new DebugWatchpointResolution.Factory(),
                                                       new BreakpointErrorEnumFactory(),
                                                       new BoundBreakpointEnumFactory())),
-                new SymbolLoader.Factory(Substitute.For<IModuleParser>(), moduleFileFinder),
+                new SymbolLoader.Factory(Substitute.For<IModuleParser>(), moduleFileFinder,
+                                         Substitute.For<IDecompressedSymbolFileCache>()),
                 new BinaryLoader.Factory(moduleFileFinder),
                 Substitute.For<IModuleFileLoaderFactory>());
 
@@ -96,6 +96,7 @@ namespace YetiVSI.Test
             };
 
             Received.InOrder(() => {
+                _breakpointManager.BeginBatchBind(_target);
                 _debugEngineHandler.SendEvent(Arg.Is<EngineCreateEvent>(e => enginesAreEqual(e)),
                                               _debugProgram);
                 _debugEngineHandler.SendEvent(Arg.Any<ProgramCreateEvent>(), _debugProgram);
@@ -107,6 +108,7 @@ namespace YetiVSI.Test
         {
             _attachedProgram.ContinueFromSuspended();
             Received.InOrder(() => {
+                _breakpointManager.EndBatchBind();
                 _eventManager.StartListener();
                 _process.Continue();
                 _lldbShell.AddDebugger(_debugger);
@@ -174,6 +176,7 @@ namespace YetiVSI.Test
             };
 
             Received.InOrder(() => {
+                _breakpointManager.EndBatchBind();
                 _debugEngineHandler.SendEvent(Arg.Is<ExceptionEvent>(e => matchExceptionEvent(e)),
                                               _debugProgram, selectedThread);
                 _lldbShell.AddDebugger(_debugger);
@@ -273,6 +276,38 @@ namespace YetiVSI.Test
                 true, task, moduleFileLoadRecorder);
         }
 
+        [Test]
+        public async Task LoadSymbolsLoadsStoppedModulesFirstAsync()
+        {
+            var modules = new List<SbModule>();
+            for (int i = 0; i < 4; i++)
+            {
+                var module = Substitute.For<SbModule>();
+                module.GetId().Returns(i + 1);
+                modules.Add(module);
+            }
+
+            _target.GetNumModules().Returns(modules.Count);
+            for (int i = 0; i < modules.Count; i++)
+            {
+                _target.GetModuleAtIndex(i).Returns(modules[i]);
+            }
+
+            var thread = Substitute.For<RemoteThread>();
+            thread.GetFrameAtIndex(0).GetModule().Returns(modules[2]);
+            _process.GetNumThreads().Returns(1);
+            _process.GetThreadAtIndex(0).Returns(thread);
+
+            var task = Substitute.For<ICancelable>();
+            var moduleFileLoadRecorder = Substitute.For<IModuleFileLoadMetricsRecorder>();
+            await _attachedProgram.LoadModuleFilesAsync(null, true, task, moduleFileLoadRecorder);
+
+            var expectedOrder = new[] { modules[2], modules[0], modules[1], modules[3] };
+            await _moduleFileLoader.Received(1).LoadModuleFilesAsync(
+                Arg.Is<IList<SbModule>>(l => l.SequenceEqual(expectedOrder)), null, true, task,
+                moduleFileLoadRecorder);
+        }
+
         [Test]
         public void GetModulesByNameReturnsAllModulesWithMatchingName()
         {
@@ -660,6 +660,49 @@ namespace YetiVSI.Test.DebugEngine
                 Arg.Any<BreakEvent>(), _mockProgram, _mockRemoteThread);
         }
 
+        [Test]
+        public void HandleEventPageWatchpointHit()
+        {
+            // The SIGSEGV data must not be mistaken for a watchpoint ID.
+            MockThread(_mockRemoteThread, StopReason.SIGNAL, new List<ulong> { 11 });
+            _mockBreakpointManager.HasPageWatchpoints().Returns(true);
+            _mockSbProcess.HandlePageWatchpointStop(out int _).Returns(x => {
+                x[0] = 1;
+                return PageWatchpointStopResult.Hit;
+            });
+            MockBreakpointManagerForWatchpoint();
+
+            RaiseSingleStateChanged();
+
+            _mockDebugEngineHandler.Received(1).SendEvent(
+                Arg.Any<BreakpointEvent>(), _mockProgram, _mockRemoteThread);
+        }
+
+        [Test]
+        public void HandleEventPageWatchpointResumed()
+        {
+            MockThread(_mockRemoteThread, StopReason.SIGNAL, new List<ulong> { 11 });
+            _mockBreakpointManager.HasPageWatchpoints().Returns(true);
+            _mockSbProcess.HandlePageWatchpointStop(out int _)
+                .Returns(PageWatchpointStopResult.Resumed);
+
+            RaiseSingleStateChanged();
+
+            _mockDebugEngineHandler.DidNotReceive().SendEvent(
+                Arg.Any<IGgpDebugEvent>(), _mockProgram, Arg.Any<RemoteThread>());
+        }
+
+        [Test]
+        public void HandleEventWithoutPageWatchpoints()
+        {
+            MockThread(_mockRemoteThread, StopReason.BREAKPOINT, _breakpointStopData);
+            _mockBreakpointManager.HasPageWatchpoints().Returns(false);
+
+            RaiseSingleStateChanged();
+
+            _mockSbProcess.DidNotReceive().HandlePageWatchpointStop(out int _);
+        }
+
         [Test]
         public void HandleSignalSigstop()
         {
@@ -20,6 +20,7 @@ using System.Threading.Tasks;
 using DebuggerApi;
 using Metrics.Shared;
 using Microsoft.VisualStudio;
+using Microsoft.VisualStudio.Threading;
 using NSubstitute;
 using NUnit.Framework;
 using YetiVSI.DebugEngine;
@@ -352,6 +353,37 @@ namespace YetiVSI.Test.DebugEngine
             await AssertLoadSymbolsReceivedAsync(realModule);
         }
 
+        [Test]
+        public async Task LoadModuleFiles_LoadsBinariesConcurrentlyAsync()
+        {
+            SbModule first = CreateMockModule(isPlaceholder: true, loadSymbolsSucceeds: true);
+            SbModule second = CreateMockModule(isPlaceholder: true, loadSymbolsSucceeds: true);
+            var secondStarted = new TaskCompletionSource<bool>();
+            // The first load only finishes once the second one has started.
+            _mockBinaryLoader.LoadBinaryAsync(first, Arg.Any<TextWriter>(), Arg.Any<bool>())
+                .Returns(async x =>
+                {
+                    await secondStarted.Task.WithTimeout(TimeSpan.FromSeconds(5));
+                    return (first, true);
+                });
+            _mockBinaryLoader.LoadBinaryAsync(second, Arg.Any<TextWriter>(), Arg.Any<bool>())
+                .Returns(x =>
+                {
+                    secondStarted.SetResult(true);
+                    return Task.FromResult((second, true));
+                });
+
+            LoadModuleFilesResult result = await _moduleFileLoader.LoadModuleFilesAsync(
+                new[] { first, second }, _mockTask, _mockModuleFileLoadRecorder);
+
+            Assert.AreEqual(VSConstants.S_OK, result.ResultCode);
+            await AssertLoadSymbolsReceivedAsync(first);
+            await AssertLoadSymbolsReceivedAsync(second);
+            _mockModuleFileLoadRecorder.Received().RecordAfterLoad(
+                Arg.Is<DeveloperLogEvent.Types.LoadSymbolData>(
+                    x => x.BinariesLoadedAfterCount == 2));
+        }
+
         [Test]
         public async Task LoadModuleFiles_UnableToLoadImportantModuleForGameAttachAsync()
         {
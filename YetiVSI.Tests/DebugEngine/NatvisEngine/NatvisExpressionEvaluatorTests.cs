@@ -62,6 +62,11 @@ namespace YetiVSI.Test.DebugEngine.NatvisEngine
             _nLogSpy.Detach();
         }
 
+        static TypeLayout CreateLayout(string fieldName, bool hasVirtualBases = false) =>
+            new TypeLayout(4, hasVirtualBases, new List<string> { fieldName },
+                           new List<string> { "int" },
+                           new List<TypeLayoutField> { new TypeLayoutField { size = 4 } });
+
         [Test]
         public async Task ClassMemberAccessAsync()
         {
@@ -167,6 +172,54 @@ namespace YetiVSI.Test.DebugEngine.NatvisEngine
             Assert.That(await exprVarInfo.ValueAsync(), Is.EqualTo("5"));
         }
 
+        [Test]
+        public async Task MemberAccessWithLayoutAsync()
+        {
+            RemoteValueFake remoteValue = RemoteValueFakeUtil.CreateClass("MyType", "myType", "");
+            remoteValue.AddChild(RemoteValueFakeUtil.CreateSimpleBool("value1", true));
+            ((SbTypeStub)remoteValue.GetTypeInfo()).SetLayout(CreateLayout("value1"));
+
+            IVariableInformation varInfo = _varInfoFactory.Create(remoteValue);
+            IVariableInformation exprVarInfo = await _evaluator.EvaluateExpressionAsync(
+                "value1", varInfo, new NatvisScope(), null);
+
+            Assert.That(exprVarInfo.DisplayName, Is.EqualTo("value1"));
+            Assert.That(await exprVarInfo.ValueAsync(), Is.EqualTo("true"));
+        }
+
+        [Test]
+        public async Task NonMemberSkipsMemberAccessAsync()
+        {
+            RemoteValueFake remoteValue =
+                RemoteValueFakeUtil.CreateClass("MyType", "myType", "myValue");
+            // The layout says that test1 isn't a member, so the child isn't looked up.
+            remoteValue.AddChild(RemoteValueFakeUtil.CreateSimpleInt("test1", 22));
+            remoteValue.AddValueFromExpression("test1",
+                                               RemoteValueFakeUtil.CreateSimpleInt("dummy", 66));
+            ((SbTypeStub)remoteValue.GetTypeInfo()).SetLayout(CreateLayout("value1"));
+
+            IVariableInformation varInfo = _varInfoFactory.Create(remoteValue);
+            IVariableInformation exprVarInfo = await _evaluator.EvaluateExpressionAsync(
+                "test1", varInfo, new NatvisScope(), "result");
+
+            Assert.That(await exprVarInfo.ValueAsync(), Is.EqualTo("66"));
+        }
+
+        [Test]
+        public async Task VirtualBasesDontSkipMemberAccessAsync()
+        {
+            RemoteValueFake remoteValue = RemoteValueFakeUtil.CreateClass("MyType", "myType", "");
+            remoteValue.AddChild(RemoteValueFakeUtil.CreateSimpleInt("test1", 22));
+            ((SbTypeStub)remoteValue.GetTypeInfo())
+                .SetLayout(CreateLayout("value1", hasVirtualBases: true));
+
+            IVariableInformation varInfo = _varInfoFactory.Create(remoteValue);
+            IVariableInformation exprVarInfo = await _evaluator.EvaluateExpressionAsync(
+                "test1", varInfo, new NatvisScope(), null);
+
+            Assert.That(await exprVarInfo.ValueAsync(), Is.EqualTo("22"));
+        }
+
         [Test]
         public async Task GlobalExpressionAsync()
         {
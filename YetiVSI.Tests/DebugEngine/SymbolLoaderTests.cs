@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-using System.IO;
+using System.IO;
+using System.Linq;
+using System.Threading;
 using System.Threading.Tasks;
 using DebuggerApi;
 using NSubstitute;
@@ -31,13 +33,23 @@ namespace YetiVSI.Test.DebugEngine
             _searchLog = new StringWriter();
             _successfulCommand = Substitute.For<SbCommandReturnObject>();
             _successfulCommand.Succeeded().Returns(true);
-            _failedCommand = Substitute.For<SbCommandReturnObject>();
-            _failedCommand.Succeeded().Returns(false);
+            _noError = Substitute.For<SbError>();
+            _noError.Fail().Returns(false);
+            _addSymbolFileError = Substitute.For<SbError>();
+            _addSymbolFileError.Fail().Returns(true);
+            _addSymbolFileError.GetCString().Returns("symbol file does not match");
             _mockModuleParser = Substitute.For<IModuleParser>();
             _mockModuleFileFinder = Substitute.For<IModuleFileFinder>();
             _mockCommandInterpreter = Substitute.For<SbCommandInterpreter>();
+            _mockTarget = Substitute.For<RemoteTarget>();
+            _mockDecompressedSymbolFileCache = Substitute.For<IDecompressedSymbolFileCache>();
+            _mockDecompressedSymbolFileCache
+                .GetDecompressedFile(Arg.Any<string>(), Arg.Any<BuildId>(),
+                                     Arg.Any<TextWriter>())
+                .Returns(x => x[0]);
             _symbolLoader = new SymbolLoader(
-                _mockModuleParser, _mockModuleFileFinder, _mockCommandInterpreter);
+                _mockModuleParser, _mockModuleFileFinder, _mockDecompressedSymbolFileCache,
+                _mockCommandInterpreter, _mockTarget);
         }
 
         [Test]
@@ -52,6 +64,71 @@ namespace YetiVSI.Test.DebugEngine
             StringAssert.AreEqualIgnoringCase(ErrorStrings.SymbolFileNameUnknown, output);
         }
 
+        [Test]
+        public async Task LoadSymbols_ElfSymbolFile_LoadsDecompressedCopyAsync()
+        {
+            var module = Substitute.For<SbModule>();
+            module.GetPlatformFileSpec().GetFilename().Returns(_elfFile);
+            module.GetSymbolFileSpec().GetFilename().Returns(_elfFile);
+            module.GetSymbolFileSpec().GetDirectory().Returns(_localDir);
+            module.GetTriple().Returns(_linux);
+
+            string symbolPath = $"{_localDir}\\{_elfFile}";
+            string decompressedPath = $"{_cacheDir}\\decompressed_{_elfFile}";
+            SetParseBuildId(symbolPath, ModuleFormat.Elf, "");
+            _mockDecompressedSymbolFileCache
+                .GetDecompressedFile(symbolPath, Arg.Any<BuildId>(), _searchLog)
+                .Returns(decompressedPath);
+            SetAddSymbolFile($"decompressed_{_elfFile}", _noError);
+
+            bool result = await _symbolLoader.LoadSymbolsAsync(
+                module, _searchLog, _forceLoad);
+            Assert.IsTrue(result);
+            StringAssert.Contains(decompressedPath, _searchLog.ToString());
+        }
+
+        [Test]
+        public async Task LoadSymbols_ConcurrentLoads_AddSymbolFilesInParallelAsync()
+        {
+            var modules = new[] { Substitute.For<SbModule>(), Substitute.For<SbModule>() };
+            for (int i = 0; i < modules.Length; i++)
+            {
+                string filename = $"test{i}.so";
+                modules[i].GetPlatformFileSpec().GetFilename().Returns(filename);
+                modules[i].GetSymbolFileSpec().GetFilename().Returns(filename);
+                modules[i].GetSymbolFileSpec().GetDirectory().Returns(_localDir);
+                modules[i].GetTriple().Returns(_linux);
+                SetParseBuildId($"{_localDir}\\{filename}", ModuleFormat.Elf, "");
+            }
+
+            int running = 0;
+            int maxRunning = 0;
+            _mockTarget.AddSymbolFile(Arg.Any<SbModule>(), Arg.Any<string>()).Returns(x =>
+            {
+                int count = Interlocked.Increment(ref running);
+                InterlockedMax(ref maxRunning, count);
+                SpinWait.SpinUntil(() => Volatile.Read(ref running) == modules.Length, 5000);
+                Interlocked.Decrement(ref running);
+                return _noError;
+            });
+
+            bool[] results = await Task.WhenAll(modules.Select(
+                module => Task.Run(() => _symbolLoader.LoadSymbolsAsync(
+                                       module, new StringWriter(), _forceLoad))));
+
+            Assert.That(results, Is.All.True);
+            Assert.That(maxRunning, Is.EqualTo(modules.Length));
+
+            void InterlockedMax(ref int target, int value)
+            {
+                int current;
+                while ((current = target) < value &&
+                       Interlocked.CompareExchange(ref target, value, current) != current)
+                {
+                }
+            }
+        }
+
         [TestCase(_elfFile, _linux, ModuleFormat.Elf)]
         [TestCase(_peFile, _windows, ModuleFormat.Pe)]
         [TestCase(_pdbFile, _windows, ModuleFormat.Pdb)]
@@ -68,7 +145,7 @@ namespace YetiVSI.Test.DebugEngine
             module.GetTriple().Returns(triple);
 
             SetParseBuildId($"{_localDir}\\{filename}", expectedFormat, "");
-            SetHandleCommand(filename, _successfulCommand);
+            SetAddSymbolFile(filename, _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -94,7 +171,7 @@ namespace YetiVSI.Test.DebugEngine
             module.GetTriple().Returns(triple);
 
             SetParseBuildId($"{_localDir}\\{filename}", expectedFormat, _validBuildId);
-            SetHandleCommand(filename, _successfulCommand);
+            SetAddSymbolFile(filename, _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -169,7 +246,7 @@ namespace YetiVSI.Test.DebugEngine
                 });
 
             SetParseBuildId($"{_cacheDir}\\{_parsedSymbolName}", ModuleFormat.Elf, "");
-            SetHandleCommand(_parsedSymbolName, _successfulCommand);
+            SetAddSymbolFile(_parsedSymbolName, _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -274,7 +351,7 @@ namespace YetiVSI.Test.DebugEngine
             // PE -> PDB if symbol file from GetSymbolFileSpec is invalid
             // (changes file extension and ModuleFormat).
             SetParseBuildId($"{_localDir}\\{_pdbFile}", ModuleFormat.Pdb, "");
-            SetHandleCommand(_pdbFile, _successfulCommand);
+            SetAddSymbolFile(_pdbFile, _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -316,7 +393,7 @@ namespace YetiVSI.Test.DebugEngine
             module.GetTriple().Returns(triple);
 
             SetFindFile(filename, $"{_cacheDir}\\{filename}");
-            SetHandleCommand(filename, _successfulCommand);
+            SetAddSymbolFile(filename, _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -339,7 +416,7 @@ namespace YetiVSI.Test.DebugEngine
             module.GetTriple().Returns(triple);
 
             SetFindFile(filename, $"{_cacheDir}\\{filename}");
-            SetHandleCommand(filename, _failedCommand);
+            SetAddSymbolFile(filename, _addSymbolFileError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -359,7 +436,7 @@ namespace YetiVSI.Test.DebugEngine
             SetFindFile(_symbolName, null);
             var expectedOutput = $"{_cacheDir}\\{_binaryName}.debug";
             SetFindFile($"{_binaryName}.debug", expectedOutput);
-            SetHandleCommand($"{_binaryName}.debug", _successfulCommand);
+            SetAddSymbolFile($"{_binaryName}.debug", _noError);
 
             bool result = await _symbolLoader.LoadSymbolsAsync(
                 module, _searchLog, _forceLoad);
@@ -369,6 +446,62 @@ namespace YetiVSI.Test.DebugEngine
             Assert.That(output.Contains($"Successfully loaded symbol file '{expectedOutput}'"));
         }
 
+        [Test]
+        public async Task LoadSymbols_SplitDwarfSymbolFile_AddsDwarfPackageDirectoryAsync()
+        {
+            var module = Substitute.For<SbModule>();
+            module.GetSymbolFileSpec().GetFilename().Returns(_symbolName);
+            module.GetFileSpec().GetFilename().Returns(_binaryName);
+            module.GetUUIDString().Returns(_validBuildId);
+
+            string symbolPath = $"{_cacheDir}\\{_symbolName}";
+            string packagePath = $"{_localDir}\\{_binaryName}.dwp";
+            SetFindFile(_symbolName, symbolPath);
+            _mockModuleParser.HasSplitDwarf(symbolPath).Returns(true);
+            _mockModuleFileFinder.FindFileAsync(
+                Arg.Is<ModuleSearchQuery>(x => x != null &&
+                                          x.Filename == $"{_binaryName}.dwp" &&
+                                          x.SkipBuildIdVerification),
+                Arg.Any<StringWriter>()).Returns(packagePath);
+            SetAddSymbolFile(_symbolName, _noError);
+            SetHandleCommand("target.debug-file-search-paths", _successfulCommand);
+
+            bool result = await _symbolLoader.LoadSymbolsAsync(
+                module, _searchLog, _forceLoad);
+
+            Assert.IsTrue(result);
+            Received.InOrder(() =>
+            {
+                _mockCommandInterpreter.HandleCommand(
+                    Arg.Is<string>(x => x.StartsWith(
+                                       "settings append target.debug-file-search-paths") &&
+                                   x.Contains(_localDir)), out _);
+                _mockTarget.AddSymbolFile(module, Arg.Is<string>(x => x.Contains(_symbolName)));
+            });
+            StringAssert.Contains($"Using DWARF package '{packagePath}'", _searchLog.ToString());
+        }
+
+        [Test]
+        public async Task LoadSymbols_SymbolFileWithoutSplitDwarf_DoesNotSearchPackageAsync()
+        {
+            var module = Substitute.For<SbModule>();
+            module.GetSymbolFileSpec().GetFilename().Returns(_symbolName);
+            module.GetFileSpec().GetFilename().Returns(_binaryName);
+            module.GetUUIDString().Returns(_validBuildId);
+
+            string symbolPath = $"{_cacheDir}\\{_symbolName}";
+            SetFindFile(_symbolName, symbolPath);
+            SetAddSymbolFile(_symbolName, _noError);
+
+            bool result = await _symbolLoader.LoadSymbolsAsync(
+                module, _searchLog, _forceLoad);
+
+            Assert.IsTrue(result);
+            await _mockModuleFileFinder.DidNotReceive().FindFileAsync(
+                Arg.Is<ModuleSearchQuery>(x => x.Filename.EndsWith(".dwp")),
+                Arg.Any<TextWriter>());
+        }
+
         void SetParseBuildId(string path, ModuleFormat format, string buildId, string error = null)
         {
             var buildIdInfo = new BuildIdInfo() { Data = new BuildId(buildId) };
@@ -388,6 +521,12 @@ namespace YetiVSI.Test.DebugEngine
                 Arg.Any<StringWriter>()).Returns(foundPath);
         }
 
+        void SetAddSymbolFile(string file, SbError toReturn)
+        {
+            _mockTarget.AddSymbolFile(Arg.Any<SbModule>(), Arg.Is<string>(x => x.Contains(file)))
+                .Returns(toReturn);
+        }
+
         void SetHandleCommand(string file, SbCommandReturnObject toReturn)
         {
             _mockCommandInterpreter.HandleCommand(Arg.Is<string>(x => x.Contains(file)), out _)
@@ -414,9 +553,12 @@ namespace YetiVSI.Test.DebugEngine
         StringWriter _searchLog;
         IModuleParser _mockModuleParser;
         IModuleFileFinder _mockModuleFileFinder;
+        IDecompressedSymbolFileCache _mockDecompressedSymbolFileCache;
         SbCommandInterpreter _mockCommandInterpreter;
+        RemoteTarget _mockTarget;
+        SbError _noError;
+        SbError _addSymbolFileError;
         SbCommandReturnObject _successfulCommand;
-        SbCommandReturnObject _failedCommand;
 
         // The value of _forceLoad doesn't affect the SymbolLoader logic.
         // It is used to notify the symbolStores whether they should use cache.
@@ -50,6 +50,8 @@ namespace YetiVSI.Test
                   nameof(IExtensionOptions.FastExpressionEvaluation))]
         [TestCase(nameof(OptionPageGrid.ExpressionEvaluationEngine),
                   nameof(IExtensionOptions.ExpressionEvaluationStrategy))]
+        [TestCase(nameof(OptionPageGrid.TunnelCompression),
+                  nameof(IExtensionOptions.TunnelCompression))]
         public void EnumOption(string optionName, string derivedName)
         {
             // Tests the validity of all enum options.
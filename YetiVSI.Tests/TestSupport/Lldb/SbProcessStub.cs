@@ -14,6 +14,7 @@
 
 ﻿using DebuggerApi;
 using System;
+using System.Collections.Generic;
 using TestsCommon.TestSupport;
 
 namespace YetiVSI.Test.TestSupport.Lldb
@@ -129,7 +130,18 @@ namespace YetiVSI.Test.TestSupport.Lldb
             throw new NotImplementedTestDoubleException();
         }
 
-        public void SaveCore(string dumpPath, out SbError error)
+        public List<SbError> WriteMemory(IList<MemoryWrite> writes)
+        {
+            throw new NotImplementedTestDoubleException();
+        }
+
+        public void SaveCore(string dumpPath, SaveCoreStyle style,
+                             IEnumerable<AddressRange> customRanges, out SbError error)
+        {
+            throw new NotImplementedTestDoubleException();
+        }
+
+        public PageWatchpointStopResult HandlePageWatchpointStop(out int watchpointId)
         {
             throw new NotImplementedTestDoubleException();
         }
@@ -65,10 +65,17 @@ namespace YetiVSI.Test.TestSupport.Lldb
 
         public int GetNumModules() => 0;
 
+        public List<ModuleSnapshot> GetModuleSnapshot() => new List<ModuleSnapshot>();
+
         public SbProcess LoadCore(string coreFile) => new SbProcessStub(this, coreFile);
 
-        public EventType AddListener(SbListener listener,
-                                     TargetEventType eventMask) => (EventType)eventMask;
+        public TargetEventType ListenerEventMask { get; private set; }
+
+        public EventType AddListener(SbListener listener, TargetEventType eventMask)
+        {
+            ListenerEventMask |= eventMask;
+            return (EventType)eventMask;
+        }
 
 #region Not Implemented
         public SbModule AddModule(string path, string triple, string uuid)
@@ -86,6 +93,11 @@ namespace YetiVSI.Test.TestSupport.Lldb
             throw new NotImplementedTestDoubleException();
         }
 
+        public List<FunctionMatch> FindFunctionsMatching(string pattern, uint maxMatches)
+        {
+            throw new NotImplementedTestDoubleException();
+        }
+
         public RemoteBreakpoint BreakpointCreateByAddress(ulong address)
         {
             throw new NotImplementedTestDoubleException();
@@ -131,6 +143,11 @@ namespace YetiVSI.Test.TestSupport.Lldb
             throw new NotImplementedTestDoubleException();
         }
 
+        public SbError AddSymbolFile(SbModule module, string symbolFilePath)
+        {
+            throw new NotImplementedTestDoubleException();
+        }
+
         public SbWatchpoint WatchAddress(long address, ulong size, bool read, bool write,
             out SbError error)
         {
@@ -143,6 +160,11 @@ namespace YetiVSI.Test.TestSupport.Lldb
             throw new NotImplementedTestDoubleException();
         }
 
+        public List<LineEntryInfo> ResolveLineEntries(List<ulong> loadAddresses)
+        {
+            throw new NotImplementedTestDoubleException();
+        }
+
         public Task<Tuple<SbType, SbError>> CompileExpressionAsync(
             SbType scope, string expression, IDictionary<string, SbType> contextArgs)
         {
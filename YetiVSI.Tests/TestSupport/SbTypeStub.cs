@@ -27,6 +27,7 @@ namespace YetiVSI.Test.TestSupport
         SbType canonicalType;
         SbType pointeeType;
         ulong? byteSize = null;
+        TypeLayout layout;
 
         public SbTypeStub(string name, TypeFlags typeFlags, SbType pointeeType = null)
         {
@@ -95,6 +96,13 @@ namespace YetiVSI.Test.TestSupport
 
         public void SetCanonicalType(SbType t) => canonicalType = t;
 
+        public TypeLayout GetLayout() => layout;
+
+        public void SetLayout(TypeLayout layout)
+        {
+            this.layout = layout;
+        }
+
         public long GetId() => 0;
 
         public void SetByteSize(ulong byteSize)